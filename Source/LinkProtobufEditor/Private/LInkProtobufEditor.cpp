@@ -7,6 +7,7 @@
 #include "LinkProtobufEditorFunctionLibrary.h"
 #include "LinkProtobufEditorSettings.h"
 #include "LinkProtobufEditorSettingsCustomization.h"
+#include "LinkProtobufRuntimeSettings.h"
 
 DEFINE_LOG_CATEGORY(LogProtoEditor);
 #define LOCTEXT_NAMESPACE "FLinkProtobufEditorModule"
@@ -20,6 +21,10 @@ void FLinkProtobufEditorModule::StartupModule()
 			LOCTEXT("RuntimeSettingsName", "LinkProtobuf"),
 			LOCTEXT("RuntimeSettingsDescription", "Configure LinkProtobuf Plugin"),
 			GetMutableDefault<ULinkProtobufEditorSettings>());
+		SettingsModule->RegisterSettings("Project", "Plugins", "LinkProtobufRuntime",
+			LOCTEXT("RuntimeOptionsName", "LinkProtobuf Runtime"),
+			LOCTEXT("RuntimeOptionsDescription", "Configure LinkProtobuf conversions at runtime"),
+			GetMutableDefault<ULinkProtobufRuntimeSettings>());
 	}
 	FPropertyEditorModule& PropertyModule = FModuleManager::LoadModuleChecked<FPropertyEditorModule>("PropertyEditor");
 
@@ -34,6 +39,7 @@ void FLinkProtobufEditorModule::ShutdownModule()
 	if (ISettingsModule* SettingsModule = FModuleManager::GetModulePtr<ISettingsModule>("Settings"))
 	{
 		SettingsModule->UnregisterSettings("Project", "Plugins", "LinkProtobuf");
+		SettingsModule->UnregisterSettings("Project", "Plugins", "LinkProtobufRuntime");
 	}
 	if (FModuleManager::Get().IsModuleLoaded("PropertyEditor"))
 	{
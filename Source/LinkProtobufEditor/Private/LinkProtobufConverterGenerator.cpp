@@ -0,0 +1,374 @@
+// Copyright DarkestLink-Dev 2025 All Rights Reserved.
+
+#include "LinkProtobufConverterGenerator.h"
+#include "LinkProtobufEditor.h"
+#include "LinkProtobufEditorFunctionLibrary.h"
+#include "LinkProtobufFunctionLibrary.h"
+#include "LinkProtobufUtf8.h"
+#include "Engine/UserDefinedStruct.h"
+#include "UObject/TextProperty.h"
+#if LINKPROTO_WITH_UTF8_STRING_PROPERTIES
+#include "UObject/AnsiStrProperty.h"
+#include "UObject/Utf8StrProperty.h"
+#endif
+
+namespace
+{
+	// How a property (or an array element) is copied by the generated code
+	enum class EGeneratedLeaf : uint8
+	{
+		// Not part of the .proto, skipped like the schema generator does
+		Skipped,
+		Unsupported,
+		Number,
+		Bytes,
+		String,
+		Struct
+	};
+
+	// Core structs included by CoreMinimal whose reflected members match the real, public members
+	const TCHAR* const CoreStructNames[] =
+	{
+		TEXT("Vector"), TEXT("Vector2D"), TEXT("Vector4"), TEXT("Rotator"), TEXT("Quat"),
+		TEXT("IntPoint"), TEXT("IntVector"), TEXT("LinearColor"), TEXT("Color"), TEXT("Guid")
+	};
+
+	// Identifiers protoc appends an underscore to, see cpp_helpers.cc
+	const TCHAR* const CppKeywords[] =
+	{
+		TEXT("alignas"), TEXT("alignof"), TEXT("and"), TEXT("and_eq"), TEXT("asm"), TEXT("auto"), TEXT("bitand"), TEXT("bitor"),
+		TEXT("bool"), TEXT("break"), TEXT("case"), TEXT("catch"), TEXT("char"), TEXT("class"), TEXT("compl"), TEXT("const"),
+		TEXT("constexpr"), TEXT("const_cast"), TEXT("continue"), TEXT("decltype"), TEXT("default"), TEXT("delete"), TEXT("do"),
+		TEXT("double"), TEXT("dynamic_cast"), TEXT("else"), TEXT("enum"), TEXT("explicit"), TEXT("export"), TEXT("extern"),
+		TEXT("false"), TEXT("float"), TEXT("for"), TEXT("friend"), TEXT("goto"), TEXT("if"), TEXT("inline"), TEXT("int"),
+		TEXT("long"), TEXT("mutable"), TEXT("namespace"), TEXT("new"), TEXT("noexcept"), TEXT("not"), TEXT("not_eq"),
+		TEXT("nullptr"), TEXT("operator"), TEXT("or"), TEXT("or_eq"), TEXT("private"), TEXT("protected"), TEXT("public"),
+		TEXT("register"), TEXT("reinterpret_cast"), TEXT("return"), TEXT("short"), TEXT("signed"), TEXT("sizeof"), TEXT("static"),
+		TEXT("static_assert"), TEXT("static_cast"), TEXT("struct"), TEXT("switch"), TEXT("template"), TEXT("this"),
+		TEXT("thread_local"), TEXT("throw"), TEXT("true"), TEXT("try"), TEXT("typedef"), TEXT("typeid"), TEXT("typename"),
+		TEXT("union"), TEXT("unsigned"), TEXT("using"), TEXT("virtual"), TEXT("void"), TEXT("volatile"), TEXT("wchar_t"),
+		TEXT("while"), TEXT("xor"), TEXT("xor_eq"), TEXT("char8_t"), TEXT("char16_t"), TEXT("char32_t"), TEXT("concept"),
+		TEXT("consteval"), TEXT("constinit"), TEXT("co_await"), TEXT("co_return"), TEXT("co_yield"), TEXT("requires")
+	};
+
+	struct FGeneratorContext
+	{
+		// Struct -> eligible, filled depth first. Structs being checked are optimistically eligible so recursion ends.
+		TMap<const UScriptStruct*, bool> Eligible;
+		// Every struct reachable from the targets, in discovery order
+		TArray<const UScriptStruct*> Reachable;
+	};
+}
+
+static bool IsCoreUObjectStruct(const UScriptStruct* Struct)
+{
+	return Struct->GetOutermost()->GetName() == TEXT("/Script/CoreUObject");
+}
+
+static bool IsCoreStruct(const UScriptStruct* Struct)
+{
+	if (!IsCoreUObjectStruct(Struct))
+	{
+		return false;
+	}
+	const FString Name = Struct->GetName();
+	for (const TCHAR* CoreName : CoreStructNames)
+	{
+		if (Name == CoreName)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+// Header to include for the struct, empty for every CoreUObject struct. The ones outside CoreStructNames are
+// NoExportTypes.h mirrors whose reflected members are protected or private in the real type.
+static FString GetStructInclude(const UScriptStruct* Struct)
+{
+	if (IsCoreUObjectStruct(Struct))
+	{
+		return FString();
+	}
+	FString Path = Struct->GetMetaData(TEXT("ModuleRelativePath"));
+	for (const TCHAR* Root : { TEXT("Public/"), TEXT("Classes/"), TEXT("Private/") })
+	{
+		if (Path.RemoveFromStart(Root))
+		{
+			break;
+		}
+	}
+	return Path;
+}
+
+// Accessor name protoc generates for the field
+static FString GetAccessorName(const FProperty* Property)
+{
+	FString Name = ULinkProtobufEditorFunctionLibrary::GetProtoFieldName(Property).ToLower();
+	for (const TCHAR* Keyword : CppKeywords)
+	{
+		if (Name == Keyword)
+		{
+			Name.AppendChar(TEXT('_'));
+			break;
+		}
+	}
+	return Name;
+}
+
+static bool IsStructEligible(const UScriptStruct* Struct, FGeneratorContext& Context);
+
+static EGeneratedLeaf ClassifyLeaf(const FProperty* Property, FGeneratorContext& Context)
+{
+	if (Property->IsA<FEnumProperty>() || Property->IsA<FArrayProperty>() || Property->IsA<FSetProperty>() || Property->IsA<FMapProperty>())
+	{
+		return EGeneratedLeaf::Unsupported;
+	}
+	if (const FStructProperty* StructProp = CastField<FStructProperty>(Property))
+	{
+		return IsStructEligible(StructProp->Struct, Context) ? EGeneratedLeaf::Struct : EGeneratedLeaf::Unsupported;
+	}
+	if (const FByteProperty* ByteProp = CastField<FByteProperty>(Property))
+	{
+		// TEnumAsByte has no plain uint8 member
+		return ByteProp->Enum ? EGeneratedLeaf::Unsupported : EGeneratedLeaf::Bytes;
+	}
+	if (Property->IsA<FStrProperty>() || Property->IsA<FNameProperty>() || Property->IsA<FTextProperty>())
+	{
+		return EGeneratedLeaf::String;
+	}
+#if LINKPROTO_WITH_UTF8_STRING_PROPERTIES
+	if (Property->IsA<FUtf8StrProperty>() || Property->IsA<FAnsiStrProperty>())
+	{
+		return EGeneratedLeaf::String;
+	}
+#endif
+	return ULinkProtobufFunctionLibrary::ProtoStringAssignProp(Property) == TEXT("unknown") ? EGeneratedLeaf::Skipped : EGeneratedLeaf::Number;
+}
+
+static bool IsStructEligible(const UScriptStruct* Struct, FGeneratorContext& Context)
+{
+	if (const bool* Found = Context.Eligible.Find(Struct))
+	{
+		return *Found;
+	}
+	Context.Eligible.Add(Struct, true);
+	Context.Reachable.Add(Struct);
+
+	bool bEligible = (Struct->StructFlags & STRUCT_Native) != 0 && !Struct->IsA<UUserDefinedStruct>()
+		&& (IsCoreStruct(Struct) || !GetStructInclude(Struct).IsEmpty());
+	for (TFieldIterator<FProperty> It(Struct); It; ++It)
+	{
+		const FProperty* Property = *It;
+		EGeneratedLeaf Leaf;
+		if (ULinkProtobufFunctionLibrary::IsByteArrayProperty(Property))
+		{
+			// A single string (ProtoUtf8) or bytes field holding the whole array
+			Leaf = ULinkProtobufEditorFunctionLibrary::IsUtf8ByteArray(Property) ? EGeneratedLeaf::String : EGeneratedLeaf::Bytes;
+		}
+		else if (const FArrayProperty* ArrayProp = CastField<FArrayProperty>(Property))
+		{
+			Leaf = ClassifyLeaf(ArrayProp->Inner, Context);
+			if (Leaf == EGeneratedLeaf::Skipped)
+			{
+				Leaf = EGeneratedLeaf::Unsupported;
+			}
+		}
+		else if (const FSetProperty* SetProp = CastField<FSetProperty>(Property))
+		{
+			// Still walked so element structs get their own converter
+			ClassifyLeaf(SetProp->ElementProp, Context);
+			Leaf = EGeneratedLeaf::Unsupported;
+		}
+		else if (const FMapProperty* MapProp = CastField<FMapProperty>(Property))
+		{
+			ClassifyLeaf(MapProp->KeyProp, Context);
+			ClassifyLeaf(MapProp->ValueProp, Context);
+			Leaf = EGeneratedLeaf::Unsupported;
+		}
+		else
+		{
+			Leaf = ClassifyLeaf(Property, Context);
+		}
+
+		if (Leaf == EGeneratedLeaf::Skipped)
+		{
+			continue;
+		}
+		if (Leaf == EGeneratedLeaf::Unsupported || Property->ArrayDim != 1
+			|| Property->HasAnyPropertyFlags(CPF_NativeAccessSpecifierProtected | CPF_NativeAccessSpecifierPrivate))
+		{
+			bEligible = false;
+		}
+	}
+
+	Context.Eligible[Struct] = bEligible;
+	return bEligible;
+}
+
+static FString ToMessageName(const UScriptStruct* Struct)
+{
+	return FString::Printf(TEXT("ToMessage_%s"), *Struct->GetName());
+}
+
+static FString FromMessageName(const UScriptStruct* Struct)
+{
+	return FString::Printf(TEXT("FromMessage_%s"), *Struct->GetName());
+}
+
+static void GenerateFieldCode(const FProperty* Property, FString& ToBody, FString& FromBody, FGeneratorContext& Context)
+{
+	const FString Member = Property->GetName();
+	const FString Accessor = GetAccessorName(Property);
+
+	if (ULinkProtobufEditorFunctionLibrary::IsUtf8ByteArray(Property))
+	{
+		ToBody.Append(FString::Printf(TEXT("\t\tMsg.set_%s(LinkProtoGenerated::ToUtf8(Struct.%s));\n"), *Accessor, *Member));
+		FromBody.Append(FString::Printf(TEXT("\t\tLinkProtoGenerated::FromUtf8(Msg.%s(), Struct.%s);\n"), *Accessor, *Member));
+		return;
+	}
+	if (ULinkProtobufFunctionLibrary::IsByteArrayProperty(Property))
+	{
+		ToBody.Append(FString::Printf(TEXT("\t\tLinkProtoGenerated::ToBytes(Struct.%s, *Msg.mutable_%s());\n"), *Member, *Accessor));
+		FromBody.Append(FString::Printf(TEXT("\t\tLinkProtoGenerated::FromBytes(Msg.%s(), Struct.%s);\n"), *Accessor, *Member));
+		return;
+	}
+	if (const FArrayProperty* ArrayProp = CastField<FArrayProperty>(Property))
+	{
+		// Elements are appended like the reflection converter does, so both paths give the same result
+		const EGeneratedLeaf Leaf = ClassifyLeaf(ArrayProp->Inner, Context);
+		if (Leaf == EGeneratedLeaf::Struct)
+		{
+			const UScriptStruct* Inner = CastFieldChecked<FStructProperty>(ArrayProp->Inner)->Struct;
+			ToBody.Append(FString::Printf(TEXT("\t\tMsg.mutable_%s()->Reserve(Struct.%s.Num());\n"), *Accessor, *Member));
+			ToBody.Append(FString::Printf(TEXT("\t\tfor (const auto& Value : Struct.%s) { %s(Value, *Msg.add_%s()); }\n"), *Member, *ToMessageName(Inner), *Accessor));
+			FromBody.Append(FString::Printf(TEXT("\t\tfor (const auto& Value : Msg.%s()) { %s(Value, Struct.%s.AddDefaulted_GetRef()); }\n"), *Accessor, *FromMessageName(Inner), *Member));
+		}
+		else if (Leaf == EGeneratedLeaf::String)
+		{
+			ToBody.Append(FString::Printf(TEXT("\t\tMsg.mutable_%s()->Reserve(Struct.%s.Num());\n"), *Accessor, *Member));
+			ToBody.Append(FString::Printf(TEXT("\t\tfor (const auto& Value : Struct.%s) { Msg.add_%s(LinkProtoGenerated::ToUtf8(Value)); }\n"), *Member, *Accessor));
+			FromBody.Append(FString::Printf(TEXT("\t\tfor (const auto& Value : Msg.%s()) { LinkProtoGenerated::FromUtf8(Value, Struct.%s.AddDefaulted_GetRef()); }\n"), *Accessor, *Member));
+		}
+		else
+		{
+			ToBody.Append(FString::Printf(TEXT("\t\tMsg.mutable_%s()->Reserve(Struct.%s.Num());\n"), *Accessor, *Member));
+			ToBody.Append(FString::Printf(TEXT("\t\tfor (const auto& Value : Struct.%s) { Msg.add_%s(Value); }\n"), *Member, *Accessor));
+			FromBody.Append(FString::Printf(TEXT("\t\tStruct.%s.Reserve(Struct.%s.Num() + Msg.%s_size());\n"), *Member, *Member, *Accessor));
+			FromBody.Append(FString::Printf(TEXT("\t\tfor (const auto& Value : Msg.%s()) { Struct.%s.Add(Value); }\n"), *Accessor, *Member));
+		}
+		return;
+	}
+
+	switch (ClassifyLeaf(Property, Context))
+	{
+	case EGeneratedLeaf::Struct:
+	{
+		const UScriptStruct* Inner = CastFieldChecked<FStructProperty>(Property)->Struct;
+		ToBody.Append(FString::Printf(TEXT("\t\t%s(Struct.%s, *Msg.mutable_%s());\n"), *ToMessageName(Inner), *Member, *Accessor));
+		FromBody.Append(FString::Printf(TEXT("\t\t%s(Msg.%s(), Struct.%s);\n"), *FromMessageName(Inner), *Accessor, *Member));
+		break;
+	}
+	case EGeneratedLeaf::String:
+		ToBody.Append(FString::Printf(TEXT("\t\tMsg.set_%s(LinkProtoGenerated::ToUtf8(Struct.%s));\n"), *Accessor, *Member));
+		FromBody.Append(FString::Printf(TEXT("\t\tLinkProtoGenerated::FromUtf8(Msg.%s(), Struct.%s);\n"), *Accessor, *Member));
+		break;
+	case EGeneratedLeaf::Bytes:
+		ToBody.Append(FString::Printf(TEXT("\t\tMsg.set_%s(std::string(1, static_cast<char>(Struct.%s)));\n"), *Accessor, *Member));
+		FromBody.Append(FString::Printf(TEXT("\t\tStruct.%s = Msg.%s().empty() ? 0 : static_cast<uint8>(Msg.%s()[0]);\n"), *Member, *Accessor, *Accessor));
+		break;
+	case EGeneratedLeaf::Number:
+		ToBody.Append(FString::Printf(TEXT("\t\tMsg.set_%s(Struct.%s);\n"), *Accessor, *Member));
+		FromBody.Append(FString::Printf(TEXT("\t\tStruct.%s = Msg.%s();\n"), *Member, *Accessor));
+		break;
+	default:
+		break;
+	}
+}
+
+int32 FLinkProtoConverterGenerator::Generate(const TArray<UScriptStruct*>& TargetStructs, const FString& ProtoFileName, FString& OutContent)
+{
+	FGeneratorContext Context;
+	for (const UScriptStruct* Struct : TargetStructs)
+	{
+		if (Struct)
+		{
+			IsStructEligible(Struct, Context);
+		}
+	}
+
+	TArray<const UScriptStruct*> Structs;
+	TArray<FString> Includes;
+	for (const UScriptStruct* Struct : Context.Reachable)
+	{
+		if (!Context.Eligible[Struct])
+		{
+			UE_LOG(LogProtoEditor, Log, TEXT("Struct %s keeps the reflection converter"), *Struct->GetName());
+			continue;
+		}
+		Structs.Add(Struct);
+		const FString Include = GetStructInclude(Struct);
+		if (!Include.IsEmpty())
+		{
+			Includes.AddUnique(Include);
+		}
+	}
+	if (Structs.Num() == 0)
+	{
+		return 0;
+	}
+
+	FString Namespace = TEXT("LinkProtoGenerated_");
+	for (const TCHAR Char : ProtoFileName)
+	{
+		Namespace.AppendChar(FChar::IsAlnum(Char) ? Char : TEXT('_'));
+	}
+
+	OutContent.Append(FString::Printf(TEXT("// Generated by LinkProtobufEditor from %s.proto, do not edit.\n"), *ProtoFileName));
+	OutContent.Append(TEXT("// Typed converters between the native structs and the protoc message classes, see FLinkProtoGeneratedRegistry.\n\n"));
+	OutContent.Append(TEXT("#include \"CoreMinimal.h\"\n#include \"LinkProtobufGeneratedRegistry.h\"\n"));
+	for (const FString& Include : Includes)
+	{
+		OutContent.Append(FString::Printf(TEXT("#include \"%s\"\n"), *Include));
+	}
+	OutContent.Append(FString::Printf(TEXT("\nTHIRD_PARTY_INCLUDES_START\n#include \"%s.pb.h\"\nTHIRD_PARTY_INCLUDES_END\n\n"), *ProtoFileName));
+	OutContent.Append(FString::Printf(TEXT("namespace %s\n{\n"), *Namespace));
+
+	// Declarations first, nested structs may come in any order
+	for (const UScriptStruct* Struct : Structs)
+	{
+		const FString CppName = Struct->GetStructCPPName();
+		OutContent.Append(FString::Printf(TEXT("\tstatic void %s(const %s& Struct, %s& Msg);\n"), *ToMessageName(Struct), *CppName, *Struct->GetName()));
+		OutContent.Append(FString::Printf(TEXT("\tstatic void %s(const %s& Msg, %s& Struct);\n"), *FromMessageName(Struct), *Struct->GetName(), *CppName));
+	}
+
+	for (const UScriptStruct* Struct : Structs)
+	{
+		const FString CppName = Struct->GetStructCPPName();
+		FString ToBody;
+		FString FromBody;
+		for (TFieldIterator<FProperty> It(Struct); It; ++It)
+		{
+			GenerateFieldCode(*It, ToBody, FromBody, Context);
+		}
+		OutContent.Append(FString::Printf(TEXT("\n\tstatic void %s(const %s& Struct, %s& Msg)\n\t{\n%s\t}\n"), *ToMessageName(Struct), *CppName, *Struct->GetName(), *ToBody));
+		OutContent.Append(FString::Printf(TEXT("\n\tstatic void %s(const %s& Msg, %s& Struct)\n\t{\n%s\t}\n"), *FromMessageName(Struct), *Struct->GetName(), *CppName, *FromBody));
+	}
+
+	OutContent.Append(TEXT("\n"));
+	for (const UScriptStruct* Struct : Structs)
+	{
+		const FString CppName = Struct->GetStructCPPName();
+		const FString GetStruct = IsCoreStruct(Struct)
+			? FString::Printf(TEXT("TBaseStructure<%s>::Get()"), *CppName)
+			: FString::Printf(TEXT("%s::StaticStruct()"), *CppName);
+		OutContent.Append(FString::Printf(TEXT("\tstatic const FLinkProtoGeneratedRegistrar Registrar_%s(\n"), *Struct->GetName()));
+		OutContent.Append(FString::Printf(TEXT("\t\t[]() { return %s; },\n"), *GetStruct));
+		OutContent.Append(FString::Printf(TEXT("\t\t[](const void* StructPtr, google::protobuf::Message& Msg) { %s(*static_cast<const %s*>(StructPtr), static_cast<%s&>(Msg)); },\n"), *ToMessageName(Struct), *CppName, *Struct->GetName()));
+		OutContent.Append(FString::Printf(TEXT("\t\t[](const google::protobuf::Message& Msg, void* StructPtr) { %s(static_cast<const %s&>(Msg), *static_cast<%s*>(StructPtr)); });\n"), *FromMessageName(Struct), *Struct->GetName(), *CppName));
+	}
+	OutContent.Append(TEXT("}\n"));
+
+	UE_LOG(LogProtoEditor, Log, TEXT("Generated typed converters for %d of %d structs"), Structs.Num(), Context.Reachable.Num());
+	return Structs.Num();
+}
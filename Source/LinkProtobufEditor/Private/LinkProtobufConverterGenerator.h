@@ -0,0 +1,20 @@
+// Copyright DarkestLink-Dev 2025 All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Writes the C++ source of typed struct <-> message converters for the structs of one generated .proto file.
+ *
+ * The converters call the accessors of the protoc message classes directly and register themselves with
+ * FLinkProtoGeneratedRegistry. Only native structs whose properties are all public scalars, strings, bytes,
+ * nested eligible structs or arrays of these get one; Blueprint structs and structs with enums, sets or maps
+ * keep the reflection converters.
+ */
+class FLinkProtoConverterGenerator
+{
+public:
+	// Writes the converters of every eligible struct reachable from TargetStructs to OutContent, returns how many were written.
+	static int32 Generate(const TArray<UScriptStruct*>& TargetStructs, const FString& ProtoFileName, FString& OutContent);
+};
@@ -2,6 +2,7 @@
 
 #include "LinkProtobufEditorFunctionLibrary.h"
 #include "LinkProtobufEditor.h"
+#include "LinkProtobufConverterGenerator.h"
 #include "LinkProtobufEditorSettings.h"
 #include "LinkProtobufFunctionLibrary.h"
 #include "ProjectDescriptor.h"
@@ -51,7 +52,16 @@ void ULinkProtobufEditorFunctionLibrary::GenerateProtoMessageFromUStruct(UScript
 	{
 		FProperty* Property = *It;
 		FieldIndex += 1;
-		if (const FArrayProperty* ArrayProp = CastField<FArrayProperty>(Property))
+		if (IsUtf8ByteArray(Property))
+		{
+			RefProtoMessage.Append(FString::Printf(TEXT("  string %s = %d;\n"), *GetProtoFieldName(Property), FieldIndex));
+		}
+		else if (ULinkProtobufFunctionLibrary::IsByteArrayProperty(Property))
+		{
+			// The whole array is one blob, not a repeated field of one byte strings
+			RefProtoMessage.Append(FString::Printf(TEXT("  bytes %s = %d;\n"), *GetProtoFieldName(Property), FieldIndex));
+		}
+		else if (const FArrayProperty* ArrayProp = CastField<FArrayProperty>(Property))
 		{
 			FString FieldType = ULinkProtobufFunctionLibrary::ProtoStringAssignProp(ArrayProp->Inner).Replace(TEXT(" "), TEXT(""));
 
@@ -89,7 +99,7 @@ void ULinkProtobufEditorFunctionLibrary::GenerateProtoMessageFromUStruct(UScript
 				}
 			}
 
-			RefProtoMessage.Append(FString::Printf(TEXT("  repeated %s %s = %d;\n"), *FieldType, *ULinkProtobufFunctionLibrary::GetPureNameOfProperty(ArrayProp), FieldIndex));
+			RefProtoMessage.Append(FString::Printf(TEXT("  repeated %s %s = %d;\n"), *FieldType, *GetProtoFieldName(ArrayProp), FieldIndex));
 		}
 		else if (const FSetProperty* SetProp = CastField<FSetProperty>(Property))
 		{
@@ -127,7 +137,7 @@ void ULinkProtobufEditorFunctionLibrary::GenerateProtoMessageFromUStruct(UScript
 					ExtraProtoMessage.Append(TEXT("}\n\n"));
 				}
 			}
-			RefProtoMessage.Append(FString::Printf(TEXT("  repeated %s %s = %d;\n"), *FieldType, *ULinkProtobufFunctionLibrary::GetPureNameOfProperty(Property), FieldIndex));
+			RefProtoMessage.Append(FString::Printf(TEXT("  repeated %s %s = %d;\n"), *FieldType, *GetProtoFieldName(Property), FieldIndex));
 		}
 		else if (const FMapProperty* MapProp = CastField<FMapProperty>(Property))
 		{
@@ -206,12 +216,12 @@ void ULinkProtobufEditorFunctionLibrary::GenerateProtoMessageFromUStruct(UScript
 				}
 			}
 
-			RefProtoMessage.Append(FString::Printf(TEXT("  map<%s,%s> %s = %d;\n"), *KeyType, *ValueType, *MapProp->GetDisplayNameText().ToString().Replace(TEXT(" "), TEXT("")), FieldIndex));
+			RefProtoMessage.Append(FString::Printf(TEXT("  map<%s,%s> %s = %d;\n"), *KeyType, *ValueType, *GetProtoFieldName(MapProp), FieldIndex));
 		}
 		else if (const FStructProperty* StructProp = CastField<FStructProperty>(Property))
 		{
 			FString StructName = StructProp->Struct->GetName();
-			RefProtoMessage.Append(FString::Printf(TEXT("  %s %s = %d;\n"), *StructName, *StructProp->GetDisplayNameText().ToString().Replace(TEXT(" "), TEXT("")), FieldIndex));
+			RefProtoMessage.Append(FString::Printf(TEXT("  %s %s = %d;\n"), *StructName, *GetProtoFieldName(StructProp), FieldIndex));
 			if (!AssociatedStructs.Contains(StructName))
 			{
 				AssociatedStructs.Add(StructName);
@@ -224,7 +234,7 @@ void ULinkProtobufEditorFunctionLibrary::GenerateProtoMessageFromUStruct(UScript
 		else if (const FEnumProperty* EnumProp = CastField<FEnumProperty>(Property))
 		{
 			FString EnumName = EnumProp->GetEnum()->GetName();
-			RefProtoMessage.Append(FString::Printf(TEXT("  %s %s = %d;\n"), *EnumName, *EnumProp->GetDisplayNameText().ToString().Replace(TEXT(" "), TEXT("")), FieldIndex));
+			RefProtoMessage.Append(FString::Printf(TEXT("  %s %s = %d;\n"), *EnumName, *GetProtoFieldName(EnumProp), FieldIndex));
 			if (!AssociatedEnums.Contains(EnumName))
 			{
 				AssociatedEnums.Add(EnumName);
@@ -247,7 +257,7 @@ void ULinkProtobufEditorFunctionLibrary::GenerateProtoMessageFromUStruct(UScript
 			FString FieldType = ULinkProtobufFunctionLibrary::ProtoStringAssignProp(Property);
 			if (FieldType != TEXT("unknown"))
 			{
-				RefProtoMessage.Append(FString::Printf(TEXT("  %s %s = %d;\n"), *FieldType, *ULinkProtobufFunctionLibrary::GetPureNameOfProperty(Property), FieldIndex));
+				RefProtoMessage.Append(FString::Printf(TEXT("  %s %s = %d;\n"), *FieldType, *GetProtoFieldName(Property), FieldIndex));
 			}
 		}
 	}
@@ -259,6 +269,21 @@ void ULinkProtobufEditorFunctionLibrary::GenerateProtoMessageFromUStruct(UScript
 }
 
 
+FString ULinkProtobufEditorFunctionLibrary::GetProtoFieldName(const FProperty* Property)
+{
+	// Maps, structs and enums are named after their display name, everything else after the authored name
+	if (Property && (Property->IsA<FMapProperty>() || Property->IsA<FStructProperty>() || Property->IsA<FEnumProperty>()))
+	{
+		return Property->GetDisplayNameText().ToString().Replace(TEXT(" "), TEXT(""));
+	}
+	return ULinkProtobufFunctionLibrary::GetPureNameOfProperty(Property);
+}
+
+bool ULinkProtobufEditorFunctionLibrary::IsUtf8ByteArray(const FProperty* Property)
+{
+	return ULinkProtobufFunctionLibrary::IsByteArrayProperty(Property) && Property->HasMetaData(TEXT("ProtoUtf8"));
+}
+
 void ULinkProtobufEditorFunctionLibrary::GenerateProtoMessageFromUStructArray(TArray<UScriptStruct*> TargetStructs, FString& MainProtoMessage)
 {
 	if (TargetStructs.Num() == 0) return;
@@ -329,9 +354,12 @@ void ULinkProtobufEditorFunctionLibrary::GenerateProtoCppFile()
     }
 
     FString ProtoFilePath = GetProtoFilePath();
-    FString ProtocCommand = FString::Printf(TEXT("%s protoc --proto_path=\"%s\" --cpp_out=\"%s\" \"%s\""),
+    // Typed converters live in the game module, the message classes they call must be exported from the runtime module
+    const FString CppOutOptions = ULinkProtobufEditorSettings::Get()->bGenerateTypedConverters ? TEXT("dllexport_decl=LINKPROTOBUFRUNTIME_API:") : TEXT("");
+    FString ProtocCommand = FString::Printf(TEXT("%s protoc --proto_path=\"%s\" --cpp_out=\"%s%s\" \"%s\""),
         *CommandPrefix,
         *ULinkProtobufEditorSettings::Get()->GetDefaultProtobufGenPath(),
+        *CppOutOptions,
         *ULinkProtobufEditorSettings::Get()->GetDefaultProtobufGenPath(),
         *ProtoFilePath);
 
@@ -369,6 +397,34 @@ void ULinkProtobufEditorFunctionLibrary::GenerateProtoCppFile()
 
 }
 
+bool ULinkProtobufEditorFunctionLibrary::GenerateTypedConverterFile(const TArray<UScriptStruct*>& TargetStructs)
+{
+	const ULinkProtobufEditorSettings* Settings = ULinkProtobufEditorSettings::Get();
+	const FString OutputPath = FPaths::Combine(Settings->GetTypedConverterGenPath(), Settings->ProtoFileName + TEXT("ProtoConverters.cpp"));
+
+	FString Content;
+	const int32 NumConverters = FLinkProtoConverterGenerator::Generate(TargetStructs, Settings->ProtoFileName, Content);
+	if (NumConverters == 0)
+	{
+		UE_LOG(LogProtoEditor, Warning, TEXT("No struct is eligible for a typed converter, %s not written"), *OutputPath);
+		return false;
+	}
+
+	bool bSuccess = FFileHelper::SaveStringToFile(Content, *OutputPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
+	if (!bSuccess)
+	{
+#if WITH_EDITOR
+		FText Msg = FText::Format(LOCTEXT("ConverterSaveFailedContent", "Failed to save the typed converters to {0}. Please check that the 'Typed Converter Generate Path' in LinkProtobuf settings is writable."), FText::FromString(OutputPath));
+		FMessageDialog::Open(EAppMsgType::Ok, Msg);
+#else
+		UE_LOG(LogProtoEditor, Error, TEXT("Failed to save typed converters: %s"), *OutputPath);
+#endif
+		return false;
+	}
+	UE_LOG(LogProtoEditor, Display, TEXT("Generated %d typed converters in %s, the module compiling it must depend on LinkProtobufRuntime"), NumConverters, *OutputPath);
+	return true;
+}
+
 FString ULinkProtobufEditorFunctionLibrary::GetProtoFilePath()
 {
 	return FPaths::Combine
@@ -3,6 +3,8 @@
 #include "LinkProtobufEditorSettings.h"
 #include "LinkProtobufEditor.h"
 #include "Interfaces/IPluginManager.h"
+#include "Interfaces/IProjectManager.h"
+#include "ProjectDescriptor.h"
 
 ULinkProtobufEditorSettings::ULinkProtobufEditorSettings()
 {
@@ -52,3 +54,18 @@ FString ULinkProtobufEditorSettings::GetDefaultProtocExecPath() const
 	return FString();
 }
 
+FString ULinkProtobufEditorSettings::GetDefaultTypedConverterGenPath() const
+{
+	const FProjectDescriptor* Project = IProjectManager::Get().GetCurrentProject();
+	if (Project && Project->Modules.Num() > 0)
+	{
+		return FPaths::Combine(FPaths::GameSourceDir(), Project->Modules[0].Name.ToString(), TEXT("Private"), TEXT("LinkProtoGenerated"));
+	}
+	UE_LOG(LogProtoEditor, Error, TEXT("LinkProtobufEditorSettings: Project has no C++ module for the typed converters!"));
+	return FString();
+}
+
+FString ULinkProtobufEditorSettings::GetTypedConverterGenPath() const
+{
+	return TypedConverterGeneratePath.IsEmpty() ? GetDefaultTypedConverterGenPath() : TypedConverterGeneratePath;
+}
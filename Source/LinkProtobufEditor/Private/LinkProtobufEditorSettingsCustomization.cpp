@@ -154,15 +154,30 @@ FReply FLinkProtobufEditorSettingsCustomization::OnButtonGenerateProtoFromSettin
 			MissingStructs.Add(StructPtr.GetAssetName());
 		}
 	}
+	for (const TSoftObjectPtr<UScriptStruct>& StructPtr : Settings->NativeStructsForProtobuf)
+	{
+		if (StructPtr.IsValid())
+		{
+			StructsToProcess.AddUnique(StructPtr.Get());
+		}
+		else
+		{
+			MissingStructs.Add(StructPtr.GetAssetName());
+		}
+	}
 	//Editor Warning
 	if (MissingStructs.Num() > 0)
 	{
 		FString MissingStr = FString::Join(MissingStructs, TEXT("\n"));
-		FMessageDialog::Open(EAppMsgType::Ok, FText::FromString(FString::Printf(TEXT("Some UserDefinedStructs are missing or invalid:\n%s \nPlease Rechoose them!"), *MissingStr)));
+		FMessageDialog::Open(EAppMsgType::Ok, FText::FromString(FString::Printf(TEXT("Some structs are missing or invalid:\n%s \nPlease Rechoose them!"), *MissingStr)));
 		return FReply::Handled();
 	}
 
 	ULinkProtobufEditorFunctionLibrary::GenerateProtoFile(StructsToProcess);
+	if (Settings->bGenerateTypedConverters)
+	{
+		ULinkProtobufEditorFunctionLibrary::GenerateTypedConverterFile(StructsToProcess);
+	}
 	ULinkProtobufEditorFunctionLibrary::GenerateProtoCppFile();
 	return FReply::Handled();
 }
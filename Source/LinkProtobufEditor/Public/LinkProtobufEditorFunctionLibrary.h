@@ -73,6 +73,15 @@ public:
 
 	static void GenerateProtoCppFile();
 
+	// Writes the typed converters of the eligible native structs next to the game sources, see FLinkProtoConverterGenerator.
+	static bool GenerateTypedConverterFile(const TArray<UScriptStruct*>& TargetStructs);
+
+	// Name of the proto field generated for a struct property.
+	static FString GetProtoFieldName(const FProperty* Property);
+
+	// True for a TArray<uint8> tagged meta=(ProtoUtf8), generated as a single string field holding the UTF-8 bytes.
+	static bool IsUtf8ByteArray(const FProperty* Property);
+
 	static FString GetProtoFilePath();
 
 	bool GenerateProtoDataFromUStruct();
@@ -17,6 +17,8 @@ class LINKPROTOBUFEDITOR_API ULinkProtobufEditorSettings : public UObject
 public:
 	FString GetDefaultProtobufGenPath() const;
 	FString GetDefaultProtocExecPath() const;
+	FString GetDefaultTypedConverterGenPath() const;
+	FString GetTypedConverterGenPath() const;
 	static const ULinkProtobufEditorSettings*Get() { return GetDefault<ULinkProtobufEditorSettings>(); }
 	UPROPERTY(Config, EditAnywhere, Category = "Link Protobuf Environment", meta=(ToolTip="Do not modify this value unless you are understand. Changing it may cause complie error."))
 	FString ProtoFileName=TEXT("User");
@@ -30,4 +32,13 @@ public:
 	//Add Your DefinedStruct here to generate .proto file
 	UPROPERTY(config, EditAnywhere, Category = "Link Protobuf User Settings", meta=(AllowedClasses="/Script/Engine.UserDefinedStruct"))
 	TArray<TSoftObjectPtr<UUserDefinedStruct>> UserDefinedStructsForProtobuf;
+	//Add C++ structs here to generate .proto file, they can also get typed converters
+	UPROPERTY(config, EditAnywhere, Category = "Link Protobuf User Settings")
+	TArray<TSoftObjectPtr<UScriptStruct>> NativeStructsForProtobuf;
+	//Also write typed converters for the native structs, conversions of compiled messages then skip property reflection
+	UPROPERTY(config, EditAnywhere, Category = "Link Protobuf User Settings", meta=(ToolTip="Writes a .cpp of typed struct <-> message converters into a game module. The module must depend on LinkProtobufRuntime."))
+	bool bGenerateTypedConverters = false;
+	//Directory of the generated converters, empty means Private/LinkProtoGenerated of the first project module
+	UPROPERTY(config, EditAnywhere, Category = "Link Protobuf User Settings", meta=(EditCondition="bGenerateTypedConverters"))
+	FString TypedConverterGeneratePath;
 };
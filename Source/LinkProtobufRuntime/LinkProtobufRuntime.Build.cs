@@ -27,6 +27,10 @@ public class LinkProtobufRuntime : ModuleRules
 				"SlateCore",
 			}
 		);
+#if !UE_5_5_OR_LATER
+		// FInstancedStruct of the async API moved from the StructUtils plugin into CoreUObject in 5.5
+		PublicDependencyModuleNames.Add("StructUtils");
+#endif
 #if UE_5_6_OR_LATER
         CppCompileWarningSettings.ShadowVariableWarningLevel = WarningLevel.Off;
 #elif UE_4_24_OR_LATER
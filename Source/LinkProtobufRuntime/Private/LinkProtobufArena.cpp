@@ -0,0 +1,110 @@
+// Copyright DarkestLink-Dev 2025 All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// SPDX-License-Identifier: Apache-2.0
+
+
+#include "LinkProtobufArena.h"
+#include "LinkProtobufRuntime.h"
+#include "LinkProtobufRuntimeSettings.h"
+
+using Arena        = google::protobuf::Arena;
+using ArenaOptions = google::protobuf::ArenaOptions;
+using Message      = google::protobuf::Message;
+
+static void* LinkProtoArenaBlockAlloc(size_t Size)
+{
+	return FMemory::Malloc(Size);
+}
+
+static void LinkProtoArenaBlockDealloc(void* Block, size_t)
+{
+	FMemory::Free(Block);
+}
+
+// The arena of one thread, created by the first scope that needs it and kept until the thread exits.
+struct FLinkProtoThreadArena
+{
+	TUniquePtr<Arena> Instance;
+	char* InitialBlock = nullptr;
+	int32 Depth = 0;
+
+	~FLinkProtoThreadArena()
+	{
+		// The arena may still hand its blocks back, the initial block goes last
+		Instance.Reset();
+		FMemory::Free(InitialBlock);
+	}
+
+	Arena* Acquire()
+	{
+		if (!Instance)
+		{
+			const ULinkProtobufRuntimeSettings* Settings = ULinkProtobufRuntimeSettings::Get();
+			ArenaOptions Options;
+			Options.block_alloc = &LinkProtoArenaBlockAlloc;
+			Options.block_dealloc = &LinkProtoArenaBlockDealloc;
+			Options.max_block_size = static_cast<size_t>(FMath::Max(Settings->ArenaMaxBlockSize, 256));
+			Options.start_block_size = FMath::Min<size_t>(Options.start_block_size, Options.max_block_size);
+			if (Settings->ArenaInitialBlockSize > 0)
+			{
+				InitialBlock = static_cast<char*>(FMemory::Malloc(Settings->ArenaInitialBlockSize));
+				Options.initial_block = InitialBlock;
+				Options.initial_block_size = Settings->ArenaInitialBlockSize;
+			}
+			Instance = MakeUnique<Arena>(Options);
+		}
+		++Depth;
+		return Instance.Get();
+	}
+
+	void Release()
+	{
+		check(Depth > 0);
+		if (--Depth == 0)
+		{
+			const uint64 SpaceAllocated = Instance->Reset();
+			UE_LOG(LogProto, VeryVerbose, TEXT("Proto thread arena reset, %llu bytes released"), SpaceAllocated);
+		}
+	}
+};
+
+static thread_local FLinkProtoThreadArena GLinkProtoThreadArena;
+
+FLinkProtoArenaScope::FLinkProtoArenaScope()
+	: Arena(ULinkProtobufRuntimeSettings::Get()->bUseMessageArena ? GLinkProtoThreadArena.Acquire() : nullptr)
+{
+}
+
+FLinkProtoArenaScope::~FLinkProtoArenaScope()
+{
+	for (Message* HeapMessage : HeapMessages)
+	{
+		delete HeapMessage;
+	}
+	if (Arena)
+	{
+		GLinkProtoThreadArena.Release();
+	}
+}
+
+Message* FLinkProtoArenaScope::NewMessage(const Message& Prototype)
+{
+	if (Arena)
+	{
+		return Prototype.New(Arena);
+	}
+	Message* HeapMessage = Prototype.New();
+	HeapMessages.Add(HeapMessage);
+	return HeapMessage;
+}
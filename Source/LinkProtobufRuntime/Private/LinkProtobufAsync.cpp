@@ -0,0 +1,140 @@
+// Copyright DarkestLink-Dev 2025 All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// SPDX-License-Identifier: Apache-2.0
+
+
+#include "LinkProtobufAsync.h"
+#include "LinkProtobufArena.h"
+#include "LinkProtobufRuntime.h"
+#include "LinkProtobufWireDecoder.h"
+#include "LinkProtobufWireEncoder.h"
+#include <google/protobuf/message.h>
+
+using Message = google::protobuf::Message;
+
+FLinkProtoStructPlanPtr FLinkProtoAsync::FindPlan(const UScriptStruct* StructDefinition)
+{
+	FLinkProtoStructPlanPtr Plan = FLinkProtoPlanCache::Get().FindOrBuild(StructDefinition);
+	if (!Plan)
+	{
+		UE_LOG(LogProto, Error, TEXT("Proto async: descriptor not found for %s"), *StructDefinition->GetName());
+	}
+	return Plan;
+}
+
+bool FLinkProtoAsync::Encode(const FLinkProtoStructPlan& Plan, const void* Struct, TArray<uint8>& OutBytes)
+{
+	if (!FLinkProtoWireEncoder::Encode(Plan, Struct, OutBytes))
+	{
+		UE_LOG(LogProto, Error, TEXT("Proto async encode: serialization failed for %s"), *Plan.StructName);
+		return false;
+	}
+	return true;
+}
+
+bool FLinkProtoAsync::Decode(const FLinkProtoStructPlan& Plan, TConstArrayView<uint8> Bytes, bool bAllowIncomplete, void* OutStruct)
+{
+	if (Bytes.Num() <= 0)
+	{
+		UE_LOG(LogProto, Warning, TEXT("Proto async decode: empty bytes for %s"), *Plan.StructName);
+		return false;
+	}
+	bool bDecodeOk;
+	// Required fields only exist in proto2, checking them needs the parsed message
+	if (bAllowIncomplete || Plan.Descriptor->file()->syntax() != google::protobuf::FileDescriptor::SYNTAX_PROTO2)
+	{
+		bDecodeOk = FLinkProtoWireDecoder::Decode(Plan, Bytes, OutStruct);
+	}
+	else if (!Plan.Prototype)
+	{
+		UE_LOG(LogProto, Error, TEXT("Proto async decode: prototype not found for %s"), *Plan.StructName);
+		return false;
+	}
+	else
+	{
+		FLinkProtoArenaScope ArenaScope;
+		Message* ParsedMsg = ArenaScope.NewMessage(*Plan.Prototype);
+		bDecodeOk = ParsedMsg->ParsePartialFromArray(Bytes.GetData(), Bytes.Num()) && ParsedMsg->IsInitialized();
+		if (bDecodeOk)
+		{
+			FLinkProtoWireDecoder::ResetFields(Plan, OutStruct);
+			bDecodeOk = Plan.ReadFromMessage(*ParsedMsg, OutStruct);
+		}
+	}
+	if (!bDecodeOk)
+	{
+		UE_LOG(LogProto, Error, TEXT("Proto async decode: parse failed for %s (AllowIncomplete=%s)"), *Plan.StructName, bAllowIncomplete ? TEXT("true") : TEXT("false"));
+	}
+	return bDecodeOk;
+}
+
+TFuture<TOptional<TArray<uint8>>> FLinkProtoAsync::EncodeStruct(const UScriptStruct* StructDefinition, const void* Struct)
+{
+	if (!StructDefinition || !Struct)
+	{
+		UE_LOG(LogProto, Error, TEXT("Proto async encode: invalid struct inputs"));
+		return MakeFulfilledPromise<TOptional<TArray<uint8>>>().GetFuture();
+	}
+	FInstancedStruct Copy;
+	Copy.InitializeAs(StructDefinition, static_cast<const uint8*>(Struct));
+	return EncodeStruct(MoveTemp(Copy));
+}
+
+TFuture<TOptional<TArray<uint8>>> FLinkProtoAsync::EncodeStruct(FInstancedStruct Struct)
+{
+	const UScriptStruct* StructDefinition = Struct.GetScriptStruct();
+	if (!StructDefinition)
+	{
+		UE_LOG(LogProto, Error, TEXT("Proto async encode: empty instanced struct"));
+		return MakeFulfilledPromise<TOptional<TArray<uint8>>>().GetFuture();
+	}
+	FLinkProtoStructPlanPtr Plan = FindPlan(StructDefinition);
+	if (!Plan)
+	{
+		return MakeFulfilledPromise<TOptional<TArray<uint8>>>().GetFuture();
+	}
+	return Async(EAsyncExecution::ThreadPool, [Plan = MoveTemp(Plan), Struct = MoveTemp(Struct)]()
+	{
+		TArray<uint8> Bytes;
+		if (!Encode(*Plan, Struct.GetMemory(), Bytes))
+		{
+			return TOptional<TArray<uint8>>();
+		}
+		return TOptional<TArray<uint8>>(MoveTemp(Bytes));
+	});
+}
+
+TFuture<TOptional<FInstancedStruct>> FLinkProtoAsync::DecodeStruct(UScriptStruct* StructDefinition, TArray<uint8> Bytes, bool bAllowIncomplete)
+{
+	if (!StructDefinition)
+	{
+		UE_LOG(LogProto, Error, TEXT("Proto async decode: invalid struct definition"));
+		return MakeFulfilledPromise<TOptional<FInstancedStruct>>().GetFuture();
+	}
+	FLinkProtoStructPlanPtr Plan = FindPlan(StructDefinition);
+	if (!Plan)
+	{
+		return MakeFulfilledPromise<TOptional<FInstancedStruct>>().GetFuture();
+	}
+	// The instance is constructed here, the worker only fills it
+	FInstancedStruct Result(StructDefinition);
+	return Async(EAsyncExecution::ThreadPool, [Plan = MoveTemp(Plan), Bytes = MoveTemp(Bytes), Result = MoveTemp(Result), bAllowIncomplete]() mutable
+	{
+		if (!Decode(*Plan, Bytes, bAllowIncomplete, Result.GetMutableMemory()))
+		{
+			return TOptional<FInstancedStruct>();
+		}
+		return TOptional<FInstancedStruct>(MoveTemp(Result));
+	});
+}
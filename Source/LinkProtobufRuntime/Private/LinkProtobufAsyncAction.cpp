@@ -0,0 +1,90 @@
+// Copyright DarkestLink-Dev 2025 All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// SPDX-License-Identifier: Apache-2.0
+
+
+#include "LinkProtobufAsyncAction.h"
+#include "LinkProtobufAsync.h"
+
+// ---------------------------------------------------------------------------------------------------------------------
+// ULinkProtobufEncodeAsyncAction
+// ---------------------------------------------------------------------------------------------------------------------
+
+ULinkProtobufEncodeAsyncAction* ULinkProtobufEncodeAsyncAction::StructToBinaryProtoBytesAsync(UObject* WorldContextObject, const FInstancedStruct& Struct)
+{
+	ULinkProtobufEncodeAsyncAction* Action = NewObject<ULinkProtobufEncodeAsyncAction>();
+	Action->Struct = Struct;
+	Action->RegisterWithGameInstance(WorldContextObject);
+	return Action;
+}
+
+void ULinkProtobufEncodeAsyncAction::Activate()
+{
+	TWeakObjectPtr<ULinkProtobufEncodeAsyncAction> WeakThis(this);
+	FLinkProtoAsync::EncodeStruct(MoveTemp(Struct)).Then([WeakThis](TFuture<TOptional<TArray<uint8>>> Future)
+	{
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, Result = Future.Consume()]() mutable
+		{
+			if (ULinkProtobufEncodeAsyncAction* Action = WeakThis.Get())
+			{
+				Action->Finish(MoveTemp(Result));
+			}
+		});
+	});
+}
+
+void ULinkProtobufEncodeAsyncAction::Finish(TOptional<TArray<uint8>> Result)
+{
+	static const TArray<uint8> EmptyBytes;
+	Completed.Broadcast(Result.IsSet(), Result.IsSet() ? Result.GetValue() : EmptyBytes);
+	SetReadyToDestroy();
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// ULinkProtobufDecodeAsyncAction
+// ---------------------------------------------------------------------------------------------------------------------
+
+ULinkProtobufDecodeAsyncAction* ULinkProtobufDecodeAsyncAction::ProtoBinaryBytesToStructAsync(UObject* WorldContextObject, UScriptStruct* StructDefinition,
+	bool bAllowIncomplete, const TArray<uint8>& ProtoBinaryBytes)
+{
+	ULinkProtobufDecodeAsyncAction* Action = NewObject<ULinkProtobufDecodeAsyncAction>();
+	Action->StructDefinition = StructDefinition;
+	Action->bAllowIncomplete = bAllowIncomplete;
+	Action->Bytes = ProtoBinaryBytes;
+	Action->RegisterWithGameInstance(WorldContextObject);
+	return Action;
+}
+
+void ULinkProtobufDecodeAsyncAction::Activate()
+{
+	// The action stays registered until SetReadyToDestroy, which also keeps StructDefinition referenced for the task
+	TWeakObjectPtr<ULinkProtobufDecodeAsyncAction> WeakThis(this);
+	FLinkProtoAsync::DecodeStruct(StructDefinition, MoveTemp(Bytes), bAllowIncomplete).Then([WeakThis](TFuture<TOptional<FInstancedStruct>> Future)
+	{
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, Result = Future.Consume()]() mutable
+		{
+			if (ULinkProtobufDecodeAsyncAction* Action = WeakThis.Get())
+			{
+				Action->Finish(MoveTemp(Result));
+			}
+		});
+	});
+}
+
+void ULinkProtobufDecodeAsyncAction::Finish(TOptional<FInstancedStruct> Result)
+{
+	static const FInstancedStruct EmptyStruct;
+	Completed.Broadcast(Result.IsSet(), Result.IsSet() ? Result.GetValue() : EmptyStruct);
+	SetReadyToDestroy();
+}
@@ -0,0 +1,203 @@
+// Copyright DarkestLink-Dev 2025 All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// SPDX-License-Identifier: Apache-2.0
+
+
+#include "LinkProtobufBatch.h"
+#include "Async/ParallelFor.h"
+#include "LinkProtobufArena.h"
+#include "LinkProtobufConversionPlan.h"
+#include "LinkProtobufRuntime.h"
+#include "LinkProtobufWireDecoder.h"
+#include "LinkProtobufWireEncoder.h"
+#include "Misc/ScopeExit.h"
+#include <atomic>
+
+using Message = google::protobuf::Message;
+
+// Structs per encode task, enough to amortize the task overhead over small structs
+static constexpr int32 EncodeChunkSize = 32;
+// Records per decode task handed out by ParallelFor
+static constexpr int32 DecodeMinBatchSize = 16;
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Encode
+// ---------------------------------------------------------------------------------------------------------------------
+
+struct FLinkProtoBatchChunk
+{
+	// Length prefixes recorded by the size pass of the chunk's structs, in order
+	TArray<uint32> LengthPrefixes;
+	bool bSizeOk = true;
+};
+
+// Chunk scratch kept between the batches of a thread, a nested batch on the same thread finds it empty and allocates its own
+static thread_local TArray<FLinkProtoBatchChunk> CachedChunks;
+
+bool FLinkProtoBatch::EncodeStructs(const UScriptStruct* StructDefinition, const void* Structs, int32 Num, FLinkProtoEncodedBatch& OutBatch)
+{
+	OutBatch.Bytes.Reset();
+	OutBatch.Offsets.Reset();
+	if (!StructDefinition || Num < 0 || (Num > 0 && !Structs))
+	{
+		UE_LOG(LogProto, Error, TEXT("Proto batch encode: invalid struct inputs"));
+		return false;
+	}
+	FLinkProtoStructPlanPtr Plan = FLinkProtoPlanCache::Get().FindOrBuild(StructDefinition);
+	if (!Plan)
+	{
+		UE_LOG(LogProto, Error, TEXT("Proto batch encode: descriptor not found for %s"), *StructDefinition->GetName());
+		return false;
+	}
+
+	const int32 Stride = StructDefinition->GetStructureSize();
+	const uint8* StructBytes = static_cast<const uint8*>(Structs);
+	const int32 NumChunks = FMath::DivideAndRoundUp(Num, EncodeChunkSize);
+	TArray<FLinkProtoBatchChunk> Chunks = MoveTemp(CachedChunks);
+	ON_SCOPE_EXIT
+	{
+		CachedChunks = MoveTemp(Chunks);
+	};
+	if (Chunks.Num() < NumChunks)
+	{
+		Chunks.SetNum(NumChunks);
+	}
+
+	// Size pass, Offsets[I + 1] holds the size of record I until the prefix sum below
+	OutBatch.Offsets.SetNumUninitialized(Num + 1);
+	int32* Offsets = OutBatch.Offsets.GetData();
+	Offsets[0] = 0;
+	ParallelFor(TEXT("LinkProto.BatchEncodeSize"), NumChunks, 1, [&](int32 ChunkIndex)
+	{
+		FLinkProtoBatchChunk& Chunk = Chunks[ChunkIndex];
+		Chunk.LengthPrefixes.Reset();
+		Chunk.bSizeOk = true;
+		const int32 End = FMath::Min(Num, (ChunkIndex + 1) * EncodeChunkSize);
+		for (int32 Index = ChunkIndex * EncodeChunkSize; Index < End; ++Index)
+		{
+			const uint64 Size = FLinkProtoWireEncoder::ComputeSize(*Plan, StructBytes + static_cast<int64>(Index) * Stride, Chunk.LengthPrefixes);
+			Chunk.bSizeOk &= Size <= static_cast<uint64>(MAX_int32);
+			Offsets[Index + 1] = static_cast<int32>(FMath::Min<uint64>(Size, MAX_int32));
+		}
+	});
+
+	bool bSizesOk = true;
+	for (int32 ChunkIndex = 0; ChunkIndex < NumChunks; ++ChunkIndex)
+	{
+		bSizesOk &= Chunks[ChunkIndex].bSizeOk;
+	}
+	int64 TotalSize = 0;
+	for (int32 Index = 0; Index < Num && bSizesOk; ++Index)
+	{
+		TotalSize += Offsets[Index + 1];
+		bSizesOk = TotalSize <= MAX_int32;
+		Offsets[Index + 1] = static_cast<int32>(TotalSize);
+	}
+	if (!bSizesOk)
+	{
+		UE_LOG(LogProto, Error, TEXT("Proto batch encode: %d records of %s exceed the 2GB buffer limit"), Num, *Plan->StructName);
+		OutBatch.Offsets.Reset();
+		return false;
+	}
+
+	// Write pass, every chunk writes its records at their offsets
+	OutBatch.Bytes.SetNumUninitialized(static_cast<int32>(TotalSize));
+	uint8* Target = OutBatch.Bytes.GetData();
+	ParallelFor(TEXT("LinkProto.BatchEncodeWrite"), NumChunks, 1, [&](int32 ChunkIndex)
+	{
+		const FLinkProtoBatchChunk& Chunk = Chunks[ChunkIndex];
+		const uint32* Cursor = Chunk.LengthPrefixes.GetData();
+		const int32 End = FMath::Min(Num, (ChunkIndex + 1) * EncodeChunkSize);
+		for (int32 Index = ChunkIndex * EncodeChunkSize; Index < End; ++Index)
+		{
+			uint8* RecordEnd = FLinkProtoWireEncoder::Write(*Plan, StructBytes + static_cast<int64>(Index) * Stride, Cursor, Target + Offsets[Index]);
+			check(RecordEnd == Target + Offsets[Index + 1]);
+		}
+		check(Cursor == Chunk.LengthPrefixes.GetData() + Chunk.LengthPrefixes.Num());
+	});
+	return true;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Decode
+// ---------------------------------------------------------------------------------------------------------------------
+
+static bool DecodeRecord(const FLinkProtoStructPlan& Plan, bool bCheckRequired, TConstArrayView<uint8> Record, void* OutStruct)
+{
+	if (!bCheckRequired)
+	{
+		return FLinkProtoWireDecoder::Decode(Plan, Record, OutStruct);
+	}
+	// The arena of the worker thread is reset after every record
+	FLinkProtoArenaScope ArenaScope;
+	Message* ParsedMsg = ArenaScope.NewMessage(*Plan.Prototype);
+	if (!ParsedMsg->ParsePartialFromArray(Record.GetData(), Record.Num()) || !ParsedMsg->IsInitialized())
+	{
+		return false;
+	}
+	FLinkProtoWireDecoder::ResetFields(Plan, OutStruct);
+	return Plan.ReadFromMessage(*ParsedMsg, OutStruct);
+}
+
+template<typename GetRecordFunc>
+static bool DecodeBatch(const UScriptStruct* StructDefinition, int32 Num, void* OutStructs, bool bAllowIncomplete, GetRecordFunc&& GetRecord)
+{
+	if (!StructDefinition || (Num > 0 && !OutStructs))
+	{
+		UE_LOG(LogProto, Error, TEXT("Proto batch decode: invalid struct inputs"));
+		return false;
+	}
+	FLinkProtoStructPlanPtr Plan = FLinkProtoPlanCache::Get().FindOrBuild(StructDefinition);
+	if (!Plan)
+	{
+		UE_LOG(LogProto, Error, TEXT("Proto batch decode: descriptor not found for %s"), *StructDefinition->GetName());
+		return false;
+	}
+	// Required fields only exist in proto2, checking them needs the parsed message
+	const bool bCheckRequired = !bAllowIncomplete && Plan->Descriptor->file()->syntax() == google::protobuf::FileDescriptor::SYNTAX_PROTO2;
+	if (bCheckRequired && !Plan->Prototype)
+	{
+		UE_LOG(LogProto, Error, TEXT("Proto batch decode: prototype not found for %s"), *Plan->StructName);
+		return false;
+	}
+
+	const int32 Stride = StructDefinition->GetStructureSize();
+	uint8* StructBytes = static_cast<uint8*>(OutStructs);
+	std::atomic<int32> NumFailed{0};
+	ParallelFor(TEXT("LinkProto.BatchDecode"), Num, DecodeMinBatchSize, [&](int32 Index)
+	{
+		if (!DecodeRecord(*Plan, bCheckRequired, GetRecord(Index), StructBytes + static_cast<int64>(Index) * Stride))
+		{
+			NumFailed.fetch_add(1, std::memory_order_relaxed);
+			UE_LOG(LogProto, Error, TEXT("Proto batch decode: record %d of %s failed to decode"), Index, *Plan->StructName);
+		}
+	});
+	return NumFailed.load() == 0;
+}
+
+bool FLinkProtoBatch::DecodeStructs(const UScriptStruct* StructDefinition, TConstArrayView<TConstArrayView<uint8>> Records, void* OutStructs, bool bAllowIncomplete)
+{
+	return DecodeBatch(StructDefinition, Records.Num(), OutStructs, bAllowIncomplete, [Records](int32 Index)
+	{
+		return Records[Index];
+	});
+}
+
+bool FLinkProtoBatch::DecodeStructs(const UScriptStruct* StructDefinition, const FLinkProtoEncodedBatch& Batch, void* OutStructs, bool bAllowIncomplete)
+{
+	return DecodeBatch(StructDefinition, Batch.Num(), OutStructs, bAllowIncomplete, [&Batch](int32 Index)
+	{
+		return Batch.GetRecord(Index);
+	});
+}
@@ -0,0 +1,1024 @@
+// Copyright DarkestLink-Dev 2025 All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "LinkProtobufConversionPlan.h"
+#include "google/protobuf/descriptor.h"
+#include "google/protobuf/io/coded_stream.h"
+#include "google/protobuf/wire_format.h"
+#include "LinkProtobufFunctionLibrary.h"
+#include "LinkProtobufGeneratedRegistry.h"
+#include "LinkProtobufNameCache.h"
+#include "LinkProtobufRuntime.h"
+#include "LinkProtobufRuntimeSettings.h"
+#include "LinkProtobufValueAccess.h"
+#include "LinkProtobufWireDecoder.h"
+#include "LinkProtobufWireEncoder.h"
+#include "Algo/BinarySearch.h"
+#include "UObject/TextProperty.h"
+
+using Descriptor           = google::protobuf::Descriptor;
+using FieldDescriptor      = google::protobuf::FieldDescriptor;
+using EnumValueDescriptor  = google::protobuf::EnumValueDescriptor;
+using Message              = google::protobuf::Message;
+using Reflection           = google::protobuf::Reflection;
+using DescriptorPool       = google::protobuf::DescriptorPool;
+using MessageFactory       = google::protobuf::MessageFactory;
+using WireFormat           = google::protobuf::internal::WireFormat;
+using CodedInputStream     = google::protobuf::io::CodedInputStream;
+using CodedOutputStream    = google::protobuf::io::CodedOutputStream;
+
+ELinkProtoValueType LinkProtoClassifyProperty(const FProperty* Property)
+{
+	if (const FEnumProperty* EnumProp = CastField<FEnumProperty>(Property))
+	{
+		Property = EnumProp->GetUnderlyingProperty();
+	}
+	if (!Property)                              return ELinkProtoValueType::Unsupported;
+	if (CastField<FBoolProperty>(Property))     return ELinkProtoValueType::Bool;
+	if (CastField<FInt8Property>(Property))     return ELinkProtoValueType::Int8;
+	if (CastField<FInt16Property>(Property))    return ELinkProtoValueType::Int16;
+	if (CastField<FIntProperty>(Property))      return ELinkProtoValueType::Int32;
+	if (CastField<FInt64Property>(Property))    return ELinkProtoValueType::Int64;
+	if (CastField<FByteProperty>(Property))     return ELinkProtoValueType::UInt8;
+	if (CastField<FUInt16Property>(Property))   return ELinkProtoValueType::UInt16;
+	if (CastField<FUInt32Property>(Property))   return ELinkProtoValueType::UInt32;
+	if (CastField<FUInt64Property>(Property))   return ELinkProtoValueType::UInt64;
+	if (CastField<FFloatProperty>(Property))    return ELinkProtoValueType::Float;
+	if (CastField<FDoubleProperty>(Property))   return ELinkProtoValueType::Double;
+	if (CastField<FStrProperty>(Property))      return ELinkProtoValueType::String;
+	if (CastField<FNameProperty>(Property))     return ELinkProtoValueType::Name;
+	if (CastField<FTextProperty>(Property))     return ELinkProtoValueType::Text;
+#if LINKPROTO_WITH_UTF8_STRING_PROPERTIES
+	if (CastField<FUtf8StrProperty>(Property))  return ELinkProtoValueType::Utf8String;
+	if (CastField<FAnsiStrProperty>(Property))  return ELinkProtoValueType::AnsiString;
+#endif
+	if (CastField<FStructProperty>(Property))   return ELinkProtoValueType::Struct;
+	return ELinkProtoValueType::Unsupported;
+}
+
+ELinkProtoValueType LinkProtoClassifySingularProperty(const FProperty* Property, const FieldDescriptor* Field)
+{
+	if (CastField<FArrayProperty>(Property))
+	{
+		if (!ULinkProtobufFunctionLibrary::IsByteArrayProperty(Property))
+		{
+			return ELinkProtoValueType::Unsupported;
+		}
+		switch (Field->type())
+		{
+		case FieldDescriptor::TYPE_STRING: return ELinkProtoValueType::Utf8Bytes;
+		case FieldDescriptor::TYPE_BYTES:  return ELinkProtoValueType::ByteArray;
+		default:                           return ELinkProtoValueType::Unsupported;
+		}
+	}
+	return LinkProtoClassifyProperty(Property);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Struct -> Message converters
+// ---------------------------------------------------------------------------------------------------------------------
+
+// Sets or appends one primitive value, through the text round trip when the legacy conversion is enabled.
+// The legacy conversion never knew the 8-bit string types, their text form is not the field value.
+static bool WritePrimitiveToMessage(Message& TargetMsg, const FieldDescriptor* Field, ELinkProtoValueType Type, FProperty* Prop, const void* ValuePtr)
+{
+	if (ULinkProtobufRuntimeSettings::Get()->bUseLegacyTextConversion && !FLinkProtoValueAccess::IsNarrowStringType(Type))
+	{
+		return ULinkProtobufFunctionLibrary::SetFieldValue(&TargetMsg, Field, Prop, ValuePtr);
+	}
+	return FLinkProtoValueAccess::WriteMessageField(TargetMsg, Field, Type, Prop, ValuePtr);
+}
+
+static bool ScalarToMessage(const FLinkProtoFieldPlan& FieldPlan, const void* StructPtr, Message& TargetMsg)
+{
+	if (!WritePrimitiveToMessage(TargetMsg, FieldPlan.Field, FieldPlan.ValueType, FieldPlan.Property, FieldPlan.GetValuePtr(StructPtr)))
+	{
+		UE_LOG(LogProto, Error, TEXT("Proto failed to set field %s"), *FieldPlan.Name);
+		return false;
+	}
+	return true;
+}
+
+static bool StructToMessage(const FLinkProtoFieldPlan& FieldPlan, const void* StructPtr, Message& TargetMsg)
+{
+	const Reflection* reflection = TargetMsg.GetReflection();
+	Message* targetNested = reflection->MutableMessage(&TargetMsg, FieldPlan.Field);
+	if (!targetNested)
+	{
+		UE_LOG(LogProto, Error, TEXT("Proto failed to get mutable nested message for %s"), *FieldPlan.Name);
+		return false;
+	}
+	if (!FieldPlan.SubPlan->WriteToMessage(FieldPlan.GetValuePtr(StructPtr), *targetNested))
+	{
+		UE_LOG(LogProto, Error, TEXT("Proto failed to fill nested message for %s"), *FieldPlan.Name);
+		return false;
+	}
+	return true;
+}
+
+static bool AddRepeatedElement(const FLinkProtoFieldPlan& FieldPlan, const void* ElemPtr, Message& TargetMsg)
+{
+	if (!FieldPlan.SubPlan)
+	{
+		return FLinkProtoValueAccess::WriteMessageField(TargetMsg, FieldPlan.Field, FieldPlan.ValueType, FieldPlan.ElementProperty, ElemPtr);
+	}
+	Message* RepeatedMsg = TargetMsg.GetReflection()->AddMessage(&TargetMsg, FieldPlan.Field);
+	if (!RepeatedMsg)
+	{
+		UE_LOG(LogProto, Error, TEXT("Proto failed add repeated message %s"), *FieldPlan.Name);
+		return false;
+	}
+	if (!FieldPlan.SubPlan->WriteToMessage(ElemPtr, *RepeatedMsg))
+	{
+		UE_LOG(LogProto, Error, TEXT("Proto failed nested repeated fill %s"), *FieldPlan.Name);
+		return false;
+	}
+	return true;
+}
+
+template<typename ElementType>
+static void AppendRepeatedBlock(const FieldDescriptor* Field, FScriptArrayHelper& ArrayHelper, Message& TargetMsg)
+{
+	PRAGMA_DISABLE_DEPRECATION_WARNINGS
+	google::protobuf::RepeatedField<ElementType>* Repeated = TargetMsg.GetReflection()->MutableRepeatedField<ElementType>(&TargetMsg, Field);
+	PRAGMA_ENABLE_DEPRECATION_WARNINGS
+	const ElementType* First = reinterpret_cast<const ElementType*>(ArrayHelper.GetRawPtr(0));
+	Repeated->Add(First, First + ArrayHelper.Num());
+}
+
+// Copies the whole array into the field's RepeatedField, only for plans flagged bBulkRepeatedField
+static void ArrayToRepeatedField(const FLinkProtoFieldPlan& FieldPlan, FScriptArrayHelper& ArrayHelper, Message& TargetMsg)
+{
+	switch (FieldPlan.Field->cpp_type())
+	{
+	case FieldDescriptor::CPPTYPE_INT32:  AppendRepeatedBlock<int32>(FieldPlan.Field, ArrayHelper, TargetMsg); break;
+	case FieldDescriptor::CPPTYPE_INT64:  AppendRepeatedBlock<int64>(FieldPlan.Field, ArrayHelper, TargetMsg); break;
+	case FieldDescriptor::CPPTYPE_UINT32: AppendRepeatedBlock<uint32>(FieldPlan.Field, ArrayHelper, TargetMsg); break;
+	case FieldDescriptor::CPPTYPE_UINT64: AppendRepeatedBlock<uint64>(FieldPlan.Field, ArrayHelper, TargetMsg); break;
+	case FieldDescriptor::CPPTYPE_FLOAT:  AppendRepeatedBlock<float>(FieldPlan.Field, ArrayHelper, TargetMsg); break;
+	case FieldDescriptor::CPPTYPE_DOUBLE: AppendRepeatedBlock<double>(FieldPlan.Field, ArrayHelper, TargetMsg); break;
+	default: checkNoEntry(); break;
+	}
+}
+
+static bool ArrayToMessage(const FLinkProtoFieldPlan& FieldPlan, const void* StructPtr, Message& TargetMsg)
+{
+	FScriptArrayHelper ArrayHelper(CastFieldChecked<FArrayProperty>(FieldPlan.Property), FieldPlan.GetValuePtr(StructPtr));
+	if (FieldPlan.bBulkRepeatedField)
+	{
+		if (ArrayHelper.Num() > 0)
+		{
+			ArrayToRepeatedField(FieldPlan, ArrayHelper, TargetMsg);
+		}
+		return true;
+	}
+	bool bOk = true;
+	for (int32 i = 0; i < ArrayHelper.Num(); ++i)
+	{
+		bOk &= AddRepeatedElement(FieldPlan, ArrayHelper.GetRawPtr(i), TargetMsg);
+	}
+	return bOk;
+}
+
+static bool SetToMessage(const FLinkProtoFieldPlan& FieldPlan, const void* StructPtr, Message& TargetMsg)
+{
+	FScriptSetHelper SetHelper(CastFieldChecked<FSetProperty>(FieldPlan.Property), FieldPlan.GetValuePtr(StructPtr));
+	bool bOk = true;
+	for (int32 i = 0; i < SetHelper.GetMaxIndex(); ++i)
+	{
+		if (!SetHelper.IsValidIndex(i)) continue;
+		bOk &= AddRepeatedElement(FieldPlan, SetHelper.GetElementPtr(i), TargetMsg);
+	}
+	return bOk;
+}
+
+static bool MapToMessage(const FLinkProtoFieldPlan& FieldPlan, const void* StructPtr, Message& TargetMsg)
+{
+	FScriptMapHelper MapHelper(CastFieldChecked<FMapProperty>(FieldPlan.Property), FieldPlan.GetValuePtr(StructPtr));
+	if (MapHelper.Num() == 0)
+	{
+		return true;
+	}
+	if (!ULinkProtobufRuntimeSettings::Get()->bUseLegacyTextConversion)
+	{
+		// Entries go straight to the wire and the message parses them into its map, no entry message per pair.
+		// Partial merge, the fields converted after this one may hold required ones.
+		std::string EntryBytes;
+		if (FLinkProtoWireEncoder::EncodeMapField(FieldPlan, StructPtr, EntryBytes))
+		{
+			const int ExistingEntries = TargetMsg.GetReflection()->FieldSize(TargetMsg, FieldPlan.Field);
+			CodedInputStream Input(reinterpret_cast<const uint8*>(EntryBytes.data()), static_cast<int>(EntryBytes.size()));
+			if (TargetMsg.MergePartialFromCodedStream(&Input) && Input.ConsumedEntireMessage())
+			{
+				return true;
+			}
+			// Drop the entries a failed merge left behind, the fallback below adds them again
+			while (TargetMsg.GetReflection()->FieldSize(TargetMsg, FieldPlan.Field) > ExistingEntries)
+			{
+				TargetMsg.GetReflection()->RemoveLast(&TargetMsg, FieldPlan.Field);
+			}
+		}
+		UE_LOG(LogProto, Warning, TEXT("Proto map %s could not be merged from its encoding, set entry by entry"), *FieldPlan.Name);
+	}
+
+	const Reflection* reflection = TargetMsg.GetReflection();
+	for (int32 idx = 0; idx < MapHelper.GetMaxIndex(); ++idx)
+	{
+		if (!MapHelper.IsValidIndex(idx))
+			continue;
+
+		// Let parent message allocate and hold entry (consistent with its Arena), avoiding manual allocation and ownership issues
+		Message* entryMsg = reflection->AddMessage(&TargetMsg, FieldPlan.Field);
+		const Reflection* entryReflection = entryMsg->GetReflection();
+
+		// Set key
+		if (!WritePrimitiveToMessage(*entryMsg, FieldPlan.KeyField, FieldPlan.ValueType, FieldPlan.ElementProperty, MapHelper.GetKeyPtr(idx)))
+		{
+			UE_LOG(LogProto, Warning, TEXT("Proto map key set failed for %s"), *FieldPlan.Name);
+		}
+
+		// Set value
+		void* ValPtr = MapHelper.GetValuePtr(idx);
+		if (FieldPlan.SubPlan)
+		{
+			Message* nestedValue = entryReflection->MutableMessage(entryMsg, FieldPlan.ValueField);
+			if (!nestedValue)
+			{
+				UE_LOG(LogProto, Error, TEXT("Proto failed to get mutable map value message for %s"), *FieldPlan.Name);
+				continue;
+			}
+			if (!FieldPlan.SubPlan->WriteToMessage(ValPtr, *nestedValue))
+			{
+				UE_LOG(LogProto, Error, TEXT("Proto failed to fill nested map value for %s"), *FieldPlan.Name);
+				entryReflection->ClearField(entryMsg, FieldPlan.ValueField);
+			}
+		}
+		else if (!WritePrimitiveToMessage(*entryMsg, FieldPlan.ValueField, FieldPlan.MapValueType, FieldPlan.ValueProperty, ValPtr))
+		{
+			UE_LOG(LogProto, Warning, TEXT("Proto map value set failed for %s"), *FieldPlan.Name);
+		}
+	}
+	return true;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Message -> Struct converters
+// ---------------------------------------------------------------------------------------------------------------------
+
+// Basic writer of a primitive value from protobuf field to property
+static bool ReadPrimitiveFromMessage(FProperty* Prop, const Message& EntryMsg, void* Dest, const FieldDescriptor* Fd, int Index, bool bRepeated)
+{
+	if (!Prop || !Dest || !Fd)
+	{
+		UE_LOG(LogProto, Error, TEXT("Proto WritePrimitiveToProperty: invalid arguments"));
+		return false;
+	}
+	const Reflection* EntyRef = EntryMsg.GetReflection();
+	if (!EntyRef)
+	{
+		UE_LOG(LogProto, Error, TEXT("Proto WritePrimitiveToProperty: Reflection is nullptr"));
+		return false;
+	}
+	auto EnsureIndex = [&](int Wanted)->bool
+	{
+		if (!bRepeated) return true;
+		int Size = EntyRef->FieldSize(EntryMsg, Fd);
+		if (Wanted < 0 || Wanted >= Size)
+		{
+			UE_LOG(LogProto, Error, TEXT("Proto WritePrimitiveToProperty: index %d out of range %d for field %s"), Wanted, Size, UTF8_TO_TCHAR(Fd->name().c_str()));
+			return false;
+		}
+		return true;
+	};
+	// Returns the value in place, Scratch only holds it when the message does not store it as a plain string
+	auto GetStringLikeValue = [&](std::string& Scratch) -> const std::string*
+	{
+		if (Fd->containing_type() != EntryMsg.GetDescriptor())
+			return nullptr;
+
+		const bool bStringOrBytes =
+			Fd->type() == FieldDescriptor::TYPE_STRING ||
+			Fd->type() == FieldDescriptor::TYPE_BYTES;
+		if (!bStringOrBytes)
+		{
+			UE_LOG(LogProto, Error, TEXT("Proto GetStringLikeValue: Field [%s] is not string/bytes (type=%d)"),
+				UTF8_TO_TCHAR(Fd->name().c_str()), (int)Fd->type());
+			return nullptr;
+		}
+		if (Fd->is_repeated())
+		{
+			if (!EnsureIndex(Index)) return nullptr;
+			return &EntyRef->GetRepeatedStringReference(EntryMsg, Fd, Index, &Scratch);
+		}
+		return &EntyRef->GetStringReference(EntryMsg, Fd, &Scratch);
+	};
+
+	switch (Fd->type())
+	{
+	case FieldDescriptor::TYPE_INT32:
+		if (!EnsureIndex(Index)) return false;
+		if (FIntProperty* IntP = CastField<FIntProperty>(Prop))
+		{
+			int32 V = bRepeated ? EntyRef->GetRepeatedInt32(EntryMsg, Fd, Index) : EntyRef->GetInt32(EntryMsg, Fd);
+			IntP->SetPropertyValue(Dest, V);
+			return true;
+		}
+		break;
+	case FieldDescriptor::TYPE_INT64:
+		if (!EnsureIndex(Index)) return false;
+		if (FInt64Property* Int64P = CastField<FInt64Property>(Prop))
+		{
+			int64 V = bRepeated ? EntyRef->GetRepeatedInt64(EntryMsg, Fd, Index) : EntyRef->GetInt64(EntryMsg, Fd);
+			Int64P->SetPropertyValue(Dest, V);
+			return true;
+		}
+		break;
+	case FieldDescriptor::TYPE_UINT32:
+		if (!EnsureIndex(Index)) return false;
+		if (FUInt32Property* UInt32P = CastField<FUInt32Property>(Prop))
+		{
+			uint32 V = bRepeated ? EntyRef->GetRepeatedUInt32(EntryMsg, Fd, Index) : EntyRef->GetUInt32(EntryMsg, Fd);
+			UInt32P->SetPropertyValue(Dest, V);
+			return true;
+		}
+		if (FIntProperty* IntP2 = CastField<FIntProperty>(Prop))
+		{
+			uint32 V = bRepeated ? EntyRef->GetRepeatedUInt32(EntryMsg, Fd, Index) : EntyRef->GetUInt32(EntryMsg, Fd);
+			IntP2->SetPropertyValue(Dest, static_cast<int32>(V));
+			return true;
+		}
+		break;
+	case FieldDescriptor::TYPE_UINT64:
+		if (!EnsureIndex(Index)) return false;
+		if (FUInt64Property* UInt64P = CastField<FUInt64Property>(Prop))
+		{
+			uint64 V = bRepeated ? EntyRef->GetRepeatedUInt64(EntryMsg, Fd, Index) : EntyRef->GetUInt64(EntryMsg, Fd);
+			UInt64P->SetPropertyValue(Dest, V);
+			return true;
+		}
+		if (FInt64Property* Int64P2 = CastField<FInt64Property>(Prop))
+		{
+			uint64 V = bRepeated ? EntyRef->GetRepeatedUInt64(EntryMsg, Fd, Index) : EntyRef->GetUInt64(EntryMsg, Fd);
+			Int64P2->SetPropertyValue(Dest, static_cast<int64>(V));
+			return true;
+		}
+		break;
+	case FieldDescriptor::TYPE_FLOAT:
+		if (!EnsureIndex(Index)) return false;
+		if (FFloatProperty* FloatP = CastField<FFloatProperty>(Prop))
+		{
+			float V = bRepeated ? EntyRef->GetRepeatedFloat(EntryMsg, Fd, Index) : EntyRef->GetFloat(EntryMsg, Fd);
+			FloatP->SetPropertyValue(Dest, V);
+			return true;
+		}
+		break;
+	case FieldDescriptor::TYPE_DOUBLE:
+		if (!EnsureIndex(Index)) return false;
+		if (FDoubleProperty* DoubleP = CastField<FDoubleProperty>(Prop))
+		{
+			double V = bRepeated ? EntyRef->GetRepeatedDouble(EntryMsg, Fd, Index) : EntyRef->GetDouble(EntryMsg, Fd);
+			DoubleP->SetPropertyValue(Dest, V);
+			return true;
+		}
+		if (FFloatProperty* FloatP = CastField<FFloatProperty>(Prop))
+		{
+			double V = bRepeated ? EntyRef->GetRepeatedDouble(EntryMsg, Fd, Index) : EntyRef->GetDouble(EntryMsg, Fd);
+			FloatP->SetPropertyValue(Dest, V);
+			return true;
+		}
+		break;
+	case FieldDescriptor::TYPE_BOOL:
+		if (!EnsureIndex(Index)) return false;
+		if (FBoolProperty* BoolP = CastField<FBoolProperty>(Prop))
+		{
+			bool V = bRepeated ? EntyRef->GetRepeatedBool(EntryMsg, Fd, Index) : EntyRef->GetBool(EntryMsg, Fd);
+			BoolP->SetPropertyValue(Dest, V);
+			return true;
+		}
+		break;
+	case FieldDescriptor::TYPE_ENUM:
+		if (!EnsureIndex(Index)) return false;
+		{
+			int32 EnumNumber = bRepeated ? EntyRef->GetRepeatedEnumValue(EntryMsg, Fd, Index) : EntyRef->GetEnumValue(EntryMsg, Fd);
+			if (FEnumProperty* EnumProp = CastField<FEnumProperty>(Prop))
+			{
+				if (FProperty* Under = EnumProp->GetUnderlyingProperty())
+				{
+					if (FByteProperty* ByteP = CastField<FByteProperty>(Under))
+					{
+						ByteP->SetPropertyValue(Dest, static_cast<uint8>(EnumNumber));
+						return true;
+					}
+					if (FIntProperty* IntP = CastField<FIntProperty>(Under))
+					{
+						IntP->SetPropertyValue(Dest, EnumNumber);
+						return true;
+					}
+				}
+			}
+		}
+		break;
+	case FieldDescriptor::TYPE_STRING:
+	{
+		std::string Scratch;
+		const std::string* S = GetStringLikeValue(Scratch);
+		if (!S) return false;
+		// Transcoded straight into the property, the parser already validated the UTF-8
+		if (CastField<FStrProperty>(Prop))
+		{
+			FLinkProtoUtf8::Decode(*S, *static_cast<FString*>(Dest));
+			return true;
+		}
+		if (CastField<FNameProperty>(Prop))
+		{
+			FLinkProtoNameCache::Get().Decode(S->data(), static_cast<int32>(S->size()), *static_cast<FName*>(Dest));
+			return true;
+		}
+		if (CastField<FTextProperty>(Prop))
+		{
+			FLinkProtoUtf8::Decode(*S, *static_cast<FText*>(Dest));
+			return true;
+		}
+		// The 8-bit values take the bytes as they are
+		const int32 Len = static_cast<int32>(S->size());
+#if LINKPROTO_WITH_UTF8_STRING_PROPERTIES
+		if (CastField<FUtf8StrProperty>(Prop))
+		{
+			FLinkProtoUtf8::Decode(S->data(), Len, *static_cast<FUtf8String*>(Dest), false);
+			return true;
+		}
+		if (CastField<FAnsiStrProperty>(Prop))
+		{
+			FLinkProtoUtf8::Decode(S->data(), Len, *static_cast<FAnsiString*>(Dest));
+			return true;
+		}
+#endif
+		if (!bRepeated && LinkProtoClassifySingularProperty(Prop, Fd) == ELinkProtoValueType::Utf8Bytes)
+		{
+			FLinkProtoUtf8::Decode(S->data(), Len, *static_cast<TArray<uint8>*>(Dest), false);
+			return true;
+		}
+		break;
+	}
+	case FieldDescriptor::TYPE_BYTES:
+	{
+		std::string Scratch;
+		const std::string* value = GetStringLikeValue(Scratch);
+		if (!value) return false;
+		if (FByteProperty* BP = CastField<FByteProperty>(Prop))
+		{
+			uint8 V = value->empty() ? 0 : static_cast<uint8>((*value)[0]);
+			BP->SetPropertyValue(Dest, V);
+			return true;
+		}
+		if (!bRepeated && LinkProtoClassifySingularProperty(Prop, Fd) == ELinkProtoValueType::ByteArray)
+		{
+			FLinkProtoValueAccess::WriteByteArray(Dest, value->data(), static_cast<int32>(value->size()));
+			return true;
+		}
+		break;
+	}
+	default:
+		UE_LOG(LogProto, Warning, TEXT("Proto WritePrimitiveToProperty: unhandled fd type %d (%s)"), (int)Fd->type(), UTF8_TO_TCHAR(Fd->name().c_str()));
+		return false;
+	}
+	UE_LOG(LogProto, Warning, TEXT("Proto WritePrimitiveToProperty: property type mismatch for field %s -> %s"), UTF8_TO_TCHAR(Fd->name().c_str()), *Prop->GetName());
+	return false;
+}
+
+static bool ScalarFromMessage(const FLinkProtoFieldPlan& FieldPlan, const Message& SourceMsg, void* StructPtr)
+{
+	return ReadPrimitiveFromMessage(FieldPlan.Property, SourceMsg, FieldPlan.GetValuePtr(StructPtr), FieldPlan.Field, 0, false);
+}
+
+static bool StructFromMessage(const FLinkProtoFieldPlan& FieldPlan, const Message& SourceMsg, void* StructPtr)
+{
+	const Message& SubMsg = SourceMsg.GetReflection()->GetMessage(SourceMsg, FieldPlan.Field);
+	return FieldPlan.SubPlan->ReadFromMessage(SubMsg, FieldPlan.GetValuePtr(StructPtr));
+}
+
+static bool ReadRepeatedElement(const FLinkProtoFieldPlan& FieldPlan, const Message& SourceMsg, int32 Index, void* ElemPtr)
+{
+	if (FieldPlan.SubPlan)
+	{
+		const Message& SubMsg = SourceMsg.GetReflection()->GetRepeatedMessage(SourceMsg, FieldPlan.Field, Index);
+		return FieldPlan.SubPlan->ReadFromMessage(SubMsg, ElemPtr);
+	}
+	return ReadPrimitiveFromMessage(FieldPlan.ElementProperty, SourceMsg, ElemPtr, FieldPlan.Field, Index, true);
+}
+
+template<typename ElementType>
+static void AppendArrayBlock(const FieldDescriptor* Field, const Message& SourceMsg, FScriptArrayHelper& ArrayHelper)
+{
+	PRAGMA_DISABLE_DEPRECATION_WARNINGS
+	const google::protobuf::RepeatedField<ElementType>& Repeated = SourceMsg.GetReflection()->GetRepeatedField<ElementType>(SourceMsg, Field);
+	PRAGMA_ENABLE_DEPRECATION_WARNINGS
+	if (Repeated.size() > 0)
+	{
+		const int32 First = ArrayHelper.AddUninitializedValues(Repeated.size());
+		FMemory::Memcpy(ArrayHelper.GetRawPtr(First), Repeated.data(), Repeated.size() * sizeof(ElementType));
+	}
+}
+
+// Appends the field's RepeatedField to the array as one block, only for plans flagged bBulkRepeatedField
+static void ArrayFromRepeatedField(const FLinkProtoFieldPlan& FieldPlan, const Message& SourceMsg, FScriptArrayHelper& ArrayHelper)
+{
+	switch (FieldPlan.Field->cpp_type())
+	{
+	case FieldDescriptor::CPPTYPE_INT32:  AppendArrayBlock<int32>(FieldPlan.Field, SourceMsg, ArrayHelper); break;
+	case FieldDescriptor::CPPTYPE_INT64:  AppendArrayBlock<int64>(FieldPlan.Field, SourceMsg, ArrayHelper); break;
+	case FieldDescriptor::CPPTYPE_UINT32: AppendArrayBlock<uint32>(FieldPlan.Field, SourceMsg, ArrayHelper); break;
+	case FieldDescriptor::CPPTYPE_UINT64: AppendArrayBlock<uint64>(FieldPlan.Field, SourceMsg, ArrayHelper); break;
+	case FieldDescriptor::CPPTYPE_FLOAT:  AppendArrayBlock<float>(FieldPlan.Field, SourceMsg, ArrayHelper); break;
+	case FieldDescriptor::CPPTYPE_DOUBLE: AppendArrayBlock<double>(FieldPlan.Field, SourceMsg, ArrayHelper); break;
+	default: checkNoEntry(); break;
+	}
+}
+
+static bool ArrayFromMessage(const FLinkProtoFieldPlan& FieldPlan, const Message& SourceMsg, void* StructPtr)
+{
+	FScriptArrayHelper ArrayHelper(CastFieldChecked<FArrayProperty>(FieldPlan.Property), FieldPlan.GetValuePtr(StructPtr));
+	if (FieldPlan.bBulkRepeatedField)
+	{
+		ArrayFromRepeatedField(FieldPlan, SourceMsg, ArrayHelper);
+		return true;
+	}
+	int Count = SourceMsg.GetReflection()->FieldSize(SourceMsg, FieldPlan.Field);
+	for (int i = 0; i < Count; ++i)
+	{
+		int32 NewIdx = ArrayHelper.AddValue();
+		ReadRepeatedElement(FieldPlan, SourceMsg, i, ArrayHelper.GetRawPtr(NewIdx));
+	}
+	return true;
+}
+
+static bool SetFromMessage(const FLinkProtoFieldPlan& FieldPlan, const Message& SourceMsg, void* StructPtr)
+{
+	FScriptSetHelper SetHelper(CastFieldChecked<FSetProperty>(FieldPlan.Property), FieldPlan.GetValuePtr(StructPtr));
+	int Count = SourceMsg.GetReflection()->FieldSize(SourceMsg, FieldPlan.Field);
+	if (SetHelper.Num() == 0)
+	{
+		SetHelper.EmptyElements(Count);
+	}
+	if (FieldPlan.SubPlan)
+	{
+		// Struct elements are hashed once decoded
+		for (int i = 0; i < Count; ++i)
+		{
+			int32 NewIdx = SetHelper.AddDefaultValue_Invalid_NeedsRehash();
+			ReadRepeatedElement(FieldPlan, SourceMsg, i, SetHelper.GetElementPtr(NewIdx));
+		}
+		SetHelper.Rehash();
+		return true;
+	}
+	FLinkProtoScalarScratch Element(FieldPlan.ElementProperty);
+	for (int i = 0; i < Count; ++i)
+	{
+		if (!ReadRepeatedElement(FieldPlan, SourceMsg, i, Element.Get()))
+		{
+			// Same default element as an in place read that failed
+			Element.Reset();
+		}
+		SetHelper.AddElement(Element.Get());
+	}
+	return true;
+}
+
+static bool MapFromMessage(const FLinkProtoFieldPlan& FieldPlan, const Message& SourceMsg, void* StructPtr)
+{
+	const Reflection* F_Ref = SourceMsg.GetReflection();
+	FScriptMapHelper MapHelper(CastFieldChecked<FMapProperty>(FieldPlan.Property), FieldPlan.GetValuePtr(StructPtr));
+	int EntryCount = F_Ref->FieldSize(SourceMsg, FieldPlan.Field);
+	if (MapHelper.Num() == 0)
+	{
+		MapHelper.EmptyValues(EntryCount);
+	}
+	// The key is read on the stack and hashed once, the value is then read in place into the slot of the key
+	FLinkProtoScalarScratch Key(FieldPlan.ElementProperty);
+	bool bOk = true;
+	for (int i = 0; i < EntryCount; ++i)
+	{
+		const Message& EntryMsg = F_Ref->GetRepeatedMessage(SourceMsg, FieldPlan.Field, i);
+		if (!ReadPrimitiveFromMessage(FieldPlan.ElementProperty, EntryMsg, Key.Get(), FieldPlan.KeyField, 0, false))
+		{
+			Key.Reset();
+		}
+		void* ValPtr = FLinkProtoValueAccess::FindOrAddMapValue(MapHelper, FieldPlan.ValueProperty, Key.Get());
+		if (FieldPlan.SubPlan)
+		{
+			const Message& NestedVal = EntryMsg.GetReflection()->GetMessage(EntryMsg, FieldPlan.ValueField);
+			bOk &= FieldPlan.SubPlan->ReadFromMessage(NestedVal, ValPtr);
+		}
+		else
+		{
+			ReadPrimitiveFromMessage(FieldPlan.ValueProperty, EntryMsg, ValPtr, FieldPlan.ValueField, 0, false);
+		}
+	}
+	return bOk;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// FLinkProtoStructPlan
+// ---------------------------------------------------------------------------------------------------------------------
+
+const FLinkProtoFieldPlan* FLinkProtoStructPlan::FindSparseFieldByNumber(int32 Number) const
+{
+	const int32 Index = Algo::LowerBoundBy(Fields, Number, [](const FLinkProtoFieldPlan& FieldPlan) { return FieldPlan.Field->number(); });
+	if (Index < Fields.Num() && Fields[Index].Field->number() == Number)
+	{
+		return &Fields[Index];
+	}
+	return nullptr;
+}
+
+bool FLinkProtoStructPlan::WriteToMessage(const void* StructPtr, Message& TargetMsg) const
+{
+	// Dynamic messages of the same descriptor have their own Reflection, only the generated class can be cast
+	if (Generated.ToMessage && TargetMsg.GetReflection() == Prototype->GetReflection())
+	{
+		Generated.ToMessage(StructPtr, TargetMsg);
+		return true;
+	}
+	bool bOk = true;
+	for (const FLinkProtoFieldPlan& FieldPlan : Fields)
+	{
+		bOk &= FieldPlan.ToMessage(FieldPlan, StructPtr, TargetMsg);
+	}
+	return bOk;
+}
+
+bool FLinkProtoStructPlan::ReadFromMessage(const Message& SourceMsg, void* StructPtr) const
+{
+	if (Generated.FromMessage && SourceMsg.GetReflection() == Prototype->GetReflection())
+	{
+		Generated.FromMessage(SourceMsg, StructPtr);
+		return true;
+	}
+	bool bOk = true;
+	for (const FLinkProtoFieldPlan& FieldPlan : Fields)
+	{
+		bOk &= FieldPlan.FromMessage(FieldPlan, SourceMsg, StructPtr);
+	}
+	return bOk;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// FLinkProtoPlanCache
+// ---------------------------------------------------------------------------------------------------------------------
+
+// True when an array of ElemType has the memory layout of the field's RepeatedField
+static bool MatchesRepeatedFieldLayout(const FieldDescriptor* Field, ELinkProtoValueType ElemType)
+{
+	switch (Field->cpp_type())
+	{
+	case FieldDescriptor::CPPTYPE_INT32:  return ElemType == ELinkProtoValueType::Int32;
+	case FieldDescriptor::CPPTYPE_INT64:  return ElemType == ELinkProtoValueType::Int64;
+	case FieldDescriptor::CPPTYPE_UINT32: return ElemType == ELinkProtoValueType::UInt32;
+	case FieldDescriptor::CPPTYPE_UINT64: return ElemType == ELinkProtoValueType::UInt64;
+	case FieldDescriptor::CPPTYPE_FLOAT:  return ElemType == ELinkProtoValueType::Float;
+	case FieldDescriptor::CPPTYPE_DOUBLE: return ElemType == ELinkProtoValueType::Double;
+	default: return false;
+	}
+}
+
+// Element size when an array of ElemType holds exactly the packed payload of the field, 0 otherwise
+static int32 FixedWireElementSize(const FieldDescriptor* Field, ELinkProtoValueType ElemType)
+{
+#if PLATFORM_LITTLE_ENDIAN
+	switch (Field->type())
+	{
+	case FieldDescriptor::TYPE_FLOAT:
+		return ElemType == ELinkProtoValueType::Float ? 4 : 0;
+	case FieldDescriptor::TYPE_DOUBLE:
+		return ElemType == ELinkProtoValueType::Double ? 8 : 0;
+	case FieldDescriptor::TYPE_FIXED32:
+	case FieldDescriptor::TYPE_SFIXED32:
+		return ElemType == ELinkProtoValueType::Int32 || ElemType == ELinkProtoValueType::UInt32 ? 4 : 0;
+	case FieldDescriptor::TYPE_FIXED64:
+	case FieldDescriptor::TYPE_SFIXED64:
+		return ElemType == ELinkProtoValueType::Int64 || ElemType == ELinkProtoValueType::UInt64 ? 8 : 0;
+	default:
+		return 0;
+	}
+#else
+	return 0;
+#endif
+}
+
+FLinkProtoPlanCache& FLinkProtoPlanCache::Get()
+{
+	static FLinkProtoPlanCache Instance;
+	return Instance;
+}
+
+FLinkProtoStructPlanPtr FLinkProtoPlanCache::FindOrBuild(const UScriptStruct* Struct)
+{
+	if (!Struct)
+	{
+		return nullptr;
+	}
+	{
+		FReadScopeLock ReadLock(Lock);
+		if (const TUniquePtr<FLinkProtoStructPlan>* Found = CurrentSet->Plans.Find(Struct))
+		{
+			const FLinkProtoStructPlan* Plan = Found->Get();
+			return Plan->IsValid() ? FLinkProtoStructPlanPtr(CurrentSet, Plan) : nullptr;
+		}
+	}
+
+	FWriteScopeLock WriteLock(Lock);
+	const FLinkProtoStructPlan* Plan = FindOrBuildLocked(*CurrentSet, Struct, nullptr);
+	return Plan->IsValid() ? FLinkProtoStructPlanPtr(CurrentSet, Plan) : nullptr;
+}
+
+FLinkProtoStructPlanPtr FLinkProtoPlanCache::BuildTransient(const UScriptStruct* Struct, const Descriptor* InDescriptor)
+{
+	if (!Struct || !InDescriptor)
+	{
+		return nullptr;
+	}
+	TSharedPtr<FPlanSet, ESPMode::ThreadSafe> TransientSet = MakeShared<FPlanSet, ESPMode::ThreadSafe>();
+	const FLinkProtoStructPlan* Plan = FindOrBuildLocked(*TransientSet, Struct, InDescriptor);
+	return FLinkProtoStructPlanPtr(TransientSet, Plan);
+}
+
+void FLinkProtoPlanCache::Invalidate()
+{
+	FWriteScopeLock WriteLock(Lock);
+	if (CurrentSet->Plans.Num() > 0)
+	{
+		UE_LOG(LogProto, Log, TEXT("Proto conversion plan cache invalidated (%d plans)"), CurrentSet->Plans.Num());
+		// Readers still holding plans keep the old set alive
+		CurrentSet = MakeShared<FPlanSet, ESPMode::ThreadSafe>();
+	}
+}
+
+void FLinkProtoPlanCache::InvalidateIfStale()
+{
+	bool bStale = false;
+	{
+		FReadScopeLock ReadLock(Lock);
+		for (const TPair<const UScriptStruct*, TUniquePtr<FLinkProtoStructPlan>>& Pair : CurrentSet->Plans)
+		{
+			if (!Pair.Value->WeakStruct.IsValid())
+			{
+				bStale = true;
+				break;
+			}
+		}
+	}
+	if (bStale)
+	{
+		Invalidate();
+	}
+}
+
+const FLinkProtoStructPlan* FLinkProtoPlanCache::FindOrBuildLocked(FPlanSet& PlanSet, const UScriptStruct* Struct, const Descriptor* InDescriptor)
+{
+	TUniquePtr<FLinkProtoStructPlan>* Found = PlanSet.Plans.Find(Struct);
+	if (Found && (!InDescriptor || (*Found)->Descriptor == InDescriptor))
+	{
+		return Found->Get();
+	}
+	if (Found)
+	{
+		// Also ends the recursion of self referencing structs bound to the second message type
+		if (TUniquePtr<FLinkProtoStructPlan>* Detached = PlanSet.DetachedPlans.Find(MakeTuple(Struct, InDescriptor)))
+		{
+			return Detached->Get();
+		}
+	}
+	if (!PlanSet.bSchemaResolved)
+	{
+		// Every plan of a set resolves against the same schema, even when a new one is loaded meanwhile
+		PlanSet.Schema = FLinkProtoDescriptorRegistry::Get().GetSchema();
+		PlanSet.bSchemaResolved = true;
+	}
+
+	TUniquePtr<FLinkProtoStructPlan> NewPlan = MakeUnique<FLinkProtoStructPlan>();
+	FLinkProtoStructPlan& Plan = *NewPlan;
+	Plan.Struct = Struct;
+	Plan.WeakStruct = Struct;
+	Plan.StructName = Struct->GetName();
+	Plan.Descriptor = InDescriptor ? InDescriptor : ResolveDescriptor(PlanSet, Struct);
+	Plan.Prototype = Plan.Descriptor ? ResolvePrototype(PlanSet, Plan.Descriptor) : nullptr;
+
+	// Register before building fields so self referencing structs resolve to this plan
+	if (Found)
+	{
+		PlanSet.DetachedPlans.Add(MakeTuple(Struct, InDescriptor), MoveTemp(NewPlan));
+	}
+	else
+	{
+		PlanSet.Plans.Add(Struct, MoveTemp(NewPlan));
+	}
+
+	if (!Plan.Descriptor)
+	{
+		UE_LOG(LogProto, Error, TEXT("Proto Descriptor for %s not found"), *Plan.StructName);
+		return &Plan;
+	}
+	BuildFields(PlanSet, Plan);
+	Plan.Generated = ResolveGeneratedConverter(Plan);
+	UE_LOG(LogProto, Verbose, TEXT("Proto conversion plan built for %s (%d fields)"), *Plan.StructName, Plan.Fields.Num());
+	return &Plan;
+}
+
+void FLinkProtoPlanCache::BuildFields(FPlanSet& PlanSet, FLinkProtoStructPlan& Plan)
+{
+	const Descriptor* MsgDescriptor = Plan.Descriptor;
+	for (TFieldIterator<FProperty> It(Plan.Struct); It; ++It)
+	{
+		FProperty* Property = *It;
+		FLinkProtoFieldPlan FieldPlan;
+		FieldPlan.Property = Property;
+		FieldPlan.Offset = Property->GetOffset_ForInternal();
+		FieldPlan.Name = ULinkProtobufFunctionLibrary::GetPureNameOfProperty(Property);
+		FieldPlan.Field = MsgDescriptor->FindFieldByName(TCHAR_TO_UTF8(*FieldPlan.Name));
+		const FieldDescriptor* Field = FieldPlan.Field;
+		if (!Field)
+		{
+			UE_LOG(LogProto, Warning, TEXT("Proto field %s not found in message %s, skip"), *FieldPlan.Name, UTF8_TO_TCHAR(MsgDescriptor->name().c_str()));
+			continue;
+		}
+		FieldPlan.WireTag = WireFormat::MakeTag(Field);
+		FieldPlan.TagSize = CodedOutputStream::VarintSize32(FieldPlan.WireTag);
+		FieldPlan.bPacked = Field->is_packed();
+		FieldPlan.bImplicitPresence = !Field->has_presence();
+
+		if (Field->is_map())
+		{
+			const FMapProperty* MapProperty = CastField<FMapProperty>(Property);
+			if (!MapProperty)
+			{
+				UE_LOG(LogProto, Warning, TEXT("Proto map field %s is not bound to a TMap, skip"), *FieldPlan.Name);
+				continue;
+			}
+			FieldPlan.Kind = ELinkProtoFieldKind::Map;
+			FieldPlan.ElementProperty = MapProperty->KeyProp;
+			FieldPlan.ValueProperty = MapProperty->ValueProp;
+			FieldPlan.ValueType = LinkProtoClassifyProperty(MapProperty->KeyProp);
+			FieldPlan.MapValueType = LinkProtoClassifyProperty(MapProperty->ValueProp);
+			FieldPlan.KeyField = Field->message_type()->map_key();
+			FieldPlan.ValueField = Field->message_type()->map_value();
+			if (!FieldPlan.KeyField || !FieldPlan.ValueField)
+			{
+				UE_LOG(LogProto, Error, TEXT("Proto invalid map entry descriptor for %s"), *FieldPlan.Name);
+				continue;
+			}
+			if (FieldPlan.ValueField->type() == FieldDescriptor::TYPE_MESSAGE)
+			{
+				const FStructProperty* ValueStructProp = CastField<FStructProperty>(MapProperty->ValueProp);
+				if (!ValueStructProp || !ValueStructProp->Struct)
+				{
+					UE_LOG(LogProto, Error, TEXT("Proto map value inner struct invalid for %s"), *FieldPlan.Name);
+					continue;
+				}
+				FieldPlan.SubPlan = FindOrBuildLocked(PlanSet, ValueStructProp->Struct, FieldPlan.ValueField->message_type());
+			}
+			FieldPlan.ToMessage = &MapToMessage;
+			FieldPlan.FromMessage = &MapFromMessage;
+		}
+		else if (Field->is_repeated())
+		{
+			if (const FArrayProperty* ArrayProp = CastField<FArrayProperty>(Property))
+			{
+				FieldPlan.Kind = ELinkProtoFieldKind::Array;
+				FieldPlan.ElementProperty = ArrayProp->Inner;
+				FieldPlan.ToMessage = &ArrayToMessage;
+				FieldPlan.FromMessage = &ArrayFromMessage;
+			}
+			else if (const FSetProperty* SetProp = CastField<FSetProperty>(Property))
+			{
+				FieldPlan.Kind = ELinkProtoFieldKind::Set;
+				FieldPlan.ElementProperty = SetProp->ElementProp;
+				FieldPlan.ToMessage = &SetToMessage;
+				FieldPlan.FromMessage = &SetFromMessage;
+			}
+			else
+			{
+				UE_LOG(LogProto, Warning, TEXT("Proto repeated field %s is not bound to a TArray or TSet, skip"), *FieldPlan.Name);
+				continue;
+			}
+			FieldPlan.ValueType = LinkProtoClassifyProperty(FieldPlan.ElementProperty);
+			if (Field->type() == FieldDescriptor::TYPE_MESSAGE)
+			{
+				const FStructProperty* ElemStructProp = CastField<FStructProperty>(FieldPlan.ElementProperty);
+				if (!ElemStructProp || !ElemStructProp->Struct)
+				{
+					UE_LOG(LogProto, Error, TEXT("Proto repeated inner struct invalid %s"), *FieldPlan.Name);
+					continue;
+				}
+				FieldPlan.SubPlan = FindOrBuildLocked(PlanSet, ElemStructProp->Struct, Field->message_type());
+			}
+			else if (FieldPlan.Kind == ELinkProtoFieldKind::Array)
+			{
+				FieldPlan.bBulkRepeatedField = MatchesRepeatedFieldLayout(Field, FieldPlan.ValueType);
+				FieldPlan.FixedWireSize = FixedWireElementSize(Field, FieldPlan.ValueType);
+			}
+		}
+		else if (Field->type() == FieldDescriptor::TYPE_MESSAGE)
+		{
+			const FStructProperty* StructProp = CastField<FStructProperty>(Property);
+			if (!StructProp || !StructProp->Struct)
+			{
+				UE_LOG(LogProto, Warning, TEXT("Proto message field %s is not bound to a struct, skip"), *FieldPlan.Name);
+				continue;
+			}
+			FieldPlan.Kind = ELinkProtoFieldKind::Struct;
+			FieldPlan.ValueType = ELinkProtoValueType::Struct;
+			FieldPlan.SubPlan = FindOrBuildLocked(PlanSet, StructProp->Struct, Field->message_type());
+			FieldPlan.ToMessage = &StructToMessage;
+			FieldPlan.FromMessage = &StructFromMessage;
+		}
+		else
+		{
+			FieldPlan.Kind = ELinkProtoFieldKind::Scalar;
+			FieldPlan.ValueType = LinkProtoClassifySingularProperty(Property, Field);
+			FieldPlan.bNonZeroDefault = Field->has_default_value()
+				|| (Field->cpp_type() == FieldDescriptor::CPPTYPE_ENUM && Field->default_value_enum()->number() != 0);
+			FieldPlan.ToMessage = &ScalarToMessage;
+			FieldPlan.FromMessage = &ScalarFromMessage;
+		}
+		Plan.Fields.Add(MoveTemp(FieldPlan));
+	}
+
+	Plan.Fields.Sort([](const FLinkProtoFieldPlan& A, const FLinkProtoFieldPlan& B)
+	{
+		return A.Field->number() < B.Field->number();
+	});
+
+	// Dense lookup for the usual sequential numbering, sparse numbering uses the sorted fields
+	constexpr int32 MaxDenseFieldNumber = 1024;
+	const int32 MaxFieldNumber = Plan.Fields.Num() > 0 ? Plan.Fields.Last().Field->number() : 0;
+	if (MaxFieldNumber <= MaxDenseFieldNumber)
+	{
+		Plan.FieldIndexByNumber.Init(INDEX_NONE, MaxFieldNumber + 1);
+		for (int32 Index = 0; Index < Plan.Fields.Num(); ++Index)
+		{
+			Plan.FieldIndexByNumber[Plan.Fields[Index].Field->number()] = static_cast<int16>(Index);
+		}
+	}
+	for (FLinkProtoFieldPlan& FieldPlan : Plan.Fields)
+	{
+		FieldPlan.WireDecode = FLinkProtoWireDecoder::ResolveFieldDecoder(FieldPlan);
+	}
+}
+
+const Descriptor* FLinkProtoPlanCache::ResolveDescriptor(const FPlanSet& PlanSet, const UScriptStruct* Struct)
+{
+	if (PlanSet.Schema)
+	{
+		std::string protoName = TCHAR_TO_UTF8(*Struct->GetName());
+		if (const Descriptor* RuntimeDescriptor = PlanSet.Schema->FindMessageType(protoName))
+		{
+			return RuntimeDescriptor;
+		}
+	}
+	return FindCompiledDescriptor(Struct);
+}
+
+const Descriptor* FLinkProtoPlanCache::FindCompiledDescriptor(const UScriptStruct* Struct)
+{
+	std::string protoName = TCHAR_TO_UTF8(*Struct->GetName());
+	return DescriptorPool::generated_pool()->FindMessageTypeByName(protoName);
+}
+
+FLinkProtoGeneratedConverter FLinkProtoPlanCache::ResolveGeneratedConverter(const FLinkProtoStructPlan& Plan)
+{
+	const ULinkProtobufRuntimeSettings* Settings = ULinkProtobufRuntimeSettings::Get();
+	// Typed converters are only written for the message compiled from the struct itself
+	if (!Plan.Prototype || Plan.Descriptor != FindCompiledDescriptor(Plan.Struct)
+		|| !Settings->bUseGeneratedConverters || Settings->bUseLegacyTextConversion)
+	{
+		return FLinkProtoGeneratedConverter();
+	}
+	const FLinkProtoGeneratedConverter Converter = FLinkProtoGeneratedRegistry::Get().Find(Plan.Struct);
+	if (Converter.ToMessage)
+	{
+		UE_LOG(LogProto, Verbose, TEXT("Proto conversion plan of %s uses its generated converter"), *Plan.StructName);
+	}
+	return Converter;
+}
+
+const Message* FLinkProtoPlanCache::ResolvePrototype(const FPlanSet& PlanSet, const Descriptor* InDescriptor)
+{
+	if (InDescriptor->file()->pool() == DescriptorPool::generated_pool())
+	{
+		return MessageFactory::generated_factory()->GetPrototype(InDescriptor);
+	}
+	// Null for descriptors of another pool, e.g. of a schema that was replaced since
+	return PlanSet.Schema ? PlanSet.Schema->GetPrototype(InDescriptor) : nullptr;
+}
@@ -0,0 +1,193 @@
+// Copyright DarkestLink-Dev 2025 All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// SPDX-License-Identifier: Apache-2.0
+
+
+#include "LinkProtobufDelimited.h"
+#include "LinkProtobufRuntime.h"
+#include "LinkProtobufStreams.h"
+#include "LinkProtobufWireDecoder.h"
+#include "LinkProtobufWireEncoder.h"
+
+using CodedInputStream     = google::protobuf::io::CodedInputStream;
+using ZeroCopyInputStream  = google::protobuf::io::ZeroCopyInputStream;
+using ZeroCopyOutputStream = google::protobuf::io::ZeroCopyOutputStream;
+
+// Input position after which the reader starts a new CodedInputStream, keeps it clear of the 2GB total bytes limit
+static constexpr int32 InputRecycleThreshold = 64 * 1024 * 1024;
+
+// ---------------------------------------------------------------------------------------------------------------------
+// FLinkProtoDelimitedWriter
+// ---------------------------------------------------------------------------------------------------------------------
+
+FLinkProtoDelimitedWriter::FLinkProtoDelimitedWriter(ZeroCopyOutputStream& Stream)
+	: Output(&Stream)
+{
+}
+
+FLinkProtoDelimitedWriter::FLinkProtoDelimitedWriter(TArray<uint8>& OutBytes)
+	: OwnedStream(MakeUnique<FLinkProtoArrayOutputStream>(OutBytes))
+	, Output(OwnedStream.Get())
+{
+}
+
+FLinkProtoDelimitedWriter::FLinkProtoDelimitedWriter(FArchive& Archive)
+	: OwnedStream(MakeUnique<FLinkProtoArchiveOutputStream>(Archive))
+	, ArchiveStream(static_cast<FLinkProtoArchiveOutputStream*>(OwnedStream.Get()))
+	, Output(OwnedStream.Get())
+{
+}
+
+FLinkProtoDelimitedWriter::~FLinkProtoDelimitedWriter() = default;
+
+bool FLinkProtoDelimitedWriter::Write(const UScriptStruct* StructDefinition, const void* Struct)
+{
+	if (!StructDefinition || !Struct)
+	{
+		UE_LOG(LogProto, Error, TEXT("Proto delimited write: invalid struct inputs"));
+		return false;
+	}
+	if (StructDefinition != LastStruct)
+	{
+		LastPlan = FLinkProtoPlanCache::Get().FindOrBuild(StructDefinition);
+		LastStruct = LastPlan ? StructDefinition : nullptr;
+		if (!LastPlan)
+		{
+			UE_LOG(LogProto, Error, TEXT("Proto delimited write: descriptor not found for %s"), *StructDefinition->GetName());
+			return false;
+		}
+	}
+	return FLinkProtoWireEncoder::EncodeDelimited(*LastPlan, Struct, Output, Scratch);
+}
+
+bool FLinkProtoDelimitedWriter::Flush()
+{
+	Output.Trim();
+	if (ArchiveStream && !ArchiveStream->Flush())
+	{
+		return false;
+	}
+	return !Output.HadError();
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// FLinkProtoDelimitedReader
+// ---------------------------------------------------------------------------------------------------------------------
+
+FLinkProtoDelimitedReader::FLinkProtoDelimitedReader(const UScriptStruct* InStructDefinition, ZeroCopyInputStream& InStream, bool bAllowIncomplete)
+	: Stream(InStream)
+	, StructDefinition(InStructDefinition)
+{
+	Initialize(bAllowIncomplete);
+}
+
+FLinkProtoDelimitedReader::FLinkProtoDelimitedReader(const UScriptStruct* InStructDefinition, TConstArrayView<uint8> Bytes, bool bAllowIncomplete)
+	: OwnedStream(MakeUnique<FLinkProtoBlockInputStream>(Bytes))
+	, Stream(*OwnedStream)
+	, StructDefinition(InStructDefinition)
+{
+	Initialize(bAllowIncomplete);
+}
+
+FLinkProtoDelimitedReader::FLinkProtoDelimitedReader(const UScriptStruct* InStructDefinition, FArchive& Archive, int64 Length, bool bAllowIncomplete)
+	: OwnedStream(MakeUnique<FLinkProtoArchiveInputStream>(Archive, Length))
+	, Stream(*OwnedStream)
+	, StructDefinition(InStructDefinition)
+{
+	Initialize(bAllowIncomplete);
+}
+
+FLinkProtoDelimitedReader::~FLinkProtoDelimitedReader() = default;
+
+void FLinkProtoDelimitedReader::Initialize(bool bAllowIncomplete)
+{
+	Plan = StructDefinition ? FLinkProtoPlanCache::Get().FindOrBuild(StructDefinition) : nullptr;
+	if (!Plan)
+	{
+		UE_LOG(LogProto, Error, TEXT("Proto delimited read: descriptor not found for %s"), StructDefinition ? *StructDefinition->GetName() : TEXT("null struct"));
+		bError = true;
+		return;
+	}
+	// Required fields only exist in proto2, checking them needs the parsed message
+	if (!bAllowIncomplete && Plan->Descriptor->file()->syntax() == google::protobuf::FileDescriptor::SYNTAX_PROTO2)
+	{
+		if (!Plan->Prototype)
+		{
+			UE_LOG(LogProto, Error, TEXT("Proto delimited read: prototype not found for %s"), *Plan->StructName);
+			bError = true;
+			return;
+		}
+		ParsedMessage.Reset(Plan->Prototype->New());
+	}
+	Input = MakeUnique<CodedInputStream>(&Stream);
+}
+
+bool FLinkProtoDelimitedReader::Read(void* OutStruct)
+{
+	if (bError || !OutStruct)
+	{
+		return false;
+	}
+	if (Input->CurrentPosition() > InputRecycleThreshold)
+	{
+		// Destroying the stream hands the bytes it buffered back to Stream
+		Input.Reset();
+		Input = MakeUnique<CodedInputStream>(&Stream);
+	}
+
+	const int Start = Input->CurrentPosition();
+	uint32 Size = 0;
+	if (!Input->ReadVarint32(&Size))
+	{
+		// Nothing left is the clean end of the stream, a partial varint is not
+		bError = Input->CurrentPosition() != Start;
+		if (bError)
+		{
+			UE_LOG(LogProto, Error, TEXT("Proto delimited read: truncated length prefix in %s stream"), *Plan->StructName);
+		}
+		return false;
+	}
+	if (Size > static_cast<uint32>(MAX_int32))
+	{
+		UE_LOG(LogProto, Error, TEXT("Proto delimited read: record of %u bytes in %s stream is too large"), Size, *Plan->StructName);
+		bError = true;
+		return false;
+	}
+
+	const CodedInputStream::Limit Limit = Input->PushLimit(static_cast<int>(Size));
+	bool bRecordOk;
+	FLinkProtoWireDecoder::ResetFields(*Plan, OutStruct);
+	if (ParsedMessage)
+	{
+		ParsedMessage->Clear();
+		bRecordOk = ParsedMessage->MergePartialFromCodedStream(Input.Get())
+			&& Input->ConsumedEntireMessage()
+			&& ParsedMessage->IsInitialized()
+			&& Plan->ReadFromMessage(*ParsedMessage, OutStruct);
+	}
+	else
+	{
+		bRecordOk = FLinkProtoWireDecoder::DecodeFields(*Plan, *Input, OutStruct) && Input->ConsumedEntireMessage();
+	}
+	// A record cut short by the end of the stream ends before its limit
+	bRecordOk = bRecordOk && Input->BytesUntilLimit() == 0;
+	Input->PopLimit(Limit);
+
+	if (!bRecordOk)
+	{
+		UE_LOG(LogProto, Error, TEXT("Proto delimited read: malformed record of %u bytes in %s stream"), Size, *Plan->StructName);
+		bError = true;
+	}
+	return bRecordOk;
+}
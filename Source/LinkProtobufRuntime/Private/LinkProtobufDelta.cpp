@@ -0,0 +1,605 @@
+// Copyright DarkestLink-Dev 2025 All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// SPDX-License-Identifier: Apache-2.0
+
+
+#include "LinkProtobufDelta.h"
+#include "LinkProtobufConversionPlan.h"
+#include "LinkProtobufRuntime.h"
+#include "LinkProtobufUtf8.h"
+#include "LinkProtobufValueAccess.h"
+#include "LinkProtobufWireDecoder.h"
+#include "UObject/StructOnScope.h"
+#include "google/protobuf/descriptor.h"
+#include "google/protobuf/io/coded_stream.h"
+#include "google/protobuf/wire_format_lite.h"
+
+using FieldDescriptor   = google::protobuf::FieldDescriptor;
+using CodedInputStream  = google::protobuf::io::CodedInputStream;
+using CodedOutputStream = google::protobuf::io::CodedOutputStream;
+using WireFormatLite    = google::protobuf::internal::WireFormatLite;
+
+namespace
+{
+	// Default constructed value of a property, what new array elements and container elements are compared against
+	struct FDefaultValue : public FNoncopyable
+	{
+		explicit FDefaultValue(const FProperty* InProperty)
+			: Property(InProperty)
+			, Ptr(FMemory::Malloc(InProperty->GetSize(), InProperty->GetMinAlignment()))
+		{
+			Property->InitializeValue(Ptr);
+		}
+
+		~FDefaultValue()
+		{
+			Property->DestroyValue(Ptr);
+			FMemory::Free(Ptr);
+		}
+
+		const FProperty* Property;
+		void* Ptr;
+	};
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Values
+// ---------------------------------------------------------------------------------------------------------------------
+
+static void AppendVarint(TArray<uint8>& Out, uint64 Value)
+{
+	uint8 Buffer[10];
+	const uint8* End = CodedOutputStream::WriteVarint64ToArray(Value, Buffer);
+	Out.Append(Buffer, static_cast<int32>(End - Buffer));
+}
+
+static void AppendLittleEndian(TArray<uint8>& Out, uint64 Bits, int32 Size)
+{
+	for (int32 Index = 0; Index < Size; ++Index)
+	{
+		Out.Add(static_cast<uint8>(Bits >> (Index * 8)));
+	}
+}
+
+static void AppendTag(TArray<uint8>& Out, int32 Number, WireFormatLite::WireType WireType)
+{
+	AppendVarint(Out, WireFormatLite::MakeTag(Number, WireType));
+}
+
+static void AppendLengthDelimited(TArray<uint8>& Out, TConstArrayView<uint8> Payload)
+{
+	AppendVarint(Out, static_cast<uint64>(Payload.Num()));
+	Out.Append(Payload.GetData(), Payload.Num());
+}
+
+static FORCEINLINE WireFormatLite::WireType ValueWireType(const FieldDescriptor* Field)
+{
+	return WireFormatLite::WireTypeForFieldType(static_cast<WireFormatLite::FieldType>(Field->type()));
+}
+
+// Appends one non-message value without its tag, encoded as the field type would be on the wire
+static bool AppendValue(TArray<uint8>& Out, const FieldDescriptor* Field, ELinkProtoValueType Type, const FProperty* Prop, const void* Ptr)
+{
+	int64 IntValue = 0;
+	double FloatValue = 0;
+	switch (Field->type())
+	{
+	case FieldDescriptor::TYPE_INT32:
+	case FieldDescriptor::TYPE_INT64:
+	case FieldDescriptor::TYPE_UINT32:
+	case FieldDescriptor::TYPE_UINT64:
+	case FieldDescriptor::TYPE_BOOL:
+	case FieldDescriptor::TYPE_ENUM:
+		if (!FLinkProtoValueAccess::ReadInt64(Type, Prop, Ptr, IntValue)) return false;
+		AppendVarint(Out, static_cast<uint64>(IntValue));
+		return true;
+	case FieldDescriptor::TYPE_SINT32:
+	case FieldDescriptor::TYPE_SINT64:
+		if (!FLinkProtoValueAccess::ReadInt64(Type, Prop, Ptr, IntValue)) return false;
+		AppendVarint(Out, WireFormatLite::ZigZagEncode64(IntValue));
+		return true;
+	case FieldDescriptor::TYPE_FIXED32:
+	case FieldDescriptor::TYPE_SFIXED32:
+		if (!FLinkProtoValueAccess::ReadInt64(Type, Prop, Ptr, IntValue)) return false;
+		AppendLittleEndian(Out, static_cast<uint32>(IntValue), 4);
+		return true;
+	case FieldDescriptor::TYPE_FIXED64:
+	case FieldDescriptor::TYPE_SFIXED64:
+		if (!FLinkProtoValueAccess::ReadInt64(Type, Prop, Ptr, IntValue)) return false;
+		AppendLittleEndian(Out, static_cast<uint64>(IntValue), 8);
+		return true;
+	case FieldDescriptor::TYPE_FLOAT:
+		if (!FLinkProtoValueAccess::ReadDouble(Type, Prop, Ptr, FloatValue)) return false;
+		AppendLittleEndian(Out, WireFormatLite::EncodeFloat(static_cast<float>(FloatValue)), 4);
+		return true;
+	case FieldDescriptor::TYPE_DOUBLE:
+		if (!FLinkProtoValueAccess::ReadDouble(Type, Prop, Ptr, FloatValue)) return false;
+		AppendLittleEndian(Out, WireFormatLite::EncodeDouble(FloatValue), 8);
+		return true;
+	case FieldDescriptor::TYPE_STRING:
+	case FieldDescriptor::TYPE_BYTES:
+	{
+		if (Field->type() == FieldDescriptor::TYPE_BYTES && Type == ELinkProtoValueType::UInt8)
+		{
+			AppendVarint(Out, 1);
+			Out.Add(*static_cast<const uint8*>(Ptr));
+			return true;
+		}
+		const ANSICHAR* NarrowChars = nullptr;
+		int32 NarrowNum = 0;
+		if (FLinkProtoValueAccess::ReadNarrowString(Type, Ptr, NarrowChars, NarrowNum))
+		{
+			if (Type == ELinkProtoValueType::AnsiString)
+			{
+				const int32 Length = FLinkProtoUtf8::Latin1EncodedLength(NarrowChars, NarrowNum);
+				AppendVarint(Out, static_cast<uint64>(Length));
+				FLinkProtoUtf8::EncodeLatin1(NarrowChars, NarrowNum, Out.GetData() + Out.AddUninitialized(Length));
+				return true;
+			}
+			AppendVarint(Out, static_cast<uint64>(NarrowNum));
+			Out.Append(reinterpret_cast<const uint8*>(NarrowChars), NarrowNum);
+			return true;
+		}
+		FString Scratch;
+		const FString* Str = FLinkProtoValueAccess::ReadString(Type, Ptr, Scratch);
+		if (!Str) return false;
+		const int32 Length = FLinkProtoUtf8::EncodedLength(**Str, Str->Len());
+		AppendVarint(Out, static_cast<uint64>(Length));
+		FLinkProtoUtf8::Encode(**Str, Str->Len(), Out.GetData() + Out.AddUninitialized(Length));
+		return true;
+	}
+	default:
+		return false;
+	}
+}
+
+static bool ReadLength(CodedInputStream& Input, int32& OutLength)
+{
+	uint32 Length = 0;
+	if (!Input.ReadVarint32(&Length) || Length > static_cast<uint32>(MAX_int32))
+	{
+		return false;
+	}
+	OutLength = static_cast<int32>(Length);
+	return true;
+}
+
+// Reads one value written by AppendValue into the property
+static bool ReadValue(CodedInputStream& Input, const FieldDescriptor* Field, ELinkProtoValueType Type, const FProperty* Prop, void* Ptr)
+{
+	uint64 Bits = 0;
+	uint32 Bits32 = 0;
+	switch (Field->type())
+	{
+	case FieldDescriptor::TYPE_INT32:
+	case FieldDescriptor::TYPE_INT64:
+	case FieldDescriptor::TYPE_UINT32:
+	case FieldDescriptor::TYPE_UINT64:
+	case FieldDescriptor::TYPE_BOOL:
+	case FieldDescriptor::TYPE_ENUM:
+		return Input.ReadVarint64(&Bits) && FLinkProtoValueAccess::WriteInt64(Type, Prop, Ptr, static_cast<int64>(Bits));
+	case FieldDescriptor::TYPE_SINT32:
+	case FieldDescriptor::TYPE_SINT64:
+		return Input.ReadVarint64(&Bits) && FLinkProtoValueAccess::WriteInt64(Type, Prop, Ptr, WireFormatLite::ZigZagDecode64(Bits));
+	case FieldDescriptor::TYPE_FIXED32:
+		return Input.ReadLittleEndian32(&Bits32) && FLinkProtoValueAccess::WriteInt64(Type, Prop, Ptr, Bits32);
+	case FieldDescriptor::TYPE_SFIXED32:
+		return Input.ReadLittleEndian32(&Bits32) && FLinkProtoValueAccess::WriteInt64(Type, Prop, Ptr, static_cast<int32>(Bits32));
+	case FieldDescriptor::TYPE_FIXED64:
+	case FieldDescriptor::TYPE_SFIXED64:
+		return Input.ReadLittleEndian64(&Bits) && FLinkProtoValueAccess::WriteInt64(Type, Prop, Ptr, static_cast<int64>(Bits));
+	case FieldDescriptor::TYPE_FLOAT:
+		return Input.ReadLittleEndian32(&Bits32) && FLinkProtoValueAccess::WriteDouble(Type, Prop, Ptr, WireFormatLite::DecodeFloat(Bits32));
+	case FieldDescriptor::TYPE_DOUBLE:
+		return Input.ReadLittleEndian64(&Bits) && FLinkProtoValueAccess::WriteDouble(Type, Prop, Ptr, WireFormatLite::DecodeDouble(Bits));
+	case FieldDescriptor::TYPE_STRING:
+	case FieldDescriptor::TYPE_BYTES:
+	{
+		int32 Length = 0;
+		std::string Bytes;
+		if (!ReadLength(Input, Length) || !Input.ReadString(&Bytes, Length))
+		{
+			return false;
+		}
+		if (Field->type() == FieldDescriptor::TYPE_BYTES && Type == ELinkProtoValueType::UInt8)
+		{
+			*static_cast<uint8*>(Ptr) = Length > 0 ? static_cast<uint8>(Bytes[0]) : 0;
+			return true;
+		}
+		return FLinkProtoValueAccess::WriteString(Type, Ptr, Bytes.data(), Length);
+	}
+	default:
+		return false;
+	}
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Encode
+// ---------------------------------------------------------------------------------------------------------------------
+
+static bool AppendStructDelta(const FLinkProtoStructPlan& Plan, const void* Current, const void* Baseline, TArray<uint8>& Out);
+
+// Appends a struct delta with its length prefix
+static bool AppendNestedDelta(const FLinkProtoStructPlan& SubPlan, const void* Current, const void* Baseline, TArray<uint8>& Out)
+{
+	TArray<uint8> Nested;
+	if (!AppendStructDelta(SubPlan, Current, Baseline, Nested))
+	{
+		return false;
+	}
+	AppendLengthDelimited(Out, Nested);
+	return true;
+}
+
+static bool AppendArrayDelta(const FLinkProtoFieldPlan& FieldPlan, const void* Current, const void* Baseline, TArray<uint8>& Out)
+{
+	const FArrayProperty* ArrayProp = CastFieldChecked<FArrayProperty>(FieldPlan.Property);
+	FScriptArrayHelper CurrentHelper(ArrayProp, Current);
+	FScriptArrayHelper BaselineHelper(ArrayProp, Baseline);
+	const int32 Num = CurrentHelper.Num();
+	const int32 BaselineNum = BaselineHelper.Num();
+
+	AppendVarint(Out, static_cast<uint64>(Num));
+	TUniquePtr<FDefaultValue> DefaultElement;
+	for (int32 Index = 0; Index < Num; ++Index)
+	{
+		const void* Element = CurrentHelper.GetRawPtr(Index);
+		const void* BaselineElement = nullptr;
+		if (Index < BaselineNum)
+		{
+			BaselineElement = BaselineHelper.GetRawPtr(Index);
+		}
+		else
+		{
+			if (!DefaultElement)
+			{
+				DefaultElement = MakeUnique<FDefaultValue>(ArrayProp->Inner);
+			}
+			BaselineElement = DefaultElement->Ptr;
+		}
+		if (ArrayProp->Inner->Identical(Element, BaselineElement, PPF_None))
+		{
+			continue;
+		}
+
+		AppendVarint(Out, static_cast<uint64>(Index));
+		const bool bOk = FieldPlan.SubPlan
+			? AppendNestedDelta(*FieldPlan.SubPlan, Element, BaselineElement, Out)
+			: AppendValue(Out, FieldPlan.Field, FieldPlan.ValueType, ArrayProp->Inner, Element);
+		if (!bOk)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+static bool AppendSet(const FLinkProtoFieldPlan& FieldPlan, const void* Current, TArray<uint8>& Out)
+{
+	FScriptSetHelper SetHelper(CastFieldChecked<FSetProperty>(FieldPlan.Property), Current);
+	AppendVarint(Out, static_cast<uint64>(SetHelper.Num()));
+	TUniquePtr<FDefaultValue> DefaultElement;
+	if (FieldPlan.SubPlan)
+	{
+		DefaultElement = MakeUnique<FDefaultValue>(FieldPlan.ElementProperty);
+	}
+	for (int32 Index = 0; Index < SetHelper.GetMaxIndex(); ++Index)
+	{
+		if (!SetHelper.IsValidIndex(Index)) continue;
+		const void* Element = SetHelper.GetElementPtr(Index);
+		const bool bOk = FieldPlan.SubPlan
+			? AppendNestedDelta(*FieldPlan.SubPlan, Element, DefaultElement->Ptr, Out)
+			: AppendValue(Out, FieldPlan.Field, FieldPlan.ValueType, FieldPlan.ElementProperty, Element);
+		if (!bOk)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+static bool AppendMap(const FLinkProtoFieldPlan& FieldPlan, const void* Current, TArray<uint8>& Out)
+{
+	FScriptMapHelper MapHelper(CastFieldChecked<FMapProperty>(FieldPlan.Property), Current);
+	AppendVarint(Out, static_cast<uint64>(MapHelper.Num()));
+	TUniquePtr<FDefaultValue> DefaultValue;
+	if (FieldPlan.SubPlan)
+	{
+		DefaultValue = MakeUnique<FDefaultValue>(FieldPlan.ValueProperty);
+	}
+	for (int32 Index = 0; Index < MapHelper.GetMaxIndex(); ++Index)
+	{
+		if (!MapHelper.IsValidIndex(Index)) continue;
+		if (!AppendValue(Out, FieldPlan.KeyField, FieldPlan.ValueType, FieldPlan.ElementProperty, MapHelper.GetKeyPtr(Index)))
+		{
+			return false;
+		}
+		const void* Value = MapHelper.GetValuePtr(Index);
+		const bool bOk = FieldPlan.SubPlan
+			? AppendNestedDelta(*FieldPlan.SubPlan, Value, DefaultValue->Ptr, Out)
+			: AppendValue(Out, FieldPlan.ValueField, FieldPlan.MapValueType, FieldPlan.ValueProperty, Value);
+		if (!bOk)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+static bool AppendStructDelta(const FLinkProtoStructPlan& Plan, const void* Current, const void* Baseline, TArray<uint8>& Out)
+{
+	for (const FLinkProtoFieldPlan& FieldPlan : Plan.Fields)
+	{
+		const void* Value = FieldPlan.GetValuePtr(Current);
+		const void* BaselineValue = FieldPlan.GetValuePtr(Baseline);
+		if (FieldPlan.Property->Identical(Value, BaselineValue, PPF_None))
+		{
+			continue;
+		}
+
+		const int32 Number = FieldPlan.Field->number();
+		if (FieldPlan.Kind == ELinkProtoFieldKind::Scalar)
+		{
+			AppendTag(Out, Number, ValueWireType(FieldPlan.Field));
+			if (!AppendValue(Out, FieldPlan.Field, FieldPlan.ValueType, FieldPlan.Property, Value))
+			{
+				UE_LOG(LogProto, Error, TEXT("Proto delta: failed to write field %s"), *FieldPlan.Name);
+				return false;
+			}
+			continue;
+		}
+
+		TArray<uint8> Payload;
+		bool bOk = true;
+		switch (FieldPlan.Kind)
+		{
+		case ELinkProtoFieldKind::Struct: bOk = AppendStructDelta(*FieldPlan.SubPlan, Value, BaselineValue, Payload); break;
+		case ELinkProtoFieldKind::Array:  bOk = AppendArrayDelta(FieldPlan, Value, BaselineValue, Payload); break;
+		case ELinkProtoFieldKind::Set:    bOk = AppendSet(FieldPlan, Value, Payload); break;
+		case ELinkProtoFieldKind::Map:    bOk = AppendMap(FieldPlan, Value, Payload); break;
+		default: break;
+		}
+		if (!bOk)
+		{
+			UE_LOG(LogProto, Error, TEXT("Proto delta: failed to write field %s"), *FieldPlan.Name);
+			return false;
+		}
+		// Only properties the plan does not bind changed inside the struct
+		if (FieldPlan.Kind == ELinkProtoFieldKind::Struct && Payload.Num() == 0)
+		{
+			continue;
+		}
+		AppendTag(Out, Number, WireFormatLite::WIRETYPE_LENGTH_DELIMITED);
+		AppendLengthDelimited(Out, Payload);
+	}
+	return true;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Apply
+// ---------------------------------------------------------------------------------------------------------------------
+
+static bool ApplyStructDelta(const FLinkProtoStructPlan& Plan, CodedInputStream& Input, void* StructPtr);
+
+// Runs Read over the length delimited payload that follows
+template<typename ReadFuncType>
+static bool ReadLengthDelimited(CodedInputStream& Input, ReadFuncType&& Read)
+{
+	int32 Length = 0;
+	if (!ReadLength(Input, Length))
+	{
+		return false;
+	}
+	const std::pair<CodedInputStream::Limit, int> LimitAndDepth = Input.IncrementRecursionDepthAndPushLimit(Length);
+	if (LimitAndDepth.second < 0 || !Read())
+	{
+		return false;
+	}
+	return Input.BytesUntilLimit() == 0 && Input.DecrementRecursionDepthAndPopLimit(LimitAndDepth.first);
+}
+
+static bool ApplyNestedDelta(const FLinkProtoStructPlan& SubPlan, CodedInputStream& Input, void* StructPtr)
+{
+	return ReadLengthDelimited(Input, [&]() { return ApplyStructDelta(SubPlan, Input, StructPtr); });
+}
+
+static bool ApplyArrayDelta(const FLinkProtoFieldPlan& FieldPlan, CodedInputStream& Input, void* ValuePtr)
+{
+	const FArrayProperty* ArrayProp = CastFieldChecked<FArrayProperty>(FieldPlan.Property);
+	FScriptArrayHelper ArrayHelper(ArrayProp, ValuePtr);
+	uint32 Num = 0;
+	if (!Input.ReadVarint32(&Num) || Num > static_cast<uint32>(MAX_int32))
+	{
+		return false;
+	}
+	// Written elements take a byte at least, only default ones can grow the array past the payload
+	const int64 Growth = static_cast<int64>(Num) - ArrayHelper.Num();
+	if (Growth > FMath::Max<int64>(FLinkProtoDelta::MaxArrayGrowth, Input.BytesUntilLimit()))
+	{
+		return false;
+	}
+	ArrayHelper.Resize(static_cast<int32>(Num));
+	while (Input.BytesUntilLimit() > 0)
+	{
+		uint32 Index = 0;
+		if (!Input.ReadVarint32(&Index) || Index >= Num)
+		{
+			return false;
+		}
+		void* Element = ArrayHelper.GetRawPtr(static_cast<int32>(Index));
+		const bool bOk = FieldPlan.SubPlan
+			? ApplyNestedDelta(*FieldPlan.SubPlan, Input, Element)
+			: ReadValue(Input, FieldPlan.Field, FieldPlan.ValueType, ArrayProp->Inner, Element);
+		if (!bOk)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+static bool ApplySet(const FLinkProtoFieldPlan& FieldPlan, CodedInputStream& Input, void* ValuePtr)
+{
+	FScriptSetHelper SetHelper(CastFieldChecked<FSetProperty>(FieldPlan.Property), ValuePtr);
+	uint32 Num = 0;
+	// Every element takes a byte at least, the count is checked against the payload before anything is allocated
+	if (!Input.ReadVarint32(&Num) || Num > static_cast<uint32>(Input.BytesUntilLimit()))
+	{
+		return false;
+	}
+	SetHelper.EmptyElements();
+	bool bOk = true;
+	for (uint32 Count = 0; Count < Num && bOk; ++Count)
+	{
+		void* Element = SetHelper.GetElementPtr(SetHelper.AddDefaultValue_Invalid_NeedsRehash());
+		bOk = FieldPlan.SubPlan
+			? ApplyNestedDelta(*FieldPlan.SubPlan, Input, Element)
+			: ReadValue(Input, FieldPlan.Field, FieldPlan.ValueType, FieldPlan.ElementProperty, Element);
+	}
+	SetHelper.Rehash();
+	return bOk;
+}
+
+static bool ApplyMap(const FLinkProtoFieldPlan& FieldPlan, CodedInputStream& Input, void* ValuePtr)
+{
+	FScriptMapHelper MapHelper(CastFieldChecked<FMapProperty>(FieldPlan.Property), ValuePtr);
+	uint32 Num = 0;
+	// Every element takes a byte at least, the count is checked against the payload before anything is allocated
+	if (!Input.ReadVarint32(&Num) || Num > static_cast<uint32>(Input.BytesUntilLimit()))
+	{
+		return false;
+	}
+	MapHelper.EmptyValues();
+	bool bOk = true;
+	for (uint32 Count = 0; Count < Num && bOk; ++Count)
+	{
+		const int32 NewIndex = MapHelper.AddDefaultValue_Invalid_NeedsRehash();
+		bOk = ReadValue(Input, FieldPlan.KeyField, FieldPlan.ValueType, FieldPlan.ElementProperty, MapHelper.GetKeyPtr(NewIndex));
+		if (bOk)
+		{
+			void* Value = MapHelper.GetValuePtr(NewIndex);
+			bOk = FieldPlan.SubPlan
+				? ApplyNestedDelta(*FieldPlan.SubPlan, Input, Value)
+				: ReadValue(Input, FieldPlan.ValueField, FieldPlan.MapValueType, FieldPlan.ValueProperty, Value);
+		}
+	}
+	MapHelper.Rehash();
+	return bOk;
+}
+
+static bool ApplyStructDelta(const FLinkProtoStructPlan& Plan, CodedInputStream& Input, void* StructPtr)
+{
+	while (const uint32 Tag = Input.ReadTag())
+	{
+		const FLinkProtoFieldPlan* FieldPlan = Plan.FindFieldByNumber(WireFormatLite::GetTagFieldNumber(Tag));
+		const WireFormatLite::WireType WireType = WireFormatLite::GetTagWireType(Tag);
+		const bool bExpected = FieldPlan && WireType == (FieldPlan->Kind == ELinkProtoFieldKind::Scalar
+			? ValueWireType(FieldPlan->Field) : WireFormatLite::WIRETYPE_LENGTH_DELIMITED);
+		if (!bExpected)
+		{
+			// Fields of a newer schema, or unbound on this side
+			if (!WireFormatLite::SkipField(&Input, Tag))
+			{
+				return false;
+			}
+			continue;
+		}
+
+		void* ValuePtr = FieldPlan->GetValuePtr(StructPtr);
+		bool bOk = false;
+		switch (FieldPlan->Kind)
+		{
+		case ELinkProtoFieldKind::Scalar:
+			bOk = ReadValue(Input, FieldPlan->Field, FieldPlan->ValueType, FieldPlan->Property, ValuePtr);
+			break;
+		case ELinkProtoFieldKind::Struct:
+			bOk = ApplyNestedDelta(*FieldPlan->SubPlan, Input, ValuePtr);
+			break;
+		case ELinkProtoFieldKind::Array:
+			bOk = ReadLengthDelimited(Input, [&]() { return ApplyArrayDelta(*FieldPlan, Input, ValuePtr); });
+			break;
+		case ELinkProtoFieldKind::Set:
+			bOk = ReadLengthDelimited(Input, [&]() { return ApplySet(*FieldPlan, Input, ValuePtr); });
+			break;
+		case ELinkProtoFieldKind::Map:
+			bOk = ReadLengthDelimited(Input, [&]() { return ApplyMap(*FieldPlan, Input, ValuePtr); });
+			break;
+		}
+		if (!bOk)
+		{
+			UE_LOG(LogProto, Error, TEXT("Proto delta: failed to apply field %s of %s"), *FieldPlan->Name, *Plan.StructName);
+			return false;
+		}
+	}
+	return true;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// FLinkProtoDelta
+// ---------------------------------------------------------------------------------------------------------------------
+
+bool FLinkProtoDelta::EncodeDelta(const UScriptStruct* StructDefinition, const void* Current, const void* Baseline, TArray<uint8>& OutDelta)
+{
+	if (!StructDefinition || !Current || !Baseline)
+	{
+		UE_LOG(LogProto, Error, TEXT("Proto delta: invalid struct"));
+		return false;
+	}
+	const FLinkProtoStructPlanPtr Plan = FLinkProtoPlanCache::Get().FindOrBuild(StructDefinition);
+	if (!Plan)
+	{
+		return false;
+	}
+	OutDelta.Reset();
+	return AppendStructDelta(*Plan, Current, Baseline, OutDelta);
+}
+
+bool FLinkProtoDelta::EncodeDelta(const UScriptStruct* StructDefinition, const void* Current, TConstArrayView<uint8> BaselineBytes, TArray<uint8>& OutDelta)
+{
+	if (!StructDefinition || !Current)
+	{
+		UE_LOG(LogProto, Error, TEXT("Proto delta: invalid struct"));
+		return false;
+	}
+	const FLinkProtoStructPlanPtr Plan = FLinkProtoPlanCache::Get().FindOrBuild(StructDefinition);
+	if (!Plan)
+	{
+		return false;
+	}
+
+	FStructOnScope Baseline(StructDefinition);
+	if (!FLinkProtoWireDecoder::Decode(*Plan, BaselineBytes, Baseline.GetStructMemory()))
+	{
+		UE_LOG(LogProto, Error, TEXT("Proto delta: failed to decode the baseline of %s"), *Plan->StructName);
+		return false;
+	}
+	OutDelta.Reset();
+	return AppendStructDelta(*Plan, Current, Baseline.GetStructMemory(), OutDelta);
+}
+
+bool FLinkProtoDelta::ApplyDelta(const UScriptStruct* StructDefinition, TConstArrayView<uint8> Delta, void* InOutStruct)
+{
+	if (!StructDefinition || !InOutStruct)
+	{
+		UE_LOG(LogProto, Error, TEXT("Proto delta: invalid struct"));
+		return false;
+	}
+	const FLinkProtoStructPlanPtr Plan = FLinkProtoPlanCache::Get().FindOrBuild(StructDefinition);
+	if (!Plan)
+	{
+		return false;
+	}
+	CodedInputStream Input(Delta.GetData(), Delta.Num());
+	return ApplyStructDelta(*Plan, Input, InOutStruct) && Input.ConsumedEntireMessage();
+}
@@ -0,0 +1,212 @@
+// Copyright DarkestLink-Dev 2025 All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// SPDX-License-Identifier: Apache-2.0
+
+
+#include "LinkProtobufDescriptorRegistry.h"
+#include "LinkProtobufConversionPlan.h"
+#include "LinkProtobufRuntime.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "google/protobuf/descriptor.h"
+#include "google/protobuf/descriptor.pb.h"
+#include "google/protobuf/descriptor_database.h"
+#include "google/protobuf/dynamic_message.h"
+
+using Descriptor               = google::protobuf::Descriptor;
+using DescriptorPool           = google::protobuf::DescriptorPool;
+using DescriptorPoolDatabase   = google::protobuf::DescriptorPoolDatabase;
+using DescriptorProto          = google::protobuf::DescriptorProto;
+using DynamicMessageFactory    = google::protobuf::DynamicMessageFactory;
+using FileDescriptorProto      = google::protobuf::FileDescriptorProto;
+using FileDescriptorSet        = google::protobuf::FileDescriptorSet;
+using MergedDescriptorDatabase = google::protobuf::MergedDescriptorDatabase;
+using Message                  = google::protobuf::Message;
+using SimpleDescriptorDatabase = google::protobuf::SimpleDescriptorDatabase;
+
+// Descriptors are built lazily, so schema errors only show up when a type is first looked up
+class FLinkProtoDescriptorSchema::FErrorCollector : public DescriptorPool::ErrorCollector
+{
+public:
+	virtual void AddError(const std::string& Filename, const std::string& ElementName, const Message*, ErrorLocation, const std::string& ErrorMessage) override
+	{
+		UE_LOG(LogProto, Error, TEXT("Proto runtime schema: %s (%s): %s"), UTF8_TO_TCHAR(Filename.c_str()), UTF8_TO_TCHAR(ElementName.c_str()), UTF8_TO_TCHAR(ErrorMessage.c_str()));
+	}
+
+	virtual void AddWarning(const std::string& Filename, const std::string& ElementName, const Message*, ErrorLocation, const std::string& WarningMessage) override
+	{
+		UE_LOG(LogProto, Warning, TEXT("Proto runtime schema: %s (%s): %s"), UTF8_TO_TCHAR(Filename.c_str()), UTF8_TO_TCHAR(ElementName.c_str()), UTF8_TO_TCHAR(WarningMessage.c_str()));
+	}
+};
+
+// ---------------------------------------------------------------------------------------------------------------------
+// FLinkProtoDescriptorSchema
+// ---------------------------------------------------------------------------------------------------------------------
+
+FLinkProtoDescriptorSchema::FLinkProtoDescriptorSchema()
+	: LoadedFiles(MakeUnique<SimpleDescriptorDatabase>())
+	, CompiledFiles(MakeUnique<DescriptorPoolDatabase>(*DescriptorPool::generated_pool()))
+	, Database(MakeUnique<MergedDescriptorDatabase>(LoadedFiles.Get(), CompiledFiles.Get()))
+	, ErrorCollector(MakeUnique<FErrorCollector>())
+	, Pool(MakeUnique<DescriptorPool>(Database.Get(), ErrorCollector.Get()))
+	, Factory(MakeUnique<DynamicMessageFactory>(Pool.Get()))
+{
+}
+
+FLinkProtoDescriptorSchema::~FLinkProtoDescriptorSchema()
+{
+	// Prototypes and descriptors go before the databases they were built from
+	Factory.Reset();
+	Pool.Reset();
+}
+
+const Descriptor* FLinkProtoDescriptorSchema::FindMessageType(const std::string& FullName) const
+{
+	// Checked first so lookups of compiled types do not copy their files into this pool
+	if (!MessageTypes.Contains(UTF8_TO_TCHAR(FullName.c_str())))
+	{
+		return nullptr;
+	}
+	return Pool->FindMessageTypeByName(FullName);
+}
+
+const Message* FLinkProtoDescriptorSchema::GetPrototype(const Descriptor* InDescriptor) const
+{
+	return OwnsDescriptor(InDescriptor) ? Factory->GetPrototype(InDescriptor) : nullptr;
+}
+
+bool FLinkProtoDescriptorSchema::OwnsDescriptor(const Descriptor* InDescriptor) const
+{
+	return InDescriptor && InDescriptor->file()->pool() == Pool.Get();
+}
+
+static void CollectMessageTypes(const FString& Scope, const DescriptorProto& Type, TSet<FString>& OutTypes)
+{
+	const FString FullName = Scope + UTF8_TO_TCHAR(Type.name().c_str());
+	OutTypes.Add(FullName);
+	for (const DescriptorProto& Nested : Type.nested_type())
+	{
+		CollectMessageTypes(FullName + TEXT("."), Nested, OutTypes);
+	}
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// FLinkProtoDescriptorRegistry
+// ---------------------------------------------------------------------------------------------------------------------
+
+FLinkProtoDescriptorRegistry& FLinkProtoDescriptorRegistry::Get()
+{
+	static FLinkProtoDescriptorRegistry Instance;
+	return Instance;
+}
+
+bool FLinkProtoDescriptorRegistry::LoadDescriptorSet(TConstArrayView<uint8> SerializedSet, const FString& SourceName)
+{
+	FileDescriptorSet Set;
+	if (!Set.ParseFromArray(SerializedSet.GetData(), SerializedSet.Num()))
+	{
+		UE_LOG(LogProto, Error, TEXT("Proto runtime schema: %s is not a serialized FileDescriptorSet"), *SourceName);
+		return false;
+	}
+
+	{
+		FWriteScopeLock WriteLock(Lock);
+		TMap<FString, std::string> NewFiles = Files;
+		for (const FileDescriptorProto& File : Set.file())
+		{
+			NewFiles.Add(UTF8_TO_TCHAR(File.name().c_str()), File.SerializeAsString());
+		}
+
+		// Built from scratch so a replaced file cannot leave stale types behind
+		TSharedPtr<FLinkProtoDescriptorSchema, ESPMode::ThreadSafe> NewSchema = MakeShareable(new FLinkProtoDescriptorSchema());
+		for (const TPair<FString, std::string>& Pair : NewFiles)
+		{
+			FileDescriptorProto File;
+			File.ParseFromString(Pair.Value);
+			if (!NewSchema->LoadedFiles->Add(File))
+			{
+				UE_LOG(LogProto, Error, TEXT("Proto runtime schema: %s conflicts with the other loaded files (from %s)"), *Pair.Key, *SourceName);
+				return false;
+			}
+			const FString Scope = File.package().empty() ? FString() : FString(UTF8_TO_TCHAR(File.package().c_str())) + TEXT(".");
+			for (const DescriptorProto& Type : File.message_type())
+			{
+				CollectMessageTypes(Scope, Type, NewSchema->MessageTypes);
+			}
+		}
+		NewSchema->FileCount = NewFiles.Num();
+
+		Files = MoveTemp(NewFiles);
+		Schema = NewSchema;
+	}
+
+	UE_LOG(LogProto, Log, TEXT("Proto runtime schema: loaded %d files from %s"), Set.file_size(), *SourceName);
+	FLinkProtoPlanCache::Get().Invalidate();
+	return true;
+}
+
+bool FLinkProtoDescriptorRegistry::LoadDescriptorSetFile(const FString& FilePath)
+{
+	const FString FullPath = FPaths::IsRelative(FilePath) ? FPaths::Combine(FPaths::ProjectContentDir(), FilePath) : FilePath;
+	TArray<uint8> Bytes;
+	if (!FFileHelper::LoadFileToArray(Bytes, *FullPath))
+	{
+		UE_LOG(LogProto, Error, TEXT("Proto runtime schema: failed to read %s"), *FullPath);
+		return false;
+	}
+	return LoadDescriptorSet(Bytes, FullPath);
+}
+
+void FLinkProtoDescriptorRegistry::Reset()
+{
+	{
+		FWriteScopeLock WriteLock(Lock);
+		if (!Schema)
+		{
+			return;
+		}
+		Files.Reset();
+		Schema.Reset();
+	}
+	UE_LOG(LogProto, Log, TEXT("Proto runtime schema: unloaded"));
+	FLinkProtoPlanCache::Get().Invalidate();
+}
+
+FLinkProtoDescriptorSchemaPtr FLinkProtoDescriptorRegistry::GetSchema() const
+{
+	FReadScopeLock ReadLock(Lock);
+	return Schema;
+}
+
+static FAutoConsoleCommand LinkProtoLoadDescriptorSetCommand(
+	TEXT("LinkProto.LoadDescriptorSet"),
+	TEXT("Loads a serialized FileDescriptorSet and swaps the runtime schema. Usage: LinkProto.LoadDescriptorSet <Path relative to Content>"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		if (Args.Num() != 1)
+		{
+			UE_LOG(LogProto, Display, TEXT("Usage: LinkProto.LoadDescriptorSet <Path relative to Content>"));
+			return;
+		}
+		FLinkProtoDescriptorRegistry::Get().LoadDescriptorSetFile(Args[0]);
+	}));
+
+static FAutoConsoleCommand LinkProtoResetDescriptorSetsCommand(
+	TEXT("LinkProto.ResetDescriptorSets"),
+	TEXT("Unloads every runtime loaded schema."),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		FLinkProtoDescriptorRegistry::Get().Reset();
+	}));
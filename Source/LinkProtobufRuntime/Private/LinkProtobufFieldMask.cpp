@@ -0,0 +1,363 @@
+// Copyright DarkestLink-Dev 2025 All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// SPDX-License-Identifier: Apache-2.0
+
+
+#include "LinkProtobufFieldMask.h"
+#include "LinkProtobufRuntime.h"
+#include "LinkProtobufWireDecoder.h"
+#include "Misc/ScopeExit.h"
+#include "google/protobuf/field_mask.pb.h"
+#include "google/protobuf/io/coded_stream.h"
+#include "google/protobuf/wire_format_lite.h"
+
+using Message          = google::protobuf::Message;
+using Reflection       = google::protobuf::Reflection;
+using CodedInputStream = google::protobuf::io::CodedInputStream;
+using WireFormatLite   = google::protobuf::internal::WireFormatLite;
+
+// Bound field of the plan named by a path segment, proto field names take precedence over property names
+static const FLinkProtoFieldPlan* FindFieldBySegment(const FLinkProtoStructPlan& Plan, const FString& Segment)
+{
+	const FTCHARToUTF8 Utf8(*Segment, Segment.Len());
+	const std::string FieldName(Utf8.Get(), Utf8.Length());
+	for (const FLinkProtoFieldPlan& FieldPlan : Plan.Fields)
+	{
+		if (FieldPlan.Field->name() == FieldName)
+		{
+			return &FieldPlan;
+		}
+	}
+	for (const FLinkProtoFieldPlan& FieldPlan : Plan.Fields)
+	{
+		if (FieldPlan.Name == Segment)
+		{
+			return &FieldPlan;
+		}
+	}
+	return nullptr;
+}
+
+static TArray<FString> GetMaskPaths(const google::protobuf::FieldMask& Mask)
+{
+	TArray<FString> Paths;
+	Paths.Reserve(Mask.paths_size());
+	for (const std::string& Path : Mask.paths())
+	{
+		const FUTF8ToTCHAR Converted(Path.data(), static_cast<int32>(Path.size()));
+		Paths.Emplace(Converted.Length(), Converted.Get());
+	}
+	return Paths;
+}
+
+static FLinkProtoStructPlanPtr FindStructPlan(const UScriptStruct* Struct)
+{
+	if (!Struct)
+	{
+		UE_LOG(LogProto, Error, TEXT("Proto field mask: invalid struct"));
+		return nullptr;
+	}
+	FLinkProtoStructPlanPtr StructPlan = FLinkProtoPlanCache::Get().FindOrBuild(Struct);
+	if (!StructPlan)
+	{
+		UE_LOG(LogProto, Error, TEXT("Proto field mask: no message bound to %s"), *Struct->GetName());
+	}
+	return StructPlan;
+}
+
+bool FLinkProtoFieldMask::Compile(const UScriptStruct* Struct, TConstArrayView<FString> Paths)
+{
+	return Compile(FindStructPlan(Struct), Paths);
+}
+
+bool FLinkProtoFieldMask::Compile(const UScriptStruct* Struct, const google::protobuf::FieldMask& Mask)
+{
+	return Compile(FindStructPlan(Struct), GetMaskPaths(Mask));
+}
+
+bool FLinkProtoFieldMask::Compile(FLinkProtoStructPlanPtr InPlan, const google::protobuf::FieldMask& Mask)
+{
+	return Compile(MoveTemp(InPlan), GetMaskPaths(Mask));
+}
+
+bool FLinkProtoFieldMask::Compile(FLinkProtoStructPlanPtr InPlan, TConstArrayView<FString> Paths)
+{
+	Plan.Reset();
+	Nodes.Reset();
+	if (!InPlan || !InPlan->IsValid())
+	{
+		UE_LOG(LogProto, Error, TEXT("Proto field mask: invalid plan"));
+		return false;
+	}
+
+	Plan = MoveTemp(InPlan);
+	Nodes.AddDefaulted_GetRef().Plan = Plan.Get();
+	for (const FString& Path : Paths)
+	{
+		if (!AddPath(Path))
+		{
+			Plan.Reset();
+			Nodes.Reset();
+			return false;
+		}
+	}
+	for (FNode& Node : Nodes)
+	{
+		Node.Entries.Sort([](const FEntry& A, const FEntry& B) { return A.FieldPlan->Field->number() < B.FieldPlan->Field->number(); });
+	}
+	return true;
+}
+
+bool FLinkProtoFieldMask::AddPath(const FString& Path)
+{
+	TArray<FString> Segments;
+	Path.ParseIntoArray(Segments, TEXT("."), false);
+	if (Segments.Num() == 0)
+	{
+		UE_LOG(LogProto, Error, TEXT("Proto field mask: empty path for %s"), *Plan->StructName);
+		return false;
+	}
+
+	int32 NodeIndex = 0;
+	for (int32 SegmentIndex = 0; SegmentIndex < Segments.Num(); ++SegmentIndex)
+	{
+		const FLinkProtoStructPlan& NodePlan = *Nodes[NodeIndex].Plan;
+		const FLinkProtoFieldPlan* FieldPlan = FindFieldBySegment(NodePlan, Segments[SegmentIndex]);
+		if (!FieldPlan)
+		{
+			UE_LOG(LogProto, Error, TEXT("Proto field mask: %s has no bound field %s (path %s)"), *NodePlan.StructName, *Segments[SegmentIndex], *Path);
+			return false;
+		}
+
+		const bool bLast = SegmentIndex == Segments.Num() - 1;
+		if (!bLast && FieldPlan->Kind != ELinkProtoFieldKind::Struct)
+		{
+			UE_LOG(LogProto, Error, TEXT("Proto field mask: %s is not a singular struct field (path %s)"), *FieldPlan->Name, *Path);
+			return false;
+		}
+
+		FEntry* Entry = Nodes[NodeIndex].Entries.FindByPredicate([FieldPlan](const FEntry& Existing) { return Existing.FieldPlan == FieldPlan; });
+		if (Entry && Entry->ChildNode == INDEX_NONE)
+		{
+			// Already selected as a whole
+			return true;
+		}
+		if (bLast)
+		{
+			if (Entry)
+			{
+				Entry->ChildNode = INDEX_NONE;
+			}
+			else
+			{
+				Nodes[NodeIndex].Entries.Add({ FieldPlan, INDEX_NONE });
+			}
+			return true;
+		}
+		if (!Entry)
+		{
+			const int32 ChildNode = Nodes.Num();
+			Nodes.AddDefaulted_GetRef().Plan = FieldPlan->SubPlan;
+			Nodes[NodeIndex].Entries.Add({ FieldPlan, ChildNode });
+			NodeIndex = ChildNode;
+		}
+		else
+		{
+			NodeIndex = Entry->ChildNode;
+		}
+	}
+	return true;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Message conversion
+// ---------------------------------------------------------------------------------------------------------------------
+
+bool FLinkProtoFieldMask::WriteToMessage(const void* StructPtr, Message& TargetMsg) const
+{
+	if (!IsValid() || !StructPtr)
+	{
+		UE_LOG(LogProto, Error, TEXT("Proto field mask: invalid mask or struct"));
+		return false;
+	}
+	if (TargetMsg.GetDescriptor() != Plan->Descriptor)
+	{
+		UE_LOG(LogProto, Error, TEXT("Proto field mask: mask of %s does not match message %s"), *Plan->StructName, UTF8_TO_TCHAR(TargetMsg.GetDescriptor()->full_name().c_str()));
+		return false;
+	}
+	return WriteNode(0, StructPtr, TargetMsg);
+}
+
+bool FLinkProtoFieldMask::WriteNode(int32 NodeIndex, const void* StructPtr, Message& TargetMsg) const
+{
+	const Reflection* Refl = TargetMsg.GetReflection();
+	bool bOk = true;
+	for (const FEntry& Entry : Nodes[NodeIndex].Entries)
+	{
+		const FLinkProtoFieldPlan& FieldPlan = *Entry.FieldPlan;
+		if (Entry.ChildNode != INDEX_NONE)
+		{
+			bOk &= WriteNode(Entry.ChildNode, FieldPlan.GetValuePtr(StructPtr), *Refl->MutableMessage(&TargetMsg, FieldPlan.Field));
+			continue;
+		}
+		// Field converters add to repeated fields and merge into nested messages
+		Refl->ClearField(&TargetMsg, FieldPlan.Field);
+		bOk &= FieldPlan.ToMessage(FieldPlan, StructPtr, TargetMsg);
+	}
+	return bOk;
+}
+
+bool FLinkProtoFieldMask::ReadFromMessage(const Message& SourceMsg, void* StructPtr) const
+{
+	if (!IsValid() || !StructPtr)
+	{
+		UE_LOG(LogProto, Error, TEXT("Proto field mask: invalid mask or struct"));
+		return false;
+	}
+	if (SourceMsg.GetDescriptor() != Plan->Descriptor)
+	{
+		UE_LOG(LogProto, Error, TEXT("Proto field mask: mask of %s does not match message %s"), *Plan->StructName, UTF8_TO_TCHAR(SourceMsg.GetDescriptor()->full_name().c_str()));
+		return false;
+	}
+	// Containers are appended to by the field converters
+	ResetNode(0, StructPtr);
+	return ReadNode(0, SourceMsg, StructPtr);
+}
+
+bool FLinkProtoFieldMask::ReadNode(int32 NodeIndex, const Message& SourceMsg, void* StructPtr) const
+{
+	const Reflection* Refl = SourceMsg.GetReflection();
+	bool bOk = true;
+	for (const FEntry& Entry : Nodes[NodeIndex].Entries)
+	{
+		const FLinkProtoFieldPlan& FieldPlan = *Entry.FieldPlan;
+		bOk &= Entry.ChildNode != INDEX_NONE
+			? ReadNode(Entry.ChildNode, Refl->GetMessage(SourceMsg, FieldPlan.Field), FieldPlan.GetValuePtr(StructPtr))
+			: FieldPlan.FromMessage(FieldPlan, SourceMsg, StructPtr);
+	}
+	return bOk;
+}
+
+void FLinkProtoFieldMask::ResetNode(int32 NodeIndex, void* StructPtr) const
+{
+	for (const FEntry& Entry : Nodes[NodeIndex].Entries)
+	{
+		const FLinkProtoFieldPlan& FieldPlan = *Entry.FieldPlan;
+		void* ValuePtr = FieldPlan.GetValuePtr(StructPtr);
+		if (Entry.ChildNode != INDEX_NONE)
+		{
+			ResetNode(Entry.ChildNode, ValuePtr);
+		}
+		else if (FieldPlan.Kind == ELinkProtoFieldKind::Struct)
+		{
+			FLinkProtoWireDecoder::ResetFields(*FieldPlan.SubPlan, ValuePtr);
+		}
+		else
+		{
+			FieldPlan.Property->ClearValue(ValuePtr);
+		}
+	}
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Wire decode
+// ---------------------------------------------------------------------------------------------------------------------
+
+bool FLinkProtoFieldMask::Decode(TConstArrayView<uint8> Data, void* StructPtr) const
+{
+	if (!IsValid() || !StructPtr)
+	{
+		UE_LOG(LogProto, Error, TEXT("Proto field mask: invalid mask or struct"));
+		return false;
+	}
+
+	ResetNode(0, StructPtr);
+	CodedInputStream Input(Data.GetData(), Data.Num());
+	if (!DecodeNode(0, Input, StructPtr))
+	{
+		return false;
+	}
+	if (!Input.ConsumedEntireMessage())
+	{
+		UE_LOG(LogProto, Error, TEXT("Proto field mask: invalid tag in %s"), *Plan->StructName);
+		return false;
+	}
+	return true;
+}
+
+bool FLinkProtoFieldMask::DecodeNode(int32 NodeIndex, CodedInputStream& Input, void* StructPtr) const
+{
+	const FNode& Node = Nodes[NodeIndex];
+
+	// Sets of structs are filled without hashing, same as in FLinkProtoWireDecoder::DecodeFields
+	TArray<const FLinkProtoFieldPlan*, TInlineAllocator<4>> PendingRehash;
+	ON_SCOPE_EXIT
+	{
+		for (const FLinkProtoFieldPlan* FieldPlan : PendingRehash)
+		{
+			FScriptSetHelper(static_cast<const FSetProperty*>(FieldPlan->Property), FieldPlan->GetValuePtr(StructPtr)).Rehash();
+		}
+	};
+
+	for (uint32 Tag = Input.ReadTag(); Tag != 0; Tag = Input.ReadTag())
+	{
+		const FLinkProtoFieldPlan* FieldPlan = Node.Plan->FindFieldByNumber(WireFormatLite::GetTagFieldNumber(Tag));
+		// Masks hold a handful of fields, a scan beats any lookup structure
+		const FEntry* Entry = FieldPlan ? Node.Entries.FindByPredicate([FieldPlan](const FEntry& Candidate) { return Candidate.FieldPlan == FieldPlan; }) : nullptr;
+		if (Entry && Entry->ChildNode == INDEX_NONE && FLinkProtoWireDecoder::AcceptsTag(*FieldPlan, Tag))
+		{
+			if (FieldPlan->Kind == ELinkProtoFieldKind::Set && FieldPlan->SubPlan)
+			{
+				PendingRehash.AddUnique(FieldPlan);
+			}
+			if (!FieldPlan->WireDecode(*FieldPlan, Input, Tag, StructPtr, ELinkProtoUnknownFieldPolicy::Skip))
+			{
+				UE_LOG(LogProto, Error, TEXT("Proto field mask: malformed field %s in %s"), *FieldPlan->Name, *Node.Plan->StructName);
+				return false;
+			}
+			continue;
+		}
+		if (Entry && Tag == FieldPlan->WireTag)
+		{
+			uint32 Length = 0;
+			if (!Input.ReadVarint32(&Length) || Length > static_cast<uint32>(MAX_int32))
+			{
+				return false;
+			}
+			const std::pair<CodedInputStream::Limit, int> LimitAndDepth = Input.IncrementRecursionDepthAndPushLimit(static_cast<int32>(Length));
+			if (LimitAndDepth.second < 0)
+			{
+				UE_LOG(LogProto, Error, TEXT("Proto field mask: recursion limit exceeded in %s"), *FieldPlan->SubPlan->StructName);
+				return false;
+			}
+			if (!DecodeNode(Entry->ChildNode, Input, FieldPlan->GetValuePtr(StructPtr)) || !Input.DecrementRecursionDepthAndPopLimit(LimitAndDepth.first))
+			{
+				return false;
+			}
+			continue;
+		}
+
+		if (WireFormatLite::GetTagWireType(Tag) == WireFormatLite::WIRETYPE_END_GROUP)
+		{
+			UE_LOG(LogProto, Error, TEXT("Proto field mask: unexpected end group tag in %s"), *Node.Plan->StructName);
+			return false;
+		}
+		if (!WireFormatLite::SkipField(&Input, Tag))
+		{
+			UE_LOG(LogProto, Error, TEXT("Proto field mask: malformed field in %s"), *Node.Plan->StructName);
+			return false;
+		}
+	}
+	return true;
+}
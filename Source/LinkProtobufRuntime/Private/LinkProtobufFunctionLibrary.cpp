@@ -14,6 +14,13 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include "LinkProtobufFunctionLibrary.h"
+#include "LinkProtobufArena.h"
+#include "LinkProtobufCompat.h"
+#include "LinkProtobufConversionPlan.h"
+#include "LinkProtobufRuntimeSettings.h"
+#include "LinkProtobufValueAccess.h"
+#include "LinkProtobufWireDecoder.h"
+#include "LinkProtobufWireEncoder.h"
 #include "google/protobuf/descriptor.h"
 #include <google/protobuf/message.h>
 #include <google/protobuf/dynamic_message.h>
@@ -144,8 +151,8 @@ DEFINE_FUNCTION(ULinkProtobufFunctionLibrary::execStructToBinaryProtoBytes)
 bool ULinkProtobufFunctionLibrary::ConvertStructToBinaryProtoBytes(const UStruct* StructDefinition, const void* Struct, TArray<uint8>& OutProtoBinaryBytes)
 {
     return ConvertStructToProtoInternal(StructDefinition, Struct,
-        [&](google::protobuf::Message* message, const FString& StructName) -> bool {
-            return SerializeMessageToBinaryBytes(message, OutProtoBinaryBytes, StructName);
+        [&](const FLinkProtoStructPlan& Plan, const FString& StructName) -> bool {
+            return FLinkProtoWireEncoder::Encode(Plan, Struct, OutProtoBinaryBytes);
         }
     );
 }
@@ -153,44 +160,74 @@ bool ULinkProtobufFunctionLibrary::ConvertStructToBinaryProtoBytes(const UStruct
 bool ULinkProtobufFunctionLibrary::ConvertStructToBinaryProtoString(const UStruct* StructDefinition, const void* Struct, std::string& OutProtoBinaryString)
 {
     return ConvertStructToProtoInternal(StructDefinition, Struct,
-        [&](google::protobuf::Message* message, const FString& StructName) -> bool {
-            return SerializeMessageToBinaryString(message, OutProtoBinaryString, StructName);
+        [&](const FLinkProtoStructPlan& Plan, const FString& StructName) -> bool {
+            return FLinkProtoWireEncoder::Encode(Plan, Struct, OutProtoBinaryString);
         }
     );
 }
+bool ULinkProtobufFunctionLibrary::ConvertStructToBinaryProtoBytes(const UStruct* StructDefinition, const void* Struct, google::protobuf::io::ZeroCopyOutputStream& Output)
+{
+    return ConvertStructToProtoInternal(StructDefinition, Struct,
+        [&](const FLinkProtoStructPlan& Plan, const FString& StructName) -> bool {
+            return FLinkProtoWireEncoder::Encode(Plan, Struct, Output);
+        }
+    );
+}
+
+bool ULinkProtobufFunctionLibrary::ComputeEncodedSize(const UScriptStruct* StructDefinition, const void* Struct, uint64& OutSize, TArray<FLinkProtoFieldSize>* OutFieldSizes)
+{
+    if (!StructDefinition || !Struct)
+    {
+        UE_LOG(LogProto, Error, TEXT("Proto ComputeEncodedSize: invalid inputs"));
+        return false;
+    }
+    // Meant to run every tick, so no per call logging unlike the encode entry points
+    const FLinkProtoStructPlanPtr Plan = FLinkProtoPlanCache::Get().FindOrBuild(StructDefinition);
+    if (!Plan)
+    {
+        UE_LOG(LogProto, Error, TEXT("Proto Descriptor for %s not found"), *StructDefinition->GetName());
+        return false;
+    }
+    OutSize = FLinkProtoWireEncoder::ComputeEncodedSize(*Plan, Struct, OutFieldSizes);
+    return true;
+}
+
 template<typename SerializeFunc>
 bool ULinkProtobufFunctionLibrary::ConvertStructToProtoInternal(const UStruct* StructDefinition, const void* Struct, SerializeFunc&& Serialize)
 {
 	FString StructName = StructDefinition->GetName();
 	UE_LOG(LogProto, Log, TEXT("Proto Converting struct: %s"), *StructName);
 
-	std::string protoName = TCHAR_TO_UTF8(*StructName);
-	const Descriptor* descriptor = DescriptorPool::generated_pool()->FindMessageTypeByName(protoName);
-	if (!descriptor)
-	{
-		UE_LOG(LogProto, Error, TEXT("Proto Descriptor for %s not found"), *StructName);
-		return false;
-	}
-	const Message* prototype = MessageFactory::generated_factory()->GetPrototype(descriptor);
-	if (!prototype)
+	const UScriptStruct* ScriptStruct = Cast<UScriptStruct>(StructDefinition);
+	if (!ScriptStruct)
 	{
-		UE_LOG(LogProto, Error, TEXT("Proto Prototype for %s not found"), *StructName);
+		UE_LOG(LogProto, Error, TEXT("Proto ConvertStructToProtoInternal: StructDefinition is not UScriptStruct for %s"), *StructName);
 		return false;
 	}
-	Message* message = prototype->New();
-	UScriptStruct* ScriptStruct = Cast<UScriptStruct>(const_cast<UStruct*>(StructDefinition));
-	if (!ScriptStruct)
+	FLinkProtoStructPlanPtr Plan = FLinkProtoPlanCache::Get().FindOrBuild(ScriptStruct);
+	if (!Plan)
 	{
-		UE_LOG(LogProto, Error, TEXT("Proto ConvertStructToProtoInternal: StructDefinition is not UScriptStruct for %s"), *StructName);
+		UE_LOG(LogProto, Error, TEXT("Proto Descriptor for %s not found"), *StructName);
 		return false;
 	}
-	if (!DeserializeStructToMessage(ScriptStruct, Struct, *message, nullptr))
+	// The plan is encoded straight to the wire format, no Message is built
+	if (!Serialize(*Plan, StructName))
 	{
-		UE_LOG(LogProto, Error, TEXT("Proto DeserializeStructToMessage failed for %s"), *StructName);
+		UE_LOG(LogProto, Error, TEXT("Proto serialization failed for %s"), *StructName);
 		return false;
 	}
-	// Call the provided serialization function
-	return Serialize(message, StructName);
+	return true;
+}
+
+// Plan of the struct for the message's descriptor, cached when the message is the one bound to the struct
+static FLinkProtoStructPlanPtr FindPlanForMessage(const UScriptStruct* StructDefinition, const google::protobuf::Message& Msg)
+{
+    FLinkProtoStructPlanPtr Plan = FLinkProtoPlanCache::Get().FindOrBuild(StructDefinition);
+    if (!Plan || Plan->Descriptor != Msg.GetDescriptor())
+    {
+        Plan = FLinkProtoPlanCache::Get().BuildTransient(StructDefinition, Msg.GetDescriptor());
+    }
+    return Plan;
 }
 
 bool ULinkProtobufFunctionLibrary::DeserializeStructToMessage(UScriptStruct* StructDefinition, const void* Struct,google::protobuf::Message& TargetMsg,google::protobuf::FieldDescriptor*)
@@ -209,238 +246,37 @@ bool ULinkProtobufFunctionLibrary::DeserializeStructToMessage(UScriptStruct* Str
         return false;
     }
 
-    for (TFieldIterator<FProperty> It(StructDefinition); It; ++It)
-    {
-        FProperty* Property = *It;
-    	FString PropertyName = GetPureNameOfProperty(Property);
-        const void* ContainerPtr = Property->ContainerPtrToValuePtr<void>(Struct);
+    return FindPlanForMessage(StructDefinition, TargetMsg)->WriteToMessage(Struct, TargetMsg);
+}
 
-        std::string FieldName = TCHAR_TO_UTF8(*PropertyName);
-        const FieldDescriptor* ItField = descriptor->FindFieldByName(FieldName);
-        if (!ItField)
-        {
-            UE_LOG(LogProto, Warning, TEXT("Proto DeserializeStructToMessage: field %s not found, skip"), *PropertyName);
-            continue;
-        }
-        // Repeated field handling
-        if (ItField->is_repeated() && !ItField->is_map())
-        {
-            auto AddPrimitiveRepeatedElement = [&](const FProperty* ElemProp, const void* ElemPtr)
-            {
-                switch (ItField->type())
-                {
-                case FieldDescriptor::TYPE_INT32:
-                    if (CastField<FIntProperty>(ElemProp) || CastField<FEnumProperty>(ElemProp))
-                        reflection->AddInt32(&TargetMsg, ItField, *reinterpret_cast<const int32*>(ElemPtr));
-                    return;
-                case FieldDescriptor::TYPE_INT64:
-                    if (CastField<FInt64Property>(ElemProp)) reflection->AddInt64(&TargetMsg, ItField, *reinterpret_cast<const int64*>(ElemPtr)); return;
-                case FieldDescriptor::TYPE_UINT32:
-                    if (CastField<FUInt32Property>(ElemProp)) reflection->AddUInt32(&TargetMsg, ItField, *reinterpret_cast<const uint32*>(ElemPtr));
-                    else if (CastField<FIntProperty>(ElemProp)) reflection->AddUInt32(&TargetMsg, ItField, static_cast<uint32>(*reinterpret_cast<const int32*>(ElemPtr))); return;
-                case FieldDescriptor::TYPE_UINT64:
-                    if (CastField<FUInt64Property>(ElemProp)) reflection->AddUInt64(&TargetMsg, ItField, *reinterpret_cast<const uint64*>(ElemPtr)); return;
-                case FieldDescriptor::TYPE_FLOAT:
-                    if (CastField<FFloatProperty>(ElemProp)) reflection->AddFloat(&TargetMsg, ItField, *reinterpret_cast<const float*>(ElemPtr)); return;
-                case FieldDescriptor::TYPE_DOUBLE:
-                    if (CastField<FDoubleProperty>(ElemProp)) reflection->AddDouble(&TargetMsg, ItField, *reinterpret_cast<const double*>(ElemPtr));
-                    else if (CastField<FFloatProperty>(ElemProp)) reflection->AddDouble(&TargetMsg, ItField, (double)*reinterpret_cast<const float*>(ElemPtr)); return;
-                case FieldDescriptor::TYPE_BOOL:
-                    if (CastField<FBoolProperty>(ElemProp)) reflection->AddBool(&TargetMsg, ItField, *reinterpret_cast<const bool*>(ElemPtr));
-                    return;
-                case FieldDescriptor::TYPE_ENUM:
-                    if (ItField->enum_type())
-                    {
-                        int32 EnumNumber = 0;
-                        if (const FEnumProperty* EP = CastField<FEnumProperty>(ElemProp))
-                        {
-                            FProperty* Under = EP->GetUnderlyingProperty();
-                            if (CastField<FByteProperty>(Under)) EnumNumber = *reinterpret_cast<const uint8*>(ElemPtr);
-                            else if (CastField<FIntProperty>(Under)) EnumNumber = *reinterpret_cast<const int32*>(ElemPtr);
-                        }
-                        else if (CastField<FByteProperty>(ElemProp))
-                        {
-                            EnumNumber = *reinterpret_cast<const uint8*>(ElemPtr);
-                        }
-                        else if (CastField<FIntProperty>(ElemProp))
-                        {
-                            EnumNumber = *reinterpret_cast<const int32*>(ElemPtr);
-                        }
-                        if (const EnumValueDescriptor* EVD = ItField->enum_type()->FindValueByNumber(EnumNumber))
-                        {
-                            reflection->AddEnum(&TargetMsg, ItField, EVD);
-                        }
-                    }
-                    return;
-                case FieldDescriptor::TYPE_STRING:
-                    if (CastField<FStrProperty>(ElemProp))
-                        reflection->AddString(&TargetMsg, ItField, TCHAR_TO_UTF8(**reinterpret_cast<const FString*>(ElemPtr)));
-                    else if (CastField<FNameProperty>(ElemProp))
-                        reflection->AddString(&TargetMsg, ItField, TCHAR_TO_UTF8(*reinterpret_cast<const FName*>(ElemPtr)->ToString()));
-                    else if (CastField<FTextProperty>(ElemProp))
-                        reflection->AddString(&TargetMsg, ItField, TCHAR_TO_UTF8(*reinterpret_cast<const FText*>(ElemPtr)->ToString()));
-                    return;
-                case FieldDescriptor::TYPE_BYTES:
-                	if (CastField<FByteProperty>(ElemProp))
-                	{
-                		uint8 V = *reinterpret_cast<const uint8*>(ElemPtr);
-                		std::string bytes(reinterpret_cast<const char*>(&V), 1);
-                		reflection->AddString(&TargetMsg, ItField, bytes);
-                		return;
-                	}
-                default: return;
-                }
-            };
-
-            // TArray handling
-            if (const FArrayProperty* ArrayProp = CastField<FArrayProperty>(Property))
-            {
-                FScriptArrayHelper ArrayHelper(ArrayProp, ContainerPtr);
-                for (int32 i = 0; i < ArrayHelper.Num(); ++i)
-                {
-                    void* ElemPtr = ArrayHelper.GetRawPtr(i);
-                    if (ItField->type() == FieldDescriptor::TYPE_MESSAGE)
-                    {
-                        if (const FStructProperty* InnerStructProp = CastField<FStructProperty>(ArrayProp->Inner))
-                        {
-                            const UScriptStruct* InnerStruct = InnerStructProp->Struct;
-                            if (!InnerStruct) { UE_LOG(LogProto, Error, TEXT("Proto repeated array inner struct invalid %s"), *PropertyName); continue; }
-                            Message* RepeatedMsg = reflection->AddMessage(&TargetMsg, ItField);
-                            if (!RepeatedMsg) { UE_LOG(LogProto, Error, TEXT("Proto failed add repeated message %s"), *PropertyName); continue; }
-                            if (!DeserializeStructToMessage(const_cast<UScriptStruct*>(InnerStruct), ElemPtr, *RepeatedMsg, const_cast<FieldDescriptor*>(ItField)))
-                            {
-                                UE_LOG(LogProto, Error, TEXT("Proto failed nested repeated fill %s"), *PropertyName);
-                            }
-                        }
-                    }
-                    else
-                    {
-                        AddPrimitiveRepeatedElement(ArrayProp->Inner, ElemPtr);
-                    }
-                }
-                continue;
-            }
-            // TSet handling
-            if (const FSetProperty* SetProp = CastField<FSetProperty>(Property))
-            {
-                FScriptSetHelper SetHelper(SetProp, ContainerPtr);
-                for (int32 i = 0; i < SetHelper.Num(); ++i)
-                {
-                    if (!SetHelper.IsValidIndex(i)) continue;
-                    void* ElemPtr = SetHelper.GetElementPtr(i);
-                    if (ItField->type() == FieldDescriptor::TYPE_MESSAGE)
-                    {
-                        if (const FStructProperty* ElementStructProp = CastField<FStructProperty>(SetProp->ElementProp))
-                        {
-                            const UScriptStruct* InnerStruct = ElementStructProp->Struct;
-                            if (!InnerStruct) { UE_LOG(LogProto, Error, TEXT("Proto repeated set inner struct invalid %s"), *PropertyName); continue; }
-                            Message* RepeatedMsg = reflection->AddMessage(&TargetMsg, ItField);
-                            if (!RepeatedMsg) { UE_LOG(LogProto, Error, TEXT("Proto failed add repeated message %s"), *PropertyName); continue; }
-                            if (!DeserializeStructToMessage(const_cast<UScriptStruct*>(InnerStruct), ElemPtr, *RepeatedMsg, const_cast<FieldDescriptor*>(ItField)))
-                            {
-                                UE_LOG(LogProto, Error, TEXT("Proto failed nested repeated fill %s"), *PropertyName);
-                            }
-                        }
-                    }
-                    else
-                    {
-                        AddPrimitiveRepeatedElement(SetProp->ElementProp, ElemPtr);
-                    }
-                }
-                continue;
-            }
-            // If repeated but property not an array/set we let generic path try
-        }
-        // Map type handling
-        if (ItField->is_map())
-        {
-            if (const FMapProperty* MapProperty = CastField<FMapProperty>(Property))
-            {
-                FScriptMapHelper MapHelper(MapProperty, ContainerPtr);
-
-                const Descriptor* entryDesc = ItField->message_type();
-                const FieldDescriptor* keyFd = entryDesc->FindFieldByName("key");
-                const FieldDescriptor* valFd = entryDesc->FindFieldByName("value");
-                if (!keyFd || !valFd)
-                {
-                    UE_LOG(LogProto, Error, TEXT("Proto DeserializeStructToMessage: invalid map entry descriptor for %s"), *PropertyName);
-                    continue;
-                }
-
-                for (int32 idx = 0; idx < MapHelper.Num(); ++idx)
-                {
-                    if (!MapHelper.IsValidIndex(idx))
-                        continue;
-
-                    // Let parent message allocate and hold entry (consistent with its Arena), avoiding manual allocation and ownership issues
-                    Message* entryMsg = reflection->AddMessage(&TargetMsg, ItField);
-                    const Reflection* entryReflection = entryMsg->GetReflection();
-
-                    // Set key
-                    void* KeyPtr = MapHelper.GetKeyPtr(idx);
-                    if (!SetFieldValue(entryMsg, keyFd, MapProperty->KeyProp, KeyPtr))
-                    {
-                        UE_LOG(LogProto, Warning, TEXT("Proto map key set failed for %s"), *PropertyName);
-                    }
-
-                    // Set value
-                    void* ValPtr = MapHelper.GetValuePtr(idx);
-                    if (valFd->type() == FieldDescriptor::TYPE_MESSAGE && CastField<FStructProperty>(MapProperty->ValueProp))
-                    {
-                        const UScriptStruct* InnerStruct = CastField<FStructProperty>(MapProperty->ValueProp)->Struct;
-                        if (!InnerStruct)
-                        {
-                            UE_LOG(LogProto, Error, TEXT("Proto map value inner struct invalid for %s"), *PropertyName);
-                            continue;
-                        }
-                        Message* nestedValue = entryReflection->MutableMessage(entryMsg, valFd);
-                        if (!nestedValue)
-                        {
-                            UE_LOG(LogProto, Error, TEXT("Proto failed to get mutable map value message for %s"), *PropertyName);
-                            continue;
-                        }
-                        if (!DeserializeStructToMessage(const_cast<UScriptStruct*>(InnerStruct), ValPtr, *nestedValue, const_cast<FieldDescriptor*>(valFd)))
-                        {
-                            UE_LOG(LogProto, Error, TEXT("Proto failed to fill nested map value for %s"), *PropertyName);
-                            entryReflection->ClearField(entryMsg, valFd);
-                        }
-                    }
-                    else
-                    {
-                        if (!SetFieldValue(entryMsg, valFd, MapProperty->ValueProp, ValPtr))
-                        {
-                            UE_LOG(LogProto, Warning, TEXT("Proto map value set failed for %s"), *PropertyName);
-                        }
-                    }
-                }
-            }
-            continue;
-        }
+bool ULinkProtobufFunctionLibrary::DeserializeStructToMessage(const void* Struct, google::protobuf::Message& TargetMsg, const FLinkProtoFieldMask& Mask)
+{
+    return Mask.WriteToMessage(Struct, TargetMsg);
+}
 
-        // Nested message (non-map)
-        if (ItField->type() == FieldDescriptor::TYPE_MESSAGE)
-        {
-            if (const FStructProperty* StructProp = CastField<FStructProperty>(Property))
-            {
-                const UScriptStruct* InnerStruct = StructProp->Struct;
-                Message* targetNested = reflection->MutableMessage(&TargetMsg, ItField);
-                if (!targetNested)
-                {
-                    UE_LOG(LogProto, Error, TEXT("Proto failed to get mutable nested message for %s"), *PropertyName);
-                    continue;
-                }
-                if (!DeserializeStructToMessage(const_cast<UScriptStruct*>(InnerStruct), ContainerPtr, *targetNested, const_cast<FieldDescriptor*>(ItField)))
-                {
-                    UE_LOG(LogProto, Error, TEXT("Proto failed to fill nested message for %s"), *PropertyName);
-                    reflection->ClearField(&TargetMsg, ItField);
-                }
-            }
-            continue;
-        }
-		//normal
-        SetFieldValue(&TargetMsg, ItField, Property, ContainerPtr);
+bool ULinkProtobufFunctionLibrary::DeserializeStructToMessage(UScriptStruct* StructDefinition, const void* Struct, google::protobuf::Message& TargetMsg, const google::protobuf::FieldMask& Mask)
+{
+    if (!StructDefinition || !Struct)
+    {
+        UE_LOG(LogProto, Error, TEXT("Proto DeserializeStructToMessage: invalid inputs"));
+        return false;
     }
+    FLinkProtoFieldMask CompiledMask;
+    return CompiledMask.Compile(FindPlanForMessage(StructDefinition, TargetMsg), Mask) && CompiledMask.WriteToMessage(Struct, TargetMsg);
+}
 
+// Sizes the message once (caching the nested sizes), Serialize then writes exactly that many bytes into the output
+static bool SerializeMessageInPlace(const google::protobuf::Message& Msg, const FString& StructName, TFunctionRef<uint8*(int32)> PrepareOutput)
+{
+    const size_t ByteSize = Msg.ByteSizeLong();
+    if (ByteSize > static_cast<size_t>(MAX_int32))
+    {
+        UE_LOG(LogProto, Error, TEXT("Proto message for %s is too large to serialize (%llu bytes)"), *StructName, static_cast<uint64>(ByteSize));
+        return false;
+    }
+    uint8* Target = PrepareOutput(static_cast<int32>(ByteSize));
+    uint8* End = Msg.SerializeWithCachedSizesToArray(Target);
+    check(End == Target + ByteSize);
     return true;
 }
 
@@ -455,18 +291,15 @@ bool ULinkProtobufFunctionLibrary::SerializeMessageToBinaryString(google::protob
     if (!message->IsInitialized())
     {
         UE_LOG(LogProto, Warning, TEXT("Proto Message for %s is not fully initialized, using partial serialization"), *StructName);
-        bool bResult = message->SerializePartialToString(&OutProtoBinaryString);
-        UE_LOG(LogProto, Log, TEXT("Proto Partial serialization %s for %s"),
-               bResult ? TEXT("succeeded") : TEXT("failed"), *StructName);
-        return bResult;
     }
-    else
+    // resize keeps the string's capacity, the bytes are written in place
+    bool bResult = SerializeMessageInPlace(*message, StructName, [&OutProtoBinaryString](int32 Size)
     {
-        bool bResult = message->SerializeToString(&OutProtoBinaryString);
-        UE_LOG(LogProto, Log, TEXT("Proto Full serialization %s for %s"),
-               bResult ? TEXT("succeeded") : TEXT("failed"), *StructName);
-        return bResult;
-    }
+        OutProtoBinaryString.resize(Size);
+        return reinterpret_cast<uint8*>(&OutProtoBinaryString[0]);
+    });
+    UE_LOG(LogProto, Log, TEXT("Proto serialization %s for %s"), bResult ? TEXT("succeeded") : TEXT("failed"), *StructName);
+    return bResult;
 }
 
 bool ULinkProtobufFunctionLibrary::SerializeMessageToBinaryBytes(
@@ -480,19 +313,17 @@ bool ULinkProtobufFunctionLibrary::SerializeMessageToBinaryBytes(
 		return false;
 	}
 
-	std::string BinaryData;
-	bool bSuccess = Message->SerializeToString(&BinaryData);
-
-	if (!bSuccess)
+	if (!Message->IsInitialized())
 	{
-		UE_LOG(LogProto, Error, TEXT("Failed to serialize message for %s"), *StructName);
-		return false;
+		UE_LOG(LogProto, Warning, TEXT("Proto Message for %s is not fully initialized, using partial serialization"), *StructName);
 	}
 
-	OutBytes.SetNumUninitialized(BinaryData.size());
-	FMemory::Memcpy(OutBytes.GetData(), BinaryData.data(), BinaryData.size());
-
-	return true;
+	// Written straight into the caller's array, its allocation is reused when large enough
+	return SerializeMessageInPlace(*Message, StructName, [&OutBytes](int32 Size)
+	{
+		OutBytes.SetNumUninitialized(Size, LINKPROTO_NO_SHRINK);
+		return OutBytes.GetData();
+	});
 }
 
 
@@ -526,61 +357,100 @@ DEFINE_FUNCTION(ULinkProtobufFunctionLibrary::execProtoBinaryBytesToStruct)
     *StaticCast<bool*>(RESULT_PARAM) = bResult;
 }
 
-bool ULinkProtobufFunctionLibrary::ConvertProtoBinaryBytesToStruct(UScriptStruct* StructDefinition, bool bAllowIncomplete,
-    const TArray<uint8>& ProtoBinaryBytes, void* ResultStruct)
+// Shared by the array and stream overloads: Decode runs the wire decoder on the plan, Parse fills a message for the
+// proto2 path that has to check required fields
+template<typename DecodeFunc, typename ParseFunc>
+static bool ConvertProtoToStructInternal(UScriptStruct* StructDefinition, bool bAllowIncomplete, void* ResultStruct, DecodeFunc&& Decode, ParseFunc&& Parse)
 {
-    if (!StructDefinition || !ResultStruct)
+    FString StructName = StructDefinition->GetName();
+    FLinkProtoStructPlanPtr Plan = FLinkProtoPlanCache::Get().FindOrBuild(StructDefinition);
+    if (!Plan)
     {
-        UE_LOG(LogProto, Error, TEXT("Proto ConvertProtoBinaryBytesToStruct: invalid struct inputs"));
+        UE_LOG(LogProto, Error, TEXT("Proto ConvertProtoBinaryBytesToStruct: descriptor not found for %s"), *StructName);
         return false;
     }
-    if (ProtoBinaryBytes.Num() <= 0)
+
+    // Required fields only exist in proto2, checking them needs the parsed message
+    const bool bNeedsInitializedCheck = !bAllowIncomplete && Plan->Descriptor->file()->syntax() == google::protobuf::FileDescriptor::SYNTAX_PROTO2;
+    if (!bNeedsInitializedCheck)
     {
-        UE_LOG(LogProto, Warning, TEXT("Proto ConvertProtoBinaryBytesToStruct: empty bytes"));
-        return false;
+        bool bDecodeOk = Decode(*Plan);
+        UE_LOG(LogProto, Verbose, TEXT("Proto wire decode used for %s => %s"), *StructName, bDecodeOk ? TEXT("Success") : TEXT("Fail"));
+        if (!bDecodeOk)
+        {
+            UE_LOG(LogProto, Error, TEXT("Proto ConvertProtoBinaryBytesToStruct: parse failed for %s (AllowIncomplete=%s)"), *StructName, bAllowIncomplete ? TEXT("true") : TEXT("false"));
+        }
+        return bDecodeOk;
     }
 
-    FString StructName = StructDefinition->GetName();
-    std::string ProtoName = TCHAR_TO_UTF8(*StructName);
-    const Descriptor* DescriptorPtr = DescriptorPool::generated_pool()->FindMessageTypeByName(ProtoName);
-    if (!DescriptorPtr)
+    if (!Plan->Prototype)
     {
-        UE_LOG(LogProto, Error, TEXT("Proto ConvertProtoBinaryBytesToStruct: descriptor not found for %s"), *StructName);
+        UE_LOG(LogProto, Error, TEXT("Proto ConvertProtoBinaryBytesToStruct: prototype not found for %s"), *StructName);
         return false;
     }
-    const Message* Prototype = MessageFactory::generated_factory()->GetPrototype(DescriptorPtr);
-    if (!Prototype)
+
+    FLinkProtoArenaScope ArenaScope;
+    Message* ParsedMsg = ArenaScope.NewMessage(*Plan->Prototype);
+    bool bParseOk = Parse(*ParsedMsg);
+    UE_LOG(LogProto, Verbose, TEXT("Proto Parse used (AllowIncomplete=false) for %s => %s"), *StructName, bParseOk ? TEXT("Success") : TEXT("Fail"));
+
+    if (!bParseOk)
     {
-        UE_LOG(LogProto, Error, TEXT("Proto ConvertProtoBinaryBytesToStruct: prototype not found for %s"), *StructName);
+        UE_LOG(LogProto, Error, TEXT("Proto ConvertProtoBinaryBytesToStruct: parse failed for %s (AllowIncomplete=false)"), *StructName);
         return false;
     }
 
-    Message* ParsedMsg = Prototype->New();
-    bool bParseOk;
-    if (bAllowIncomplete)
+    if (!ParsedMsg->IsInitialized())
     {
-        bParseOk = ParsedMsg->ParsePartialFromArray(ProtoBinaryBytes.GetData(), ProtoBinaryBytes.Num());
-        UE_LOG(LogProto, Verbose, TEXT("Proto ParsePartial used (AllowIncomplete=true) for %s => %s"), *StructName, bParseOk ? TEXT("Success") : TEXT("Fail"));
+        UE_LOG(LogProto, Error, TEXT("Proto message for %s not fully initialized (AllowIncomplete=false)"), *StructName);
+        return false;
     }
-    else
+
+    FLinkProtoWireDecoder::ResetFields(*Plan, ResultStruct);
+    return Plan->ReadFromMessage(*ParsedMsg, ResultStruct);
+}
+
+bool ULinkProtobufFunctionLibrary::ConvertProtoBinaryBytesToStruct(UScriptStruct* StructDefinition, bool bAllowIncomplete,
+    const TArray<uint8>& ProtoBinaryBytes, void* ResultStruct)
+{
+    if (!StructDefinition || !ResultStruct)
     {
-        bParseOk = ParsedMsg->ParseFromArray(ProtoBinaryBytes.GetData(), ProtoBinaryBytes.Num());
-        UE_LOG(LogProto, Verbose, TEXT("Proto Parse used (AllowIncomplete=false) for %s => %s"), *StructName, bParseOk ? TEXT("Success") : TEXT("Fail"));
+        UE_LOG(LogProto, Error, TEXT("Proto ConvertProtoBinaryBytesToStruct: invalid struct inputs"));
+        return false;
     }
-
-    if (!bParseOk)
+    if (ProtoBinaryBytes.Num() <= 0)
     {
-        UE_LOG(LogProto, Error, TEXT("Proto ConvertProtoBinaryBytesToStruct: parse failed for %s (AllowIncomplete=%s)"), *StructName, bAllowIncomplete ? TEXT("true") : TEXT("false"));
+        UE_LOG(LogProto, Warning, TEXT("Proto ConvertProtoBinaryBytesToStruct: empty bytes"));
         return false;
     }
 
-    if (!bAllowIncomplete && !ParsedMsg->IsInitialized())
+    return ConvertProtoToStructInternal(StructDefinition, bAllowIncomplete, ResultStruct,
+        [&](const FLinkProtoStructPlan& Plan) {
+            return FLinkProtoWireDecoder::Decode(Plan, ProtoBinaryBytes, ResultStruct);
+        },
+        [&](Message& ParsedMsg) {
+            return ParsedMsg.ParsePartialFromArray(ProtoBinaryBytes.GetData(), ProtoBinaryBytes.Num());
+        }
+    );
+}
+
+bool ULinkProtobufFunctionLibrary::ConvertProtoBinaryBytesToStruct(UScriptStruct* StructDefinition, bool bAllowIncomplete,
+    google::protobuf::io::ZeroCopyInputStream& Input, void* ResultStruct)
+{
+    if (!StructDefinition || !ResultStruct)
     {
-        UE_LOG(LogProto, Error, TEXT("Proto message for %s not fully initialized (AllowIncomplete=false)"), *StructName);
+        UE_LOG(LogProto, Error, TEXT("Proto ConvertProtoBinaryBytesToStruct: invalid struct inputs"));
         return false;
     }
 
-    return FillProtoMessageIntoUStruct(*ParsedMsg, StructDefinition, ResultStruct);
+    return ConvertProtoToStructInternal(StructDefinition, bAllowIncomplete, ResultStruct,
+        [&](const FLinkProtoStructPlan& Plan) {
+            return FLinkProtoWireDecoder::Decode(Plan, Input, ResultStruct);
+        },
+        [&](Message& ParsedMsg) {
+            return ParsedMsg.ParsePartialFromZeroCopyStream(&Input);
+        }
+    );
 }
 
 
@@ -597,336 +467,26 @@ bool ULinkProtobufFunctionLibrary::FillProtoMessageIntoUStruct(const google::pro
     	return false;
     }
 
-	//Basic lambda to write primitive value from protobuf field to property
-    auto WritePrimitiveToProperty = [&](FProperty* Prop, const Message& EntryMsg ,void* Dest, const FieldDescriptor* Fd, int Index, bool bRepeated)->bool
-    {
-        if (!Prop || !Dest || !Fd)
-        {
-            UE_LOG(LogProto, Error, TEXT("Proto WritePrimitiveToProperty: invalid arguments"));
-            return false;
-        }
-        const Reflection* EntyRef = EntryMsg.GetReflection();
-        if (!EntyRef)
-        {
-            UE_LOG(LogProto, Error, TEXT("Proto WritePrimitiveToProperty: Reflection is nullptr"));
-            return false;
-        }
-        auto EnsureIndex = [&](int Wanted)->bool
-        {
-            if (!bRepeated) return true;
-            int Size = EntyRef->FieldSize(EntryMsg, Fd);
-            if (Wanted < 0 || Wanted >= Size)
-            {
-                UE_LOG(LogProto, Error, TEXT("Proto WritePrimitiveToProperty: index %d out of range %d for field %s"), Wanted, Size, UTF8_TO_TCHAR(Fd->name().c_str()));
-                return false;
-            }
-            return true;
-        };
-    	auto GetStringLikeValue = [&](std::string& Out) -> bool
-    	{
-    		if (!Fd || !EntyRef || Fd->containing_type() != EntryMsg.GetDescriptor())
-    			return false;
-
-    		const bool bStringOrBytes =
-				Fd->type() == FieldDescriptor::TYPE_STRING ||
-				Fd->type() == FieldDescriptor::TYPE_BYTES;
-
-    		if (Fd->is_repeated())
-    		{
-    			const int size = EntyRef->FieldSize(EntryMsg, Fd);
-    			if (Index < 0 || Index >= size)
-    			{
-    				UE_LOG(LogProto, Error, TEXT("Proto GetStringLikeValue: Index %d out of range %d for [%s]"),
-				   Index, size, UTF8_TO_TCHAR(Fd->name().c_str()));
-    				return false;
-    			}
-    			if (!bStringOrBytes)
-    			{
-    				UE_LOG(LogProto, Error, TEXT("Proto GetStringLikeValue: Field [%s] is repeated but not string/bytes (type=%d)"),
-				   UTF8_TO_TCHAR(Fd->name().c_str()), (int)Fd->type());
-    				return false;
-    			}
-    			Out = EntyRef->GetRepeatedString(EntryMsg, Fd, Index);
-    			return true;
-    		}
-    		else
-    		{
-    			if (!bStringOrBytes)
-    			{
-    				UE_LOG(LogProto, Error, TEXT("Proto GetStringLikeValue: Field [%s] is not string/bytes (type=%d)"),
-				   UTF8_TO_TCHAR(Fd->name().c_str()), (int)Fd->type());
-    				return false;
-    			}
-    			Out = EntyRef->GetString(EntryMsg, Fd);
-    			return true;
-    		}
-    	};
-    	auto GetStringValue = GetStringLikeValue;
-    	auto GetBytesValue = GetStringLikeValue;
-        auto GetEnumNumber = [&]()->int32
-        {
-            if (bRepeated)
-                return F_Ref->GetRepeatedEnumValue(EntryMsg, Fd, Index);
-            else
-                return F_Ref->GetEnumValue(EntryMsg, Fd);
-        };
+    return FindPlanForMessage(StructDefinition, Msg)->ReadFromMessage(Msg, DestStruct);
+}
 
-        switch (Fd->type())
-        {
-        case FieldDescriptor::TYPE_INT32:
-            if (!EnsureIndex(Index)) return false;
-            if (FIntProperty* IntP = CastField<FIntProperty>(Prop))
-            {
-                int32 V = bRepeated ? F_Ref->GetRepeatedInt32(EntryMsg, Fd, Index) : F_Ref->GetInt32(EntryMsg, Fd);
-            	IntP->SetPropertyValue(Dest,V);
-                return true;
-            }
-            break;
-        case FieldDescriptor::TYPE_INT64:
-            if (!EnsureIndex(Index)) return false;
-            if (FInt64Property* Int64P = CastField<FInt64Property>(Prop))
-            {
-                int64 V = bRepeated ? F_Ref->GetRepeatedInt64(EntryMsg, Fd, Index) : F_Ref->GetInt64(EntryMsg, Fd);
-            	Int64P->SetPropertyValue(Dest,V);
-                return true;
-            }
-            break;
-        case FieldDescriptor::TYPE_UINT32:
-            if (!EnsureIndex(Index)) return false;
-            if (FUInt32Property* UInt32P = CastField<FUInt32Property>(Prop))
-            {
-                uint32 V = bRepeated ? F_Ref->GetRepeatedUInt32(EntryMsg, Fd, Index) : F_Ref->GetUInt32(EntryMsg, Fd);
-            	UInt32P->SetPropertyValue(Dest,V);
-                return true;
-            }
-            if (FIntProperty* IntP2 = CastField<FIntProperty>(Prop))
-            {
-                uint32 V = bRepeated ? F_Ref->GetRepeatedUInt32(EntryMsg, Fd, Index) : F_Ref->GetUInt32(EntryMsg, Fd);
-            	IntP2->SetPropertyValue(Dest,static_cast<int32>(V));
-                return true;
-            }
-            break;
-        case FieldDescriptor::TYPE_UINT64:
-            if (!EnsureIndex(Index)) return false;
-            if (FUInt64Property* UInt64P = CastField<FUInt64Property>(Prop))
-            {
-                uint64 V = bRepeated ? F_Ref->GetRepeatedUInt64(EntryMsg, Fd, Index) : F_Ref->GetUInt64(EntryMsg, Fd);
-            	UInt64P->SetPropertyValue(Dest,V);
-                return true;
-            }
-            if (FInt64Property* Int64P2 = CastField<FInt64Property>(Prop))
-            {
-                uint64 V = bRepeated ? F_Ref->GetRepeatedUInt64(EntryMsg, Fd, Index) : F_Ref->GetUInt64(EntryMsg, Fd);
-            	Int64P2->SetPropertyValue(Dest,static_cast<int64>(V));
-                return true;
-            }
-            break;
-        case FieldDescriptor::TYPE_FLOAT:
-            if (!EnsureIndex(Index)) return false;
-            if (FFloatProperty* FloatP = CastField<FFloatProperty>(Prop))
-            {
-                float V = bRepeated ? F_Ref->GetRepeatedFloat(EntryMsg, Fd, Index) : F_Ref->GetFloat(EntryMsg, Fd);
-            	FloatP->SetPropertyValue(Dest,V);
-                return true;
-            }
-            break;
-        case FieldDescriptor::TYPE_DOUBLE:
-            if (!EnsureIndex(Index)) return false;
-            if (FDoubleProperty* DoubleP = CastField<FDoubleProperty>(Prop))
-            {
-                double V = bRepeated ? F_Ref->GetRepeatedDouble(EntryMsg, Fd, Index) : F_Ref->GetDouble(EntryMsg, Fd);
-            	DoubleP->SetPropertyValue(Dest,V);
-                return true;
-            }
-            if (FFloatProperty* FloatP = CastField<FFloatProperty>(Prop))
-            {
-                double V = bRepeated ? F_Ref->GetRepeatedDouble(EntryMsg, Fd, Index) : F_Ref->GetDouble(EntryMsg, Fd);
-            	FloatP->SetPropertyValue(Dest,V);
-                return true;
-            }
-            break;
-        case FieldDescriptor::TYPE_BOOL:
-            if (!EnsureIndex(Index)) return false;
-            if (FBoolProperty* BoolP = CastField<FBoolProperty>(Prop))
-            {
-                bool V = bRepeated ? F_Ref->GetRepeatedBool(EntryMsg, Fd, Index) : F_Ref->GetBool(EntryMsg, Fd);
-                BoolP->SetPropertyValue(Dest, V);
-                return true;
-            }
-            break;
-        case FieldDescriptor::TYPE_ENUM:
-            if (!EnsureIndex(Index)) return false;
-	        {
-		        int32 EnumNumber = GetEnumNumber();
-        		if (FEnumProperty* EnumProp = CastField<FEnumProperty>(Prop))
-        		{
-        			if (FProperty* Under = EnumProp->GetUnderlyingProperty())
-        			{
-        				if (FByteProperty* ByteP = CastField<FByteProperty>(Under))
-        				{
-        					ByteP->SetPropertyValue(Dest, static_cast<uint8>(EnumNumber));
-        					return true;
-        				}
-        				if (FIntProperty* IntP = CastField<FIntProperty>(Under))
-        				{
-        					IntP->SetPropertyValue(Dest, EnumNumber);
-        					return true;
-        				}
-        			}
-        		}
-	        }
-            break;
-        case FieldDescriptor::TYPE_STRING:
-        {
-            std::string S; if (!GetStringValue(S)) return false;
-            if (FStrProperty* StrP = CastField<FStrProperty>(Prop))
-            {
-            	StrP->SetPropertyValue(Dest, UTF8_TO_TCHAR(S.c_str()));
-            	return true;
-            }
-            if (FNameProperty* NameP = CastField<FNameProperty>(Prop))
-            {
-            	NameP->SetPropertyValue(Dest, UTF8_TO_TCHAR(S.c_str()));
-            	return true;
-            }
-            if (FTextProperty* TextP = CastField<FTextProperty>(Prop))
-            {
-            	TextP->SetPropertyValue(Dest, FText::FromString(UTF8_TO_TCHAR(S.c_str())));
-            	return true;
-            }
-            break;
-        }
-        case FieldDescriptor::TYPE_BYTES:
-        	{
-        		if (!EnsureIndex(Index)) return false;
-        		std::string value; if (!GetBytesValue(value)) return false;
-        		if (FByteProperty* BP = CastField<FByteProperty>(Prop))
-        		{
-        			uint8 V = value.empty() ? 0 : static_cast<uint8>(value[0]);
-        			BP->SetPropertyValue(Dest, V);
-        		}
-        	}
-        default:
-            UE_LOG(LogProto, Warning, TEXT("Proto WritePrimitiveToProperty: unhandled fd type %d (%s)"), (int)Fd->type(), UTF8_TO_TCHAR(Fd->name().c_str()));
-            return false;
-        }
-        UE_LOG(LogProto, Warning, TEXT("Proto WritePrimitiveToProperty: property type mismatch for field %s -> %s"), UTF8_TO_TCHAR(Fd->name().c_str()), *Prop->GetName());
-        return false;
-    };
+bool ULinkProtobufFunctionLibrary::FillProtoMessageIntoUStruct(const google::protobuf::Message& Msg, void* DestStruct, const FLinkProtoFieldMask& Mask)
+{
+    return Mask.ReadFromMessage(Msg, DestStruct);
+}
 
-    for (TFieldIterator<FProperty> It(StructDefinition); It; ++It)
-    {
-        FProperty* Prop = *It;
-        FString FieldNameUE = GetPureNameOfProperty(Prop).Replace(TEXT(" "), TEXT(""));
-        std::string ProtoFieldName = TCHAR_TO_UTF8(*FieldNameUE);
-        const FieldDescriptor* FD = F_Desc->FindFieldByName(ProtoFieldName);
-        if (!FD)
-        {
-        	UE_LOG(LogProto, Warning, TEXT("Proto WritePrimitiveToProperty: field %s not found in message %s, skip"), *FieldNameUE, UTF8_TO_TCHAR(F_Desc->name().c_str()));
-			continue;
-        }
-		//Deserialize Map type
-        if (FD->is_map())
-        {
-            FMapProperty* MapProp = CastField<FMapProperty>(Prop);
-            if (!MapProp) continue;
-            int EntryCount = F_Ref->FieldSize(Msg, FD);
-            FScriptMapHelper MapHelper(MapProp, MapProp->ContainerPtrToValuePtr<void>(DestStruct));
-            for (int i=0;i<EntryCount;++i)
-            {
-                const Message& EntryMsg = F_Ref->GetRepeatedMessage(Msg, FD, i);
-                const Descriptor* EntryDesc = EntryMsg.GetDescriptor();
-                const Reflection* EntryRefl = EntryMsg.GetReflection();
-                const FieldDescriptor* KeyFd = EntryDesc->FindFieldByName("key");
-                const FieldDescriptor* ValFd = EntryDesc->FindFieldByName("value");
-                int32 NewIndex = MapHelper.AddDefaultValue_Invalid_NeedsRehash();
-                void* KeyPtr = MapHelper.GetKeyPtr(NewIndex);
-                void* ValPtr = MapHelper.GetValuePtr(NewIndex);
-                if (KeyFd)
-                    WritePrimitiveToProperty(MapProp->KeyProp, EntryMsg,KeyPtr, KeyFd, 0, false);
-                if (ValFd)
-                {
-                    if (ValFd->type()==FieldDescriptor::TYPE_MESSAGE && CastField<FStructProperty>(MapProp->ValueProp))
-                    {
-                        const Message& NestedVal = EntryRefl->GetMessage(EntryMsg, ValFd);
-                        FillProtoMessageIntoUStruct(NestedVal, CastField<FStructProperty>(MapProp->ValueProp)->Struct, ValPtr);
-                    }
-                    else
-                    {
-                        WritePrimitiveToProperty(MapProp->ValueProp, EntryMsg,ValPtr, ValFd, 0, false);
-                    }
-                }
-            }
-            MapHelper.Rehash();
-            continue;
-        }
-        // Deserialize TArray type
-        if (FD->is_repeated() && CastField<FArrayProperty>(Prop))
-        {
-            FArrayProperty* ArrayProp = CastField<FArrayProperty>(Prop);
-            FScriptArrayHelper ArrayHelper(ArrayProp, ArrayProp->ContainerPtrToValuePtr<void>(DestStruct));
-            int Count = F_Ref->FieldSize(Msg, FD);
-            for (int i=0;i<Count;++i)
-            {
-                int32 NewIdx = ArrayHelper.AddValue();
-                void* ElemPtr = ArrayHelper.GetRawPtr(NewIdx);
-                if (FD->type()==FieldDescriptor::TYPE_MESSAGE)
-                {
-                    if (FStructProperty* ElemStructProp = CastField<FStructProperty>(ArrayProp->Inner))
-                    {
-                        const Message& SubMsg = F_Ref->GetRepeatedMessage(Msg, FD, i);
-                        FillProtoMessageIntoUStruct(SubMsg, ElemStructProp->Struct, ElemPtr);
-                    }
-                }
-                else
-                {
-                    WritePrimitiveToProperty(ArrayProp->Inner, Msg,ElemPtr, FD, i, true);
-                }
-            }
-            continue;
-        }
-        // TSet
-        if (FD->is_repeated() && CastField<FSetProperty>(Prop))
-        {
-            FSetProperty* SetProp = CastField<FSetProperty>(Prop);
-            FScriptSetHelper SetHelper(SetProp, SetProp->ContainerPtrToValuePtr<void>(DestStruct));
-            int Count = F_Ref->FieldSize(Msg, FD);
-            for (int i=0;i<Count;++i)
-            {
-                int32 NewIdx = SetHelper.AddDefaultValue_Invalid_NeedsRehash();
-                void* ElemPtr = SetHelper.GetElementPtr(NewIdx);
-                if (FD->type()==FieldDescriptor::TYPE_MESSAGE)
-                {
-                    if (FStructProperty* ElemStructProp = CastField<FStructProperty>(SetProp->ElementProp))
-                    {
-                        const Message& SubMsg = F_Ref->GetRepeatedMessage(Msg, FD, i);
-                        FillProtoMessageIntoUStruct(SubMsg, ElemStructProp->Struct, ElemPtr);
-                    }
-                }
-                else
-                {
-                    WritePrimitiveToProperty(SetProp->ElementProp, Msg, ElemPtr, FD, i, true);
-                }
-            }
-            SetHelper.Rehash();
-            continue;
-        }
-        // message
-        if (FD->type()==FieldDescriptor::TYPE_MESSAGE && CastField<FStructProperty>(Prop))
-        {
-            FStructProperty* NestedProp = CastField<FStructProperty>(Prop);
-            const Message& SubMsg = F_Ref->GetMessage(Msg, FD);
-            FillProtoMessageIntoUStruct(SubMsg, NestedProp->Struct, Prop->ContainerPtrToValuePtr<void>(DestStruct));
-            continue;
-        }
+bool ULinkProtobufFunctionLibrary::FillProtoMessageIntoUStruct(const google::protobuf::Message& Msg, UScriptStruct* StructDefinition, void* DestStruct, const google::protobuf::FieldMask& Mask)
+{
+    if (!StructDefinition || !DestStruct)
+        return false;
 
-        WritePrimitiveToProperty(Prop,Msg, Prop->ContainerPtrToValuePtr<void>(DestStruct), FD, 0, false);
-    }
-    return true;
+    FLinkProtoFieldMask CompiledMask;
+    return CompiledMask.Compile(FindPlanForMessage(StructDefinition, Msg), Mask) && CompiledMask.ReadFromMessage(Msg, DestStruct);
 }
 
-bool ULinkProtobufFunctionLibrary::SetFieldValue(google::protobuf::Message* targetMsg,
-                                                const google::protobuf::FieldDescriptor* field, FProperty* Property, const void* containerPtr)
+// Legacy conversion kept behind bUseLegacyTextConversion: exports the property as text and parses it back for the field type
+static bool SetFieldValueFromText(google::protobuf::Message* targetMsg,
+                                  const google::protobuf::FieldDescriptor* field, FProperty* Property, const void* containerPtr)
 {
 	FString PropertyValue;
 #if (ENGINE_MAJOR_VERSION > 5) || (ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 2)
@@ -955,7 +515,7 @@ bool ULinkProtobufFunctionLibrary::SetFieldValue(google::protobuf::Message* targ
 	bool bSetResult = false;
 	auto HandleBasicType = [&](auto ConvertFunc, auto SetFunc, auto AddFunc) {
 		if (bIsRepeated) {
-			TArray<FString> Values = ParseArrayString(PropertyValue);
+			TArray<FString> Values = ULinkProtobufFunctionLibrary::ParseArrayString(PropertyValue);
 			for (const FString& Val : Values) {
 				(fieldReflection->*AddFunc)(targetMsg, field, ConvertFunc(*Val));
 			}
@@ -975,7 +535,7 @@ bool ULinkProtobufFunctionLibrary::SetFieldValue(google::protobuf::Message* targ
 				UE_LOG(LogProto, Error, TEXT("Proto Failed to create mutable message for nested struct"));
 				return false;
 			}
-			if (!DeserializeStructToMessage(const_cast<UScriptStruct*>(InnerStruct), containerPtr, *nestedMsg, const_cast<google::protobuf::FieldDescriptor*>(field)))
+			if (!ULinkProtobufFunctionLibrary::DeserializeStructToMessage(const_cast<UScriptStruct*>(InnerStruct), containerPtr, *nestedMsg, const_cast<google::protobuf::FieldDescriptor*>(field)))
 			{
 				UE_LOG(LogProto, Error, TEXT("Proto Failed to fill nested message recursively"));
 				fieldReflection->ClearField(targetMsg, field);
@@ -989,7 +549,7 @@ bool ULinkProtobufFunctionLibrary::SetFieldValue(google::protobuf::Message* targ
 	switch (field->type()) {
 	case FieldDescriptor::TYPE_INT32:
 		if (bIsRepeated) {
-			TArray<FString> Values = ParseArrayString(PropertyValue);
+			TArray<FString> Values = ULinkProtobufFunctionLibrary::ParseArrayString(PropertyValue);
 			for (const FString& Val : Values) {
 				fieldReflection->AddInt32(targetMsg, field, FCString::Atoi(*Val));
 			}
@@ -1020,7 +580,7 @@ bool ULinkProtobufFunctionLibrary::SetFieldValue(google::protobuf::Message* targ
 		break;
 	case FieldDescriptor::TYPE_STRING:
 		if (bIsRepeated) {
-			TArray<FString> Values = ParseArrayString(PropertyValue);
+			TArray<FString> Values = ULinkProtobufFunctionLibrary::ParseArrayString(PropertyValue);
 			for (const FString& Val : Values) {
 				fieldReflection->AddString(targetMsg, field, TCHAR_TO_UTF8(*Val));
 			}
@@ -1033,7 +593,7 @@ bool ULinkProtobufFunctionLibrary::SetFieldValue(google::protobuf::Message* targ
 	case FieldDescriptor::TYPE_BYTES:
 		if (bIsRepeated)
 		{
-			TArray<FString> Values = ParseArrayString(PropertyValue);
+			TArray<FString> Values = ULinkProtobufFunctionLibrary::ParseArrayString(PropertyValue);
 			for (const FString& Val : Values)
 			{
 				std::string BytesData = TCHAR_TO_UTF8(*Val);
@@ -1049,7 +609,7 @@ bool ULinkProtobufFunctionLibrary::SetFieldValue(google::protobuf::Message* targ
 		break;
 	case FieldDescriptor::TYPE_ENUM:
 		if (bIsRepeated) {
-			TArray<FString> Values = ParseArrayString(PropertyValue);
+			TArray<FString> Values = ULinkProtobufFunctionLibrary::ParseArrayString(PropertyValue);
 			for (const FString& Val : Values) {
 				FString EnumStr = Val;
 				const google::protobuf::EnumDescriptor* EnumDesc = field->enum_type();
@@ -1087,6 +647,84 @@ bool ULinkProtobufFunctionLibrary::SetFieldValue(google::protobuf::Message* targ
 	return bSetResult;
 }
 
+// Adds one element to a repeated field, or sets a singular one, from typed property memory
+static bool SetTypedFieldValue(google::protobuf::Message* targetMsg, const FieldDescriptor* field, FProperty* Property, ELinkProtoValueType ValueType, const void* ValuePtr)
+{
+	const Reflection* fieldReflection = targetMsg->GetReflection();
+	if (field->cpp_type() != FieldDescriptor::CPPTYPE_MESSAGE)
+	{
+		return FLinkProtoValueAccess::WriteMessageField(*targetMsg, field, ValueType, Property, ValuePtr);
+	}
+	const FStructProperty* StructProp = CastField<FStructProperty>(Property);
+	if (!StructProp)
+	{
+		return false;
+	}
+	Message* nestedMsg = field->is_repeated() ? fieldReflection->AddMessage(targetMsg, field) : fieldReflection->MutableMessage(targetMsg, field);
+	if (!nestedMsg)
+	{
+		UE_LOG(LogProto, Error, TEXT("Proto Failed to create mutable message for nested struct"));
+		return false;
+	}
+	if (!ULinkProtobufFunctionLibrary::DeserializeStructToMessage(StructProp->Struct, ValuePtr, *nestedMsg, const_cast<FieldDescriptor*>(field)))
+	{
+		UE_LOG(LogProto, Error, TEXT("Proto Failed to fill nested message recursively"));
+		if (!field->is_repeated())
+		{
+			fieldReflection->ClearField(targetMsg, field);
+		}
+		return false;
+	}
+	return true;
+}
+
+bool ULinkProtobufFunctionLibrary::SetFieldValue(google::protobuf::Message* targetMsg,
+                                                const google::protobuf::FieldDescriptor* field, FProperty* Property, const void* containerPtr)
+{
+	if (!targetMsg || !field || !Property || !containerPtr)
+	{
+		UE_LOG(LogProto, Error, TEXT("Proto SetFieldValue: invalid arguments"));
+		return false;
+	}
+	if (ULinkProtobufRuntimeSettings::Get()->bUseLegacyTextConversion)
+	{
+		return SetFieldValueFromText(targetMsg, field, Property, containerPtr);
+	}
+
+	bool bSetResult = true;
+	if (field->is_repeated() && CastField<FArrayProperty>(Property))
+	{
+		const FArrayProperty* ArrayProp = CastField<FArrayProperty>(Property);
+		const ELinkProtoValueType ElemType = LinkProtoClassifyProperty(ArrayProp->Inner);
+		FScriptArrayHelper ArrayHelper(ArrayProp, containerPtr);
+		for (int32 i = 0; i < ArrayHelper.Num(); ++i)
+		{
+			bSetResult &= SetTypedFieldValue(targetMsg, field, ArrayProp->Inner, ElemType, ArrayHelper.GetRawPtr(i));
+		}
+	}
+	else if (field->is_repeated() && CastField<FSetProperty>(Property))
+	{
+		const FSetProperty* SetProp = CastField<FSetProperty>(Property);
+		const ELinkProtoValueType ElemType = LinkProtoClassifyProperty(SetProp->ElementProp);
+		FScriptSetHelper SetHelper(SetProp, containerPtr);
+		for (int32 i = 0; i < SetHelper.GetMaxIndex(); ++i)
+		{
+			if (!SetHelper.IsValidIndex(i)) continue;
+			bSetResult &= SetTypedFieldValue(targetMsg, field, SetProp->ElementProp, ElemType, SetHelper.GetElementPtr(i));
+		}
+	}
+	else
+	{
+		bSetResult = SetTypedFieldValue(targetMsg, field, Property, LinkProtoClassifySingularProperty(Property, field), containerPtr);
+	}
+
+	if (!bSetResult)
+	{
+		UE_LOG(LogProto, Error, TEXT("Proto SetFieldValue FAILED for Property %s field %s"), *Property->GetName(), UTF8_TO_TCHAR(field->name().c_str()));
+	}
+	return bSetResult;
+}
+
 
 
 EProto3Type ULinkProtobufFunctionLibrary::AssignProtoType(const FProperty* InProp)
@@ -1124,7 +762,13 @@ EProto3Type ULinkProtobufFunctionLibrary::AssignProtoType(const FProperty* InPro
 	{
 		ProtoType = EProto3Type::String;
 	}
-	else if (CastField<FByteProperty>(InProp))
+#if LINKPROTO_WITH_UTF8_STRING_PROPERTIES
+	else if (CastField<FUtf8StrProperty>(InProp) || CastField<FAnsiStrProperty>(InProp))
+	{
+		ProtoType = EProto3Type::String;
+	}
+#endif
+	else if (CastField<FByteProperty>(InProp) || IsByteArrayProperty(InProp))
 	{
 		ProtoType = EProto3Type::Bytes;
 	}
@@ -1178,7 +822,13 @@ FString ULinkProtobufFunctionLibrary::ProtoStringAssignProp(const FProperty* InP
 	{
 		return TEXT("string");
 	}
-	else if (CastField<FByteProperty>(InProp))
+#if LINKPROTO_WITH_UTF8_STRING_PROPERTIES
+	else if (CastField<FUtf8StrProperty>(InProp) || CastField<FAnsiStrProperty>(InProp))
+	{
+		return TEXT("string");
+	}
+#endif
+	else if (CastField<FByteProperty>(InProp) || IsByteArrayProperty(InProp))
 	{
 		return TEXT("bytes");
 	}
@@ -1205,6 +855,13 @@ FString ULinkProtobufFunctionLibrary::GetPureNameOfProperty(const FProperty* InP
 	return  InProp->GetAuthoredName().Replace(TEXT(" "), TEXT(""));
 }
 
+bool ULinkProtobufFunctionLibrary::IsByteArrayProperty(const FProperty* InProp)
+{
+	const FArrayProperty* ArrayProp = CastField<FArrayProperty>(InProp);
+	const FByteProperty* ByteProp = ArrayProp ? CastField<FByteProperty>(ArrayProp->Inner) : nullptr;
+	return ByteProp && !ByteProp->Enum;
+}
+
 
 
 void ULinkProtobufFunctionLibrary::ClearArenaCache(google::protobuf::Arena*ArenaPtr)
@@ -0,0 +1,94 @@
+// Copyright DarkestLink-Dev 2025 All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// SPDX-License-Identifier: Apache-2.0
+
+
+#include "LinkProtobufGeneratedRegistry.h"
+#include "LinkProtobufRuntime.h"
+
+FLinkProtoGeneratedRegistry& FLinkProtoGeneratedRegistry::Get()
+{
+	static FLinkProtoGeneratedRegistry Instance;
+	return Instance;
+}
+
+void FLinkProtoGeneratedRegistry::Register(FGetStructFunc GetStruct, const FLinkProtoGeneratedConverter& Converter)
+{
+	if (!GetStruct || !Converter.ToMessage || !Converter.FromMessage)
+	{
+		return;
+	}
+	FWriteScopeLock WriteLock(Lock);
+	FEntry& Entry = Pending.AddDefaulted_GetRef();
+	Entry.GetStruct = GetStruct;
+	Entry.Converter = Converter;
+}
+
+void FLinkProtoGeneratedRegistry::Unregister(FGetStructFunc GetStruct)
+{
+	bool bWasResolved = false;
+	{
+		FWriteScopeLock WriteLock(Lock);
+		Pending.RemoveAll([GetStruct](const FEntry& Entry) { return Entry.GetStruct == GetStruct; });
+		for (auto It = Resolved.CreateIterator(); It; ++It)
+		{
+			if (It.Value().GetStruct == GetStruct)
+			{
+				It.RemoveCurrent();
+				bWasResolved = true;
+			}
+		}
+	}
+	// Cached plans point into the module that is going away
+	if (bWasResolved && !IsEngineExitRequested())
+	{
+		FLinkProtoPlanCache::Get().Invalidate();
+	}
+}
+
+FLinkProtoGeneratedConverter FLinkProtoGeneratedRegistry::Find(const UScriptStruct* Struct)
+{
+	{
+		FReadScopeLock ReadLock(Lock);
+		if (Pending.Num() == 0)
+		{
+			const FEntry* Entry = Resolved.Find(Struct);
+			return Entry ? Entry->Converter : FLinkProtoGeneratedConverter();
+		}
+	}
+
+	FWriteScopeLock WriteLock(Lock);
+	ResolvePendingLocked();
+	const FEntry* Entry = Resolved.Find(Struct);
+	return Entry ? Entry->Converter : FLinkProtoGeneratedConverter();
+}
+
+void FLinkProtoGeneratedRegistry::ResolvePendingLocked()
+{
+	for (const FEntry& Entry : Pending)
+	{
+		const UScriptStruct* Struct = Entry.GetStruct();
+		if (!Struct)
+		{
+			continue;
+		}
+		if (Resolved.Contains(Struct))
+		{
+			UE_LOG(LogProto, Warning, TEXT("Proto generated converter for %s registered twice, keeping the first one"), *Struct->GetName());
+			continue;
+		}
+		Resolved.Add(Struct, Entry);
+	}
+	Pending.Reset();
+}
@@ -0,0 +1,461 @@
+// Copyright DarkestLink-Dev 2025 All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// SPDX-License-Identifier: Apache-2.0
+
+
+#include "LinkProtobufLazyView.h"
+#include "LinkProtobufConversionPlan.h"
+#include "LinkProtobufRuntime.h"
+#include "LinkProtobufUtf8.h"
+#include "Algo/BinarySearch.h"
+#include "google/protobuf/descriptor.h"
+#include "google/protobuf/io/coded_stream.h"
+#include "google/protobuf/wire_format_lite.h"
+
+using FieldDescriptor  = google::protobuf::FieldDescriptor;
+using CodedInputStream = google::protobuf::io::CodedInputStream;
+using WireFormatLite   = google::protobuf::internal::WireFormatLite;
+
+// ---------------------------------------------------------------------------------------------------------------------
+// FLinkProtoLazyValue
+// ---------------------------------------------------------------------------------------------------------------------
+
+int64 FLinkProtoLazyValue::AsInt64() const
+{
+	if (!Field)
+	{
+		return 0;
+	}
+	switch (Field->type())
+	{
+	case FieldDescriptor::TYPE_INT32:
+	case FieldDescriptor::TYPE_ENUM:     return static_cast<int32>(Bits);
+	case FieldDescriptor::TYPE_SINT32:
+	case FieldDescriptor::TYPE_SINT64:   return WireFormatLite::ZigZagDecode64(Bits);
+	case FieldDescriptor::TYPE_FIXED32:
+	case FieldDescriptor::TYPE_UINT32:   return static_cast<uint32>(Bits);
+	case FieldDescriptor::TYPE_SFIXED32: return static_cast<int32>(static_cast<uint32>(Bits));
+	case FieldDescriptor::TYPE_FLOAT:    return static_cast<int64>(WireFormatLite::DecodeFloat(static_cast<uint32>(Bits)));
+	case FieldDescriptor::TYPE_DOUBLE:   return static_cast<int64>(WireFormatLite::DecodeDouble(Bits));
+	case FieldDescriptor::TYPE_BOOL:     return Bits != 0 ? 1 : 0;
+	case FieldDescriptor::TYPE_INT64:
+	case FieldDescriptor::TYPE_UINT64:
+	case FieldDescriptor::TYPE_FIXED64:
+	case FieldDescriptor::TYPE_SFIXED64: return static_cast<int64>(Bits);
+	default:                             return 0;
+	}
+}
+
+uint64 FLinkProtoLazyValue::AsUInt64() const
+{
+	if (!Field)
+	{
+		return 0;
+	}
+	switch (Field->type())
+	{
+	case FieldDescriptor::TYPE_UINT64:
+	case FieldDescriptor::TYPE_FIXED64: return Bits;
+	case FieldDescriptor::TYPE_FLOAT:   return static_cast<uint64>(WireFormatLite::DecodeFloat(static_cast<uint32>(Bits)));
+	case FieldDescriptor::TYPE_DOUBLE:  return static_cast<uint64>(WireFormatLite::DecodeDouble(Bits));
+	default:                            return static_cast<uint64>(AsInt64());
+	}
+}
+
+double FLinkProtoLazyValue::AsDouble() const
+{
+	if (!Field)
+	{
+		return 0;
+	}
+	switch (Field->type())
+	{
+	case FieldDescriptor::TYPE_FLOAT:   return WireFormatLite::DecodeFloat(static_cast<uint32>(Bits));
+	case FieldDescriptor::TYPE_DOUBLE:  return WireFormatLite::DecodeDouble(Bits);
+	case FieldDescriptor::TYPE_UINT64:
+	case FieldDescriptor::TYPE_FIXED64: return static_cast<double>(Bits);
+	default:                            return static_cast<double>(AsInt64());
+	}
+}
+
+FString FLinkProtoLazyValue::AsString() const
+{
+	FString Str;
+	FLinkProtoUtf8::Decode(reinterpret_cast<const ANSICHAR*>(Bytes.GetData()), Bytes.Num(), Str);
+	return Str;
+}
+
+FLinkProtoLazyView FLinkProtoLazyValue::AsMessage() const
+{
+	if (!Field || Field->cpp_type() != FieldDescriptor::CPPTYPE_MESSAGE)
+	{
+		return FLinkProtoLazyView();
+	}
+	return FLinkProtoLazyView(Bytes, Field->message_type());
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Wire helpers
+// ---------------------------------------------------------------------------------------------------------------------
+
+static FORCEINLINE bool IsPackable(const FieldDescriptor* Field)
+{
+	return Field->is_repeated() && Field->cpp_type() != FieldDescriptor::CPPTYPE_STRING && Field->cpp_type() != FieldDescriptor::CPPTYPE_MESSAGE;
+}
+
+static FORCEINLINE WireFormatLite::WireType ElementWireType(const FieldDescriptor* Field)
+{
+	return WireFormatLite::WireTypeForFieldType(static_cast<WireFormatLite::FieldType>(Field->type()));
+}
+
+// Occurrences with another wire type are unknown fields to the proto parser, the view ignores them the same way
+static FORCEINLINE bool AcceptsWireType(const FieldDescriptor* Field, WireFormatLite::WireType WireType)
+{
+	return WireType == ElementWireType(Field) || (WireType == WireFormatLite::WIRETYPE_LENGTH_DELIMITED && IsPackable(Field));
+}
+
+// Reads one value of the wire type, Base is the first byte the stream was created over
+static bool ReadRawValue(CodedInputStream& Input, const uint8* Base, WireFormatLite::WireType WireType, FLinkProtoLazyValue& OutValue)
+{
+	switch (WireType)
+	{
+	case WireFormatLite::WIRETYPE_VARINT:
+		return Input.ReadVarint64(&OutValue.Bits);
+	case WireFormatLite::WIRETYPE_FIXED32:
+	{
+		uint32 Value = 0;
+		if (!Input.ReadLittleEndian32(&Value))
+		{
+			return false;
+		}
+		OutValue.Bits = Value;
+		return true;
+	}
+	case WireFormatLite::WIRETYPE_FIXED64:
+		return Input.ReadLittleEndian64(&OutValue.Bits);
+	case WireFormatLite::WIRETYPE_LENGTH_DELIMITED:
+	{
+		uint32 Length = 0;
+		if (!Input.ReadVarint32(&Length) || Length > static_cast<uint32>(MAX_int32))
+		{
+			return false;
+		}
+		const int32 Offset = Input.CurrentPosition();
+		if (!Input.Skip(static_cast<int32>(Length)))
+		{
+			return false;
+		}
+		OutValue.Bytes = MakeArrayView(Base + Offset, static_cast<int32>(Length));
+		return true;
+	}
+	default:
+		return false;
+	}
+}
+
+static void SetDefaultValue(const FieldDescriptor* Field, FLinkProtoLazyValue& OutValue)
+{
+	OutValue.Field = Field;
+	OutValue.Bits = 0;
+	OutValue.Bytes = TConstArrayView<uint8>();
+	switch (Field->type())
+	{
+	case FieldDescriptor::TYPE_INT32:
+	case FieldDescriptor::TYPE_SFIXED32: OutValue.Bits = static_cast<uint64>(static_cast<int64>(Field->default_value_int32())); break;
+	case FieldDescriptor::TYPE_INT64:
+	case FieldDescriptor::TYPE_SFIXED64: OutValue.Bits = static_cast<uint64>(Field->default_value_int64()); break;
+	case FieldDescriptor::TYPE_SINT32:   OutValue.Bits = WireFormatLite::ZigZagEncode64(Field->default_value_int32()); break;
+	case FieldDescriptor::TYPE_SINT64:   OutValue.Bits = WireFormatLite::ZigZagEncode64(Field->default_value_int64()); break;
+	case FieldDescriptor::TYPE_UINT32:
+	case FieldDescriptor::TYPE_FIXED32:  OutValue.Bits = Field->default_value_uint32(); break;
+	case FieldDescriptor::TYPE_UINT64:
+	case FieldDescriptor::TYPE_FIXED64:  OutValue.Bits = Field->default_value_uint64(); break;
+	case FieldDescriptor::TYPE_BOOL:     OutValue.Bits = Field->default_value_bool() ? 1 : 0; break;
+	case FieldDescriptor::TYPE_ENUM:     OutValue.Bits = static_cast<uint64>(static_cast<int64>(Field->default_value_enum()->number())); break;
+	case FieldDescriptor::TYPE_FLOAT:    OutValue.Bits = WireFormatLite::EncodeFloat(Field->default_value_float()); break;
+	case FieldDescriptor::TYPE_DOUBLE:   OutValue.Bits = WireFormatLite::EncodeDouble(Field->default_value_double()); break;
+	case FieldDescriptor::TYPE_STRING:
+	case FieldDescriptor::TYPE_BYTES:
+	{
+		// The default string is owned by the descriptor
+		const std::string& Default = Field->default_value_string();
+		OutValue.Bytes = MakeArrayView(reinterpret_cast<const uint8*>(Default.data()), static_cast<int32>(Default.size()));
+		break;
+	}
+	default:
+		break;
+	}
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// FLinkProtoLazyView
+// ---------------------------------------------------------------------------------------------------------------------
+
+FLinkProtoLazyView::FLinkProtoLazyView(TConstArrayView<uint8> InData, const google::protobuf::Descriptor* InDescriptor)
+	: Data(InData)
+	, Descriptor(InDescriptor)
+{
+}
+
+FLinkProtoLazyView::FLinkProtoLazyView(TConstArrayView<uint8> InData, const UScriptStruct* StructDefinition)
+	: Data(InData)
+{
+	const FLinkProtoStructPlanPtr Plan = StructDefinition ? FLinkProtoPlanCache::Get().FindOrBuild(StructDefinition) : nullptr;
+	if (!Plan)
+	{
+		UE_LOG(LogProto, Error, TEXT("Proto lazy view: no message bound to %s"), StructDefinition ? *StructDefinition->GetName() : TEXT("null struct"));
+		return;
+	}
+	Descriptor = Plan->Descriptor;
+}
+
+int32 FLinkProtoLazyView::FindFieldNumber(const FString& FieldName) const
+{
+	if (!Descriptor)
+	{
+		return 0;
+	}
+	const FieldDescriptor* Field = Descriptor->FindFieldByName(std::string(TCHAR_TO_UTF8(*FieldName)));
+	return Field ? Field->number() : 0;
+}
+
+bool FLinkProtoLazyView::BuildIndex() const
+{
+	bIndexed = true;
+	CodedInputStream Input(Data.GetData(), Data.Num());
+	const FieldDescriptor* Field = nullptr;
+	FFieldOccurrence* Occurrence = nullptr;
+	for (;;)
+	{
+		const int32 TagOffset = Input.CurrentPosition();
+		const uint32 Tag = Input.ReadTag();
+		if (Tag == 0)
+		{
+			break;
+		}
+		const int32 Number = WireFormatLite::GetTagFieldNumber(Tag);
+		const WireFormatLite::WireType WireType = WireFormatLite::GetTagWireType(Tag);
+		if (WireType == WireFormatLite::WIRETYPE_END_GROUP)
+		{
+			bMalformed = true;
+			break;
+		}
+
+		// Repeated fields arrive as runs of the same number, only look the field up when the number changes
+		if (!Field || Field->number() != Number)
+		{
+			Field = Descriptor->FindFieldByNumber(Number);
+			Occurrence = nullptr;
+		}
+		if (Field && AcceptsWireType(Field, WireType))
+		{
+			if (!Occurrence)
+			{
+				const int32 Position = Algo::LowerBoundBy(Index, Number, &FFieldOccurrence::Number);
+				if (Position == Index.Num() || Index[Position].Number != Number)
+				{
+					FFieldOccurrence& Added = Index.InsertDefaulted_GetRef(Position);
+					Added.Number = Number;
+					Added.FirstTagOffset = TagOffset;
+				}
+				Occurrence = &Index[Position];
+			}
+			++Occurrence->Count;
+			Occurrence->LastValueOffset = Input.CurrentPosition();
+			Occurrence->LastWireType = static_cast<uint8>(WireType);
+		}
+		if (!WireFormatLite::SkipField(&Input, Tag))
+		{
+			bMalformed = true;
+			break;
+		}
+	}
+	bMalformed |= !Input.ConsumedEntireMessage();
+	if (bMalformed)
+	{
+		UE_LOG(LogProto, Warning, TEXT("Proto lazy view: malformed %s message"), UTF8_TO_TCHAR(Descriptor->full_name().c_str()));
+	}
+	return !bMalformed;
+}
+
+const FLinkProtoLazyView::FFieldOccurrence* FLinkProtoLazyView::FindOccurrence(int32 FieldNumber) const
+{
+	const int32 Position = Algo::BinarySearchBy(Index, FieldNumber, &FFieldOccurrence::Number);
+	return Position != INDEX_NONE ? &Index[Position] : nullptr;
+}
+
+bool FLinkProtoLazyView::Has(int32 FieldNumber) const
+{
+	if (!Descriptor || (!bIndexed && !BuildIndex()) || bMalformed)
+	{
+		return false;
+	}
+	return FindOccurrence(FieldNumber) != nullptr;
+}
+
+bool FLinkProtoLazyView::GetValue(int32 FieldNumber, FLinkProtoLazyValue& OutValue) const
+{
+	if (!Descriptor || (!bIndexed && !BuildIndex()) || bMalformed)
+	{
+		return false;
+	}
+	const FieldDescriptor* Field = Descriptor->FindFieldByNumber(FieldNumber);
+	if (!Field || Field->is_repeated())
+	{
+		return false;
+	}
+
+	SetDefaultValue(Field, OutValue);
+	const FFieldOccurrence* Occurrence = FindOccurrence(FieldNumber);
+	if (!Occurrence)
+	{
+		return true;
+	}
+	const uint8* Base = Data.GetData() + Occurrence->LastValueOffset;
+	CodedInputStream Input(Base, Data.Num() - Occurrence->LastValueOffset);
+	return ReadRawValue(Input, Base, static_cast<WireFormatLite::WireType>(Occurrence->LastWireType), OutValue);
+}
+
+// Reads a singular field whose C++ type is in the allowed group
+template<typename ConvertFuncType>
+static FORCEINLINE bool GetConverted(const FLinkProtoLazyView& View, int32 FieldNumber, bool bWantString, bool bWantMessage, ConvertFuncType&& Convert)
+{
+	FLinkProtoLazyValue Value;
+	if (!View.GetValue(FieldNumber, Value))
+	{
+		return false;
+	}
+	const FieldDescriptor::CppType CppType = Value.Field->cpp_type();
+	if ((CppType == FieldDescriptor::CPPTYPE_STRING) != bWantString || (CppType == FieldDescriptor::CPPTYPE_MESSAGE) != bWantMessage)
+	{
+		return false;
+	}
+	Convert(Value);
+	return true;
+}
+
+bool FLinkProtoLazyView::GetInt64(int32 FieldNumber, int64& OutValue) const
+{
+	return GetConverted(*this, FieldNumber, false, false, [&OutValue](const FLinkProtoLazyValue& Value) { OutValue = Value.AsInt64(); });
+}
+
+bool FLinkProtoLazyView::GetUInt64(int32 FieldNumber, uint64& OutValue) const
+{
+	return GetConverted(*this, FieldNumber, false, false, [&OutValue](const FLinkProtoLazyValue& Value) { OutValue = Value.AsUInt64(); });
+}
+
+bool FLinkProtoLazyView::GetDouble(int32 FieldNumber, double& OutValue) const
+{
+	return GetConverted(*this, FieldNumber, false, false, [&OutValue](const FLinkProtoLazyValue& Value) { OutValue = Value.AsDouble(); });
+}
+
+bool FLinkProtoLazyView::GetBool(int32 FieldNumber, bool& OutValue) const
+{
+	return GetConverted(*this, FieldNumber, false, false, [&OutValue](const FLinkProtoLazyValue& Value) { OutValue = Value.AsBool(); });
+}
+
+bool FLinkProtoLazyView::GetString(int32 FieldNumber, FString& OutValue) const
+{
+	return GetConverted(*this, FieldNumber, true, false, [&OutValue](const FLinkProtoLazyValue& Value) { OutValue = Value.AsString(); });
+}
+
+bool FLinkProtoLazyView::GetBytes(int32 FieldNumber, TConstArrayView<uint8>& OutValue) const
+{
+	return GetConverted(*this, FieldNumber, true, false, [&OutValue](const FLinkProtoLazyValue& Value) { OutValue = Value.AsBytes(); });
+}
+
+bool FLinkProtoLazyView::GetMessage(int32 FieldNumber, FLinkProtoLazyView& OutView) const
+{
+	return GetConverted(*this, FieldNumber, false, true, [&OutView](const FLinkProtoLazyValue& Value) { OutView = Value.AsMessage(); });
+}
+
+bool FLinkProtoLazyView::ForEach(int32 FieldNumber, TFunctionRef<bool(const FLinkProtoLazyValue&)> Visitor) const
+{
+	if (!Descriptor || (!bIndexed && !BuildIndex()) || bMalformed)
+	{
+		return false;
+	}
+	const FieldDescriptor* Field = Descriptor->FindFieldByNumber(FieldNumber);
+	if (!Field)
+	{
+		return false;
+	}
+	const FFieldOccurrence* Occurrence = FindOccurrence(FieldNumber);
+	if (!Occurrence)
+	{
+		return true;
+	}
+
+	const uint8* Base = Data.GetData() + Occurrence->FirstTagOffset;
+	CodedInputStream Input(Base, Data.Num() - Occurrence->FirstTagOffset);
+	const WireFormatLite::WireType ElementType = ElementWireType(Field);
+	FLinkProtoLazyValue Value;
+	Value.Field = Field;
+	// The index already validated the framing, stop once every occurrence has been visited
+	for (int32 Remaining = Occurrence->Count; Remaining > 0;)
+	{
+		const uint32 Tag = Input.ReadTag();
+		const WireFormatLite::WireType WireType = WireFormatLite::GetTagWireType(Tag);
+		if (WireFormatLite::GetTagFieldNumber(Tag) != FieldNumber || !AcceptsWireType(Field, WireType))
+		{
+			if (!WireFormatLite::SkipField(&Input, Tag))
+			{
+				return false;
+			}
+			continue;
+		}
+		--Remaining;
+
+		if (WireType != ElementType)
+		{
+			// Packed run of numbers
+			uint32 Length = 0;
+			if (!Input.ReadVarint32(&Length) || Length > static_cast<uint32>(MAX_int32))
+			{
+				return false;
+			}
+			const CodedInputStream::Limit Limit = Input.PushLimit(static_cast<int32>(Length));
+			while (Input.BytesUntilLimit() > 0)
+			{
+				if (!ReadRawValue(Input, Base, ElementType, Value))
+				{
+					return false;
+				}
+				if (!Visitor(Value))
+				{
+					return true;
+				}
+			}
+			Input.PopLimit(Limit);
+			continue;
+		}
+
+		if (!ReadRawValue(Input, Base, WireType, Value))
+		{
+			return false;
+		}
+		if (!Visitor(Value))
+		{
+			return true;
+		}
+	}
+	return true;
+}
+
+int32 FLinkProtoLazyView::Num(int32 FieldNumber) const
+{
+	int32 Count = 0;
+	ForEach(FieldNumber, [&Count](const FLinkProtoLazyValue&) { ++Count; return true; });
+	return Count;
+}
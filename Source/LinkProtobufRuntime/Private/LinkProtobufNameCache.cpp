@@ -0,0 +1,210 @@
+// Copyright DarkestLink-Dev 2025 All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "LinkProtobufNameCache.h"
+#include "Hash/CityHash.h"
+#include "LinkProtobufRuntime.h"
+#include "LinkProtobufRuntimeSettings.h"
+#include "LinkProtobufUtf8.h"
+
+// Longer strings are not names worth caching (FName itself stops at NAME_SIZE characters)
+static constexpr int32 MaxCachedNameLength = NAME_SIZE;
+
+// Finalizer of MurmurHash3, spreads the name index and number over the shard and slot bits
+static FORCEINLINE uint64 MixNameKey(FName Name)
+{
+	uint64 Key = (static_cast<uint64>(Name.GetDisplayIndex().ToUnstableInt()) << 32) | static_cast<uint32>(Name.GetNumber());
+	Key ^= Key >> 33;
+	Key *= 0xff51afd7ed558ccdull;
+	Key ^= Key >> 33;
+	Key *= 0xc4ceb9fe1a85ec53ull;
+	Key ^= Key >> 33;
+	return Key;
+}
+
+FLinkProtoNameCache& FLinkProtoNameCache::Get()
+{
+	static FLinkProtoNameCache Instance(ULinkProtobufRuntimeSettings::Get()->NameCacheCapacity);
+	return Instance;
+}
+
+FLinkProtoNameCache::FLinkProtoNameCache(int32 Capacity)
+	: bEnabled(Capacity > 0)
+{
+	if (bEnabled)
+	{
+		InitTable(DecodeTable, Capacity);
+		InitTable(EncodeTable, Capacity);
+	}
+}
+
+FLinkProtoNameCache::~FLinkProtoNameCache()
+{
+	FreeTable(DecodeTable);
+	FreeTable(EncodeTable);
+}
+
+void FLinkProtoNameCache::InitTable(FTable& Table, int32 Capacity)
+{
+	const int32 ShardCapacity = FMath::Max(Capacity / NumShards, 1);
+	// At most half full, a probe always ends on an empty slot
+	const uint32 NumSlots = FMath::RoundUpToPowerOfTwo(static_cast<uint32>(ShardCapacity) * 2);
+	for (FShard& Shard : Table.Shards)
+	{
+		Shard.Slots = MakeUnique<std::atomic<FEntry*>[]>(NumSlots);
+		Shard.Mask = NumSlots - 1;
+		Shard.MaxNum = ShardCapacity;
+	}
+}
+
+void FLinkProtoNameCache::FreeTable(FTable& Table)
+{
+	for (FShard& Shard : Table.Shards)
+	{
+		if (!Shard.Slots)
+		{
+			continue;
+		}
+		for (uint32 Index = 0; Index <= Shard.Mask; ++Index)
+		{
+			if (FEntry* Entry = Shard.Slots[Index].load(std::memory_order_relaxed))
+			{
+				Entry->~FEntry();
+				FMemory::Free(Entry);
+			}
+		}
+	}
+}
+
+template<typename MatchFuncType>
+FLinkProtoNameCache::FEntry* FLinkProtoNameCache::Find(const FTable& Table, uint64 Hash, MatchFuncType&& Match)
+{
+	const FShard& Shard = Table.Shards[Hash >> (64 - NumShardBits)];
+	for (uint32 Index = static_cast<uint32>(Hash) & Shard.Mask; ; Index = (Index + 1) & Shard.Mask)
+	{
+		FEntry* Entry = Shard.Slots[Index].load(std::memory_order_acquire);
+		if (!Entry)
+		{
+			return nullptr;
+		}
+		if (Entry->Hash == Hash && Match(*Entry))
+		{
+			return Entry;
+		}
+	}
+}
+
+template<typename MatchFuncType>
+FLinkProtoNameCache::FEntry* FLinkProtoNameCache::Add(FTable& Table, uint64 Hash, FName Name, const ANSICHAR* Chars, int32 Num, MatchFuncType&& Match)
+{
+	FShard& Shard = Table.Shards[Hash >> (64 - NumShardBits)];
+	if (Shard.bFull.load(std::memory_order_relaxed))
+	{
+		return nullptr;
+	}
+	FScopeLock ScopeLock(&Shard.WriteLock);
+	uint32 Index = static_cast<uint32>(Hash) & Shard.Mask;
+	for (; ; Index = (Index + 1) & Shard.Mask)
+	{
+		// Only writers store into slots and they hold the lock, relaxed is enough here
+		FEntry* Entry = Shard.Slots[Index].load(std::memory_order_relaxed);
+		if (!Entry)
+		{
+			break;
+		}
+		if (Entry->Hash == Hash && Match(*Entry))
+		{
+			// Added by another thread since the lookup
+			return Entry;
+		}
+	}
+	if (Shard.Num >= Shard.MaxNum)
+	{
+		return nullptr;
+	}
+	if (++Shard.Num == Shard.MaxNum)
+	{
+		// Later misses of this shard no longer take the lock
+		Shard.bFull.store(true, std::memory_order_relaxed);
+		UE_LOG(LogProto, Log, TEXT("Proto name cache shard is full (%d names), raise NameCacheCapacity if names keep missing it"), Shard.MaxNum);
+	}
+
+	FEntry* NewEntry = static_cast<FEntry*>(FMemory::Malloc(sizeof(FEntry) + Num, alignof(FEntry)));
+	new (NewEntry) FEntry{ Hash, Name, Num };
+	FMemory::Memcpy(const_cast<ANSICHAR*>(NewEntry->GetChars()), Chars, Num);
+	// Publishes the filled entry to the lock free readers
+	Shard.Slots[Index].store(NewEntry, std::memory_order_release);
+	return NewEntry;
+}
+
+bool FLinkProtoNameCache::Decode(const ANSICHAR* Utf8, int32 Len, FName& Out)
+{
+	if (!bEnabled || Len <= 0 || Len > MaxCachedNameLength)
+	{
+		return FLinkProtoUtf8::Decode(Utf8, Len, Out);
+	}
+	const uint64 Hash = CityHash64(Utf8, static_cast<uint32>(Len));
+	auto Match = [Utf8, Len](const FEntry& Entry)
+	{
+		return Entry.Num == Len && FMemory::Memcmp(Entry.GetChars(), Utf8, Len) == 0;
+	};
+	if (const FEntry* Entry = Find(DecodeTable, Hash, Match))
+	{
+		Out = Entry->Name;
+		return true;
+	}
+	if (!FLinkProtoUtf8::Decode(Utf8, Len, Out))
+	{
+		return false;
+	}
+	Add(DecodeTable, Hash, Out, Utf8, Len, Match);
+	return true;
+}
+
+bool FLinkProtoNameCache::FindOrAddUtf8(FName Name, const ANSICHAR*& OutChars, int32& OutNum)
+{
+	if (!bEnabled)
+	{
+		return false;
+	}
+	const uint64 Hash = MixNameKey(Name);
+	// Same display string and number, the case insensitive FName comparison would merge differently cased names
+	auto Match = [Name](const FEntry& Entry)
+	{
+		return Entry.Name.GetDisplayIndex() == Name.GetDisplayIndex() && Entry.Name.GetNumber() == Name.GetNumber();
+	};
+	const FEntry* Entry = Find(EncodeTable, Hash, Match);
+	if (!Entry)
+	{
+		if (EncodeTable.Shards[Hash >> (64 - NumShardBits)].bFull.load(std::memory_order_relaxed))
+		{
+			// Left to the caller rather than transcoded twice
+			return false;
+		}
+		const std::string Utf8 = FLinkProtoUtf8::Encode(Name.ToString());
+		if (Utf8.size() > static_cast<size_t>(MaxCachedNameLength))
+		{
+			return false;
+		}
+		Entry = Add(EncodeTable, Hash, Name, Utf8.data(), static_cast<int32>(Utf8.size()), Match);
+		if (!Entry)
+		{
+			return false;
+		}
+	}
+	OutChars = Entry->GetChars();
+	OutNum = Entry->Num;
+	return true;
+}
@@ -14,18 +14,37 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include "LinkProtobufRuntime.h"
+#include "LinkProtobufConversionPlan.h"
+#include "LinkProtobufDescriptorRegistry.h"
+#include "LinkProtobufRuntimeSettings.h"
+#include "UObject/UObjectGlobals.h"
 
 #define LOCTEXT_NAMESPACE "FLinkProtobufRuntimeModule"
 DEFINE_LOG_CATEGORY(LogProto);
 
 void FLinkProtobufRuntimeModule::StartupModule()
 {
-	return;
+	// Hot reload and Live Coding both broadcast ReloadComplete once the new struct layouts are in place
+	ReloadCompleteHandle = FCoreUObjectDelegates::ReloadCompleteDelegate.AddLambda([](EReloadCompleteReason)
+	{
+		FLinkProtoPlanCache::Get().Invalidate();
+	});
+	PostGarbageCollectHandle = FCoreUObjectDelegates::GetPostGarbageCollect().AddLambda([]()
+	{
+		FLinkProtoPlanCache::Get().InvalidateIfStale();
+	});
+	for (const FString& DescriptorSet : ULinkProtobufRuntimeSettings::Get()->RuntimeDescriptorSets)
+	{
+		FLinkProtoDescriptorRegistry::Get().LoadDescriptorSetFile(DescriptorSet);
+	}
 }
 
 void FLinkProtobufRuntimeModule::ShutdownModule()
 {
-	return;
+	FCoreUObjectDelegates::ReloadCompleteDelegate.Remove(ReloadCompleteHandle);
+	FCoreUObjectDelegates::GetPostGarbageCollect().Remove(PostGarbageCollectHandle);
+	FLinkProtoDescriptorRegistry::Get().Reset();
+	FLinkProtoPlanCache::Get().Invalidate();
 }
 
 #undef LOCTEXT_NAMESPACE
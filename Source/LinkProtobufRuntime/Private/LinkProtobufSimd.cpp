@@ -0,0 +1,77 @@
+// Copyright DarkestLink-Dev 2025 All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// SPDX-License-Identifier: Apache-2.0
+
+
+#include "LinkProtobufSimd.h"
+
+#if LINKPROTO_SIMD_X86
+	#if defined(_MSC_VER) && !defined(__clang__)
+		#include <intrin.h>
+	#else
+		#include <cpuid.h>
+	#endif
+
+static void ReadCpuid(uint32 Leaf, uint32 SubLeaf, uint32 (&Regs)[4])
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+	int Info[4];
+	__cpuidex(Info, static_cast<int>(Leaf), static_cast<int>(SubLeaf));
+	for (int32 Index = 0; Index < 4; ++Index)
+	{
+		Regs[Index] = static_cast<uint32>(Info[Index]);
+	}
+#else
+	__cpuid_count(Leaf, SubLeaf, Regs[0], Regs[1], Regs[2], Regs[3]);
+#endif
+}
+
+// Register state the OS saves on context switches, AVX needs the SSE and AVX bits
+static uint64 ReadXcr0()
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+	return _xgetbv(0);
+#else
+	uint32 Low, High;
+	__asm__ volatile("xgetbv" : "=a"(Low), "=d"(High) : "c"(0));
+	return (static_cast<uint64>(High) << 32) | Low;
+#endif
+}
+
+#endif
+
+static FLinkProtoCpuFeatures DetectCpuFeatures()
+{
+	FLinkProtoCpuFeatures Features;
+#if LINKPROTO_SIMD_X86
+	uint32 Regs[4];
+	ReadCpuid(0, 0, Regs);
+	const uint32 MaxLeaf = Regs[0];
+	ReadCpuid(1, 0, Regs);
+	Features.bSse41 = (Regs[2] & (1u << 19)) != 0;
+	const bool bOsAvx = (Regs[2] & (1u << 27)) != 0 && (Regs[2] & (1u << 28)) != 0 && (ReadXcr0() & 0x6) == 0x6;
+	if (Features.bSse41 && bOsAvx && MaxLeaf >= 7)
+	{
+		ReadCpuid(7, 0, Regs);
+		Features.bAvx2 = (Regs[1] & (1u << 5)) != 0;
+	}
+#endif
+	return Features;
+}
+
+const FLinkProtoCpuFeatures& FLinkProtoCpuFeatures::Get()
+{
+	static const FLinkProtoCpuFeatures Features = DetectCpuFeatures();
+	return Features;
+}
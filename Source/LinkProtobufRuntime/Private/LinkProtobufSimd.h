@@ -0,0 +1,76 @@
+// Copyright DarkestLink-Dev 2025 All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// SPDX-License-Identifier: Apache-2.0
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/PlatformTime.h"
+
+// Vector kernels are built for 64 bit x86 and arm CPUs, the other targets only get the scalar ones
+#define LINKPROTO_SIMD_X86  (PLATFORM_CPU_X86_FAMILY && PLATFORM_64BITS)
+#define LINKPROTO_SIMD_NEON (PLATFORM_CPU_ARM_FAMILY && PLATFORM_64BITS)
+
+#if LINKPROTO_SIMD_X86
+	#include <immintrin.h>
+	#if defined(_MSC_VER) && !defined(__clang__)
+		#define LINKPROTO_TARGET_SSE41
+		#define LINKPROTO_TARGET_AVX2
+	#else
+		#define LINKPROTO_TARGET_SSE41 __attribute__((target("sse4.1")))
+		#define LINKPROTO_TARGET_AVX2  __attribute__((target("avx2")))
+	#endif
+#elif LINKPROTO_SIMD_NEON
+	#if defined(_MSC_VER) && !defined(__clang__)
+		#include <arm64_neon.h>
+	#else
+		#include <arm_neon.h>
+	#endif
+#endif
+
+/**
+ * Instruction sets of the running CPU the vector kernels are picked by, read once.
+ * SSE2 is part of every x86_64 CPU and NEON of every arm64 one, so neither has a flag.
+ */
+struct FLinkProtoCpuFeatures
+{
+	bool bSse41 = false;
+	// Also requires the OS to save the AVX registers
+	bool bAvx2 = false;
+
+	static const FLinkProtoCpuFeatures& Get();
+};
+
+#if !UE_BUILD_SHIPPING
+
+// Runs Func for at least a quarter of a second and returns the throughput over Bytes per run, in GB/s
+template<typename FuncType>
+FORCEINLINE double LinkProtoMeasureThroughput(int64 Bytes, FuncType&& Func)
+{
+	Func();
+	int32 Runs = 0;
+	const double Start = FPlatformTime::Seconds();
+	double Elapsed = 0;
+	do
+	{
+		Func();
+		++Runs;
+		Elapsed = FPlatformTime::Seconds() - Start;
+	}
+	while (Elapsed < 0.25);
+	return static_cast<double>(Bytes) * Runs / Elapsed / 1e9;
+}
+
+#endif
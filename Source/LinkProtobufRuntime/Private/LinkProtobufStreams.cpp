@@ -0,0 +1,336 @@
+// Copyright DarkestLink-Dev 2025 All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// SPDX-License-Identifier: Apache-2.0
+
+
+#include "LinkProtobufStreams.h"
+#include "LinkProtobufCompat.h"
+#include "Serialization/Archive.h"
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Block input
+// ---------------------------------------------------------------------------------------------------------------------
+
+FLinkProtoBlockInputStream::FLinkProtoBlockInputStream(TConstArrayView<uint8> Block)
+{
+	AddBlock(Block);
+}
+
+FLinkProtoBlockInputStream::FLinkProtoBlockInputStream(TConstArrayView<TConstArrayView<uint8>> InBlocks)
+{
+	for (TConstArrayView<uint8> Block : InBlocks)
+	{
+		AddBlock(Block);
+	}
+}
+
+void FLinkProtoBlockInputStream::AddBlock(TConstArrayView<uint8> Block)
+{
+	if (Block.Num() > 0)
+	{
+		Blocks.Add(Block);
+	}
+}
+
+bool FLinkProtoBlockInputStream::Next(const void** Data, int* Size)
+{
+	while (BlockIndex < Blocks.Num() && BlockOffset == Blocks[BlockIndex].Num())
+	{
+		++BlockIndex;
+		BlockOffset = 0;
+	}
+	if (BlockIndex == Blocks.Num())
+	{
+		return false;
+	}
+	const TConstArrayView<uint8> Block = Blocks[BlockIndex];
+	*Data = Block.GetData() + BlockOffset;
+	*Size = Block.Num() - BlockOffset;
+	Position += *Size;
+	BlockOffset = Block.Num();
+	return true;
+}
+
+void FLinkProtoBlockInputStream::BackUp(int Count)
+{
+	// Only valid right after Next, so the bytes belong to the current block
+	check(BlockIndex < Blocks.Num() && Count >= 0 && Count <= BlockOffset);
+	BlockOffset -= Count;
+	Position -= Count;
+}
+
+bool FLinkProtoBlockInputStream::Skip(int Count)
+{
+	while (Count > 0)
+	{
+		const void* Data;
+		int Size;
+		if (!Next(&Data, &Size))
+		{
+			return false;
+		}
+		if (Size > Count)
+		{
+			BackUp(Size - Count);
+			return true;
+		}
+		Count -= Size;
+	}
+	return true;
+}
+
+int64_t FLinkProtoBlockInputStream::ByteCount() const
+{
+	return Position;
+}
+
+FLinkProtoCompositeBufferInputStream::FLinkProtoCompositeBufferInputStream(FCompositeBuffer InBuffer)
+	: Buffer(MoveTemp(InBuffer))
+{
+	// The segments are shared, their memory stays where it is while Buffer references it
+	for (const FSharedBuffer& Segment : Buffer.GetSegments())
+	{
+		const uint8* Data = static_cast<const uint8*>(Segment.GetData());
+		for (uint64 Offset = 0; Offset < Segment.GetSize(); Offset += MAX_int32)
+		{
+			AddBlock(MakeArrayView(Data + Offset, static_cast<int32>(FMath::Min<uint64>(Segment.GetSize() - Offset, MAX_int32))));
+		}
+	}
+}
+
+FLinkProtoCompositeBufferInputStream::FLinkProtoCompositeBufferInputStream(FSharedBuffer InBuffer)
+	: FLinkProtoCompositeBufferInputStream(FCompositeBuffer(MoveTemp(InBuffer)))
+{
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Archive input
+// ---------------------------------------------------------------------------------------------------------------------
+
+FLinkProtoArchiveInputStream::FLinkProtoArchiveInputStream(FArchive& InArchive, int64 Length, int32 InBlockSize)
+	: Archive(InArchive)
+	, BlockSize(FMath::Max(InBlockSize, 1))
+	, Remaining(Length)
+{
+	check(Archive.IsLoading());
+	if (Remaining < 0)
+	{
+		Remaining = FMath::Max<int64>(Archive.TotalSize() - Archive.Tell(), 0);
+	}
+	Buffer.SetNumUninitialized(static_cast<int32>(FMath::Min<int64>(BlockSize, Remaining)));
+}
+
+bool FLinkProtoArchiveInputStream::Next(const void** Data, int* Size)
+{
+	if (BackedUp > 0)
+	{
+		*Data = Buffer.GetData() + Buffer.Num() - BackedUp;
+		*Size = BackedUp;
+		Position += BackedUp;
+		BackedUp = 0;
+		return true;
+	}
+	if (Remaining <= 0 || Archive.IsError())
+	{
+		return false;
+	}
+
+	const int32 Count = static_cast<int32>(FMath::Min<int64>(Remaining, BlockSize));
+	Buffer.SetNumUninitialized(Count, LINKPROTO_NO_SHRINK);
+	Archive.Serialize(Buffer.GetData(), Count);
+	if (Archive.IsError())
+	{
+		Remaining = 0;
+		return false;
+	}
+	Remaining -= Count;
+	*Data = Buffer.GetData();
+	*Size = Count;
+	Position += Count;
+	return true;
+}
+
+void FLinkProtoArchiveInputStream::BackUp(int Count)
+{
+	check(Count >= 0 && BackedUp + Count <= Buffer.Num());
+	BackedUp += Count;
+	Position -= Count;
+}
+
+bool FLinkProtoArchiveInputStream::Skip(int Count)
+{
+	while (Count > 0)
+	{
+		const void* Data;
+		int Size;
+		if (!Next(&Data, &Size))
+		{
+			return false;
+		}
+		if (Size > Count)
+		{
+			BackUp(Size - Count);
+			return true;
+		}
+		Count -= Size;
+	}
+	return true;
+}
+
+int64_t FLinkProtoArchiveInputStream::ByteCount() const
+{
+	return Position;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Archive output
+// ---------------------------------------------------------------------------------------------------------------------
+
+FLinkProtoArchiveOutputStream::FLinkProtoArchiveOutputStream(FArchive& InArchive, int32 InBlockSize)
+	: Archive(InArchive)
+{
+	check(Archive.IsSaving());
+	Buffer.SetNumUninitialized(FMath::Max(InBlockSize, 1));
+}
+
+FLinkProtoArchiveOutputStream::~FLinkProtoArchiveOutputStream()
+{
+	Flush();
+}
+
+bool FLinkProtoArchiveOutputStream::Flush()
+{
+	if (Used > 0)
+	{
+		Archive.Serialize(Buffer.GetData(), Used);
+		Used = 0;
+	}
+	return !Archive.IsError();
+}
+
+bool FLinkProtoArchiveOutputStream::Next(void** Data, int* Size)
+{
+	if (!Flush())
+	{
+		return false;
+	}
+	Used = Buffer.Num();
+	*Data = Buffer.GetData();
+	*Size = Used;
+	Position += Used;
+	return true;
+}
+
+void FLinkProtoArchiveOutputStream::BackUp(int Count)
+{
+	check(Count >= 0 && Count <= Used);
+	Used -= Count;
+	Position -= Count;
+}
+
+int64_t FLinkProtoArchiveOutputStream::ByteCount() const
+{
+	return Position;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Array output
+// ---------------------------------------------------------------------------------------------------------------------
+
+FLinkProtoArrayOutputStream::FLinkProtoArrayOutputStream(TArray<uint8>& InBytes, int32 InMinBlockSize)
+	: Bytes(InBytes)
+	, StartNum(InBytes.Num())
+	, MinBlockSize(FMath::Max(InMinBlockSize, 1))
+{
+}
+
+bool FLinkProtoArrayOutputStream::Next(void** Data, int* Size)
+{
+	const int32 OldNum = Bytes.Num();
+	// Hand out the existing slack first, then double the array
+	int32 Grow = Bytes.Max() - OldNum;
+	if (Grow <= 0)
+	{
+		Grow = static_cast<int32>(FMath::Min<int64>(FMath::Max(OldNum, MinBlockSize), static_cast<int64>(MAX_int32) - OldNum));
+		if (Grow <= 0)
+		{
+			return false;
+		}
+	}
+	Bytes.AddUninitialized(Grow);
+	*Data = Bytes.GetData() + OldNum;
+	*Size = Grow;
+	return true;
+}
+
+void FLinkProtoArrayOutputStream::BackUp(int Count)
+{
+	check(Count >= 0 && Bytes.Num() - Count >= StartNum);
+	Bytes.SetNumUninitialized(Bytes.Num() - Count, LINKPROTO_NO_SHRINK);
+}
+
+int64_t FLinkProtoArrayOutputStream::ByteCount() const
+{
+	return Bytes.Num() - StartNum;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Block output
+// ---------------------------------------------------------------------------------------------------------------------
+
+FLinkProtoBlockOutputStream::FLinkProtoBlockOutputStream(int32 InInitialBlockSize, int32 InMaxBlockSize)
+	: NextBlockSize(FMath::Max(InInitialBlockSize, 1))
+	, MaxBlockSize(FMath::Max(InMaxBlockSize, NextBlockSize))
+{
+}
+
+bool FLinkProtoBlockOutputStream::Next(void** Data, int* Size)
+{
+	FBlock& Block = Blocks.Add_GetRef(FBlock{FUniqueBuffer::Alloc(NextBlockSize), NextBlockSize});
+	*Data = Block.Memory.GetData();
+	*Size = Block.Used;
+	Position += Block.Used;
+	NextBlockSize = FMath::Min(NextBlockSize * 2, MaxBlockSize);
+	return true;
+}
+
+void FLinkProtoBlockOutputStream::BackUp(int Count)
+{
+	check(Blocks.Num() > 0 && Count >= 0 && Count <= Blocks.Last().Used);
+	Blocks.Last().Used -= Count;
+	Position -= Count;
+}
+
+int64_t FLinkProtoBlockOutputStream::ByteCount() const
+{
+	return Position;
+}
+
+FCompositeBuffer FLinkProtoBlockOutputStream::MoveToCompositeBuffer()
+{
+	TArray<FSharedBuffer> Segments;
+	Segments.Reserve(Blocks.Num());
+	for (FBlock& Block : Blocks)
+	{
+		if (Block.Used > 0)
+		{
+			FSharedBuffer Shared = Block.Memory.MoveToShared();
+			const void* Data = Shared.GetData();
+			Segments.Add(FSharedBuffer::MakeView(Data, Block.Used, MoveTemp(Shared)));
+		}
+	}
+	Blocks.Reset();
+	Position = 0;
+	return FCompositeBuffer(MoveTemp(Segments));
+}
@@ -0,0 +1,860 @@
+// Copyright DarkestLink-Dev 2025 All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// SPDX-License-Identifier: Apache-2.0
+
+
+#include "LinkProtobufUtf8.h"
+#include "LinkProtobufCompat.h"
+#include "HAL/IConsoleManager.h"
+#include "LinkProtobufRuntime.h"
+#include "LinkProtobufSimd.h"
+#include "Math/RandomStream.h"
+
+/**
+ * One set of transcoding kernels per instruction set, they all produce exactly the same output.
+ * The vector sets work on UTF-16 code units and only speed up runs of ASCII, the rest goes through the scalar steps.
+ */
+struct FLinkProtoUtf8Kernels
+{
+	int32 (*EncodedLength)(const TCHAR* Chars, int32 Num);
+
+	// Target holds exactly EncodedLength bytes
+	uint8* (*Encode)(const TCHAR* Chars, int32 Num, uint8* Target);
+
+	// Characters valid UTF-8 decodes to, never less than what Decode writes before it finds malformed input
+	int32 (*DecodedLength)(const uint8* Data, const uint8* End);
+
+	// Returns the end of the written characters, null at the first malformed sequence
+	TCHAR* (*Decode)(const uint8* Data, const uint8* End, TCHAR* Out);
+
+	const TCHAR* Name;
+};
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Scalar steps
+// ---------------------------------------------------------------------------------------------------------------------
+
+static constexpr uint32 ReplacementCharacter = 0xFFFD;
+
+static FORCEINLINE bool IsSurrogate(uint32 CodePoint) { return (CodePoint & 0xFFFFF800u) == 0xD800u; }
+static FORCEINLINE bool IsHighSurrogate(uint32 CodePoint) { return (CodePoint & 0xFFFFFC00u) == 0xD800u; }
+static FORCEINLINE bool IsLowSurrogate(uint32 CodePoint) { return (CodePoint & 0xFFFFFC00u) == 0xDC00u; }
+
+// Reads the code point at Chars[Index] and advances past it, lone surrogates and values past U+10FFFF read as U+FFFD
+static FORCEINLINE uint32 ReadCodePoint(const TCHAR* Chars, int32& Index, int32 Num)
+{
+	const uint32 Unit = static_cast<uint32>(Chars[Index++]);
+	if (IsSurrogate(Unit))
+	{
+		if (IsHighSurrogate(Unit) && Index < Num && IsLowSurrogate(static_cast<uint32>(Chars[Index])))
+		{
+			return 0x10000 + ((Unit - 0xD800) << 10) + (static_cast<uint32>(Chars[Index++]) - 0xDC00);
+		}
+		return ReplacementCharacter;
+	}
+	return Unit <= 0x10FFFF ? Unit : ReplacementCharacter;
+}
+
+static FORCEINLINE int32 EncodedCodePointLength(uint32 CodePoint)
+{
+	return CodePoint < 0x80 ? 1 : CodePoint < 0x800 ? 2 : CodePoint < 0x10000 ? 3 : 4;
+}
+
+static FORCEINLINE uint8* WriteCodePoint(uint32 CodePoint, uint8* Target)
+{
+	if (CodePoint < 0x80)
+	{
+		*Target = static_cast<uint8>(CodePoint);
+		return Target + 1;
+	}
+	if (CodePoint < 0x800)
+	{
+		Target[0] = static_cast<uint8>(0xC0 | (CodePoint >> 6));
+		Target[1] = static_cast<uint8>(0x80 | (CodePoint & 0x3F));
+		return Target + 2;
+	}
+	if (CodePoint < 0x10000)
+	{
+		Target[0] = static_cast<uint8>(0xE0 | (CodePoint >> 12));
+		Target[1] = static_cast<uint8>(0x80 | ((CodePoint >> 6) & 0x3F));
+		Target[2] = static_cast<uint8>(0x80 | (CodePoint & 0x3F));
+		return Target + 3;
+	}
+	Target[0] = static_cast<uint8>(0xF0 | (CodePoint >> 18));
+	Target[1] = static_cast<uint8>(0x80 | ((CodePoint >> 12) & 0x3F));
+	Target[2] = static_cast<uint8>(0x80 | ((CodePoint >> 6) & 0x3F));
+	Target[3] = static_cast<uint8>(0x80 | (CodePoint & 0x3F));
+	return Target + 4;
+}
+
+/**
+ * Decodes the sequence at Data and advances past it. False, without advancing, for malformed UTF-8: stray continuation
+ * bytes, overlong forms, surrogates, values past U+10FFFF and sequences cut short by End.
+ */
+static FORCEINLINE bool DecodeCodePoint(const uint8*& Data, const uint8* End, uint32& Out)
+{
+	const uint32 Lead = *Data;
+	if (Lead < 0x80)
+	{
+		Out = Lead;
+		++Data;
+		return true;
+	}
+	int32 Extra;
+	uint32 Min;
+	if ((Lead & 0xE0) == 0xC0)      { Extra = 1; Min = 0x80;    Out = Lead & 0x1F; }
+	else if ((Lead & 0xF0) == 0xE0) { Extra = 2; Min = 0x800;   Out = Lead & 0x0F; }
+	else if ((Lead & 0xF8) == 0xF0) { Extra = 3; Min = 0x10000; Out = Lead & 0x07; }
+	else return false;
+	if (End - Data <= Extra)
+	{
+		return false;
+	}
+	for (int32 Offset = 1; Offset <= Extra; ++Offset)
+	{
+		const uint32 Continuation = Data[Offset];
+		if ((Continuation & 0xC0) != 0x80)
+		{
+			return false;
+		}
+		Out = (Out << 6) | (Continuation & 0x3F);
+	}
+	if (Out < Min || Out > 0x10FFFF || IsSurrogate(Out))
+	{
+		return false;
+	}
+	Data += Extra + 1;
+	return true;
+}
+
+static FORCEINLINE TCHAR* WriteCharacter(uint32 CodePoint, TCHAR* Out)
+{
+	if (sizeof(TCHAR) == sizeof(UTF16CHAR) && CodePoint >= 0x10000)
+	{
+		CodePoint -= 0x10000;
+		Out[0] = static_cast<TCHAR>(0xD800 + (CodePoint >> 10));
+		Out[1] = static_cast<TCHAR>(0xDC00 + (CodePoint & 0x3FF));
+		return Out + 2;
+	}
+	*Out = static_cast<TCHAR>(CodePoint);
+	return Out + 1;
+}
+
+// Characters a byte decodes to: continuation bytes add nothing, 4 byte leads a surrogate pair on UTF-16 TCHARs
+static FORCEINLINE int32 DecodedByteLength(uint8 Byte)
+{
+	return ((Byte & 0xC0) != 0x80) + (sizeof(TCHAR) == sizeof(UTF16CHAR) && Byte >= 0xF0);
+}
+
+// The steps below run until Index (or Data) reaches Stop. A surrogate pair or sequence starting before Stop is taken whole
+
+static FORCEINLINE int32 EncodedLengthUntil(const TCHAR* Chars, int32& Index, int32 Stop, int32 Num)
+{
+	int32 Length = 0;
+	while (Index < Stop)
+	{
+		Length += EncodedCodePointLength(ReadCodePoint(Chars, Index, Num));
+	}
+	return Length;
+}
+
+static FORCEINLINE uint8* EncodeUntil(const TCHAR* Chars, int32& Index, int32 Stop, int32 Num, uint8* Target)
+{
+	while (Index < Stop)
+	{
+		Target = WriteCodePoint(ReadCodePoint(Chars, Index, Num), Target);
+	}
+	return Target;
+}
+
+static FORCEINLINE TCHAR* DecodeUntil(const uint8*& Data, const uint8* Stop, const uint8* End, TCHAR* Out)
+{
+	while (Data < Stop)
+	{
+		uint32 CodePoint;
+		if (!DecodeCodePoint(Data, End, CodePoint))
+		{
+			return nullptr;
+		}
+		Out = WriteCharacter(CodePoint, Out);
+	}
+	return Out;
+}
+
+// Decodes malformed input with every byte that does not start a valid sequence as U+FFFD, writes at most one character per byte
+static TCHAR* DecodeLenient(const uint8* Data, const uint8* End, TCHAR* Out)
+{
+	while (Data < End)
+	{
+		uint32 CodePoint;
+		if (!DecodeCodePoint(Data, End, CodePoint))
+		{
+			CodePoint = ReplacementCharacter;
+			++Data;
+		}
+		Out = WriteCharacter(CodePoint, Out);
+	}
+	return Out;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Scalar kernels
+// ---------------------------------------------------------------------------------------------------------------------
+
+static int32 EncodedLengthScalar(const TCHAR* Chars, int32 Num)
+{
+	int32 Index = 0;
+	return EncodedLengthUntil(Chars, Index, Num, Num);
+}
+
+static uint8* EncodeScalar(const TCHAR* Chars, int32 Num, uint8* Target)
+{
+	int32 Index = 0;
+	return EncodeUntil(Chars, Index, Num, Num, Target);
+}
+
+static int32 DecodedLengthScalar(const uint8* Data, const uint8* End)
+{
+	int32 Length = 0;
+	for (; Data < End; ++Data)
+	{
+		Length += DecodedByteLength(*Data);
+	}
+	return Length;
+}
+
+static TCHAR* DecodeScalar(const uint8* Data, const uint8* End, TCHAR* Out)
+{
+	return DecodeUntil(Data, End, End, Out);
+}
+
+static const FLinkProtoUtf8Kernels ScalarKernels = { &EncodedLengthScalar, &EncodeScalar, &DecodedLengthScalar, &DecodeScalar, TEXT("Scalar") };
+
+// ---------------------------------------------------------------------------------------------------------------------
+// x86_64 kernels
+// ---------------------------------------------------------------------------------------------------------------------
+
+#if LINKPROTO_SIMD_X86
+
+// SSE2 is part of every x86_64 CPU, no target attribute needed
+
+static int32 EncodedLengthSse2(const TCHAR* Chars, int32 Num)
+{
+	const __m128i Zero = _mm_setzero_si128();
+	const __m128i AsciiBits = _mm_set1_epi16(static_cast<int16>(0xFF80));
+	const __m128i HighBits = _mm_set1_epi16(static_cast<int16>(0xF800));
+	const __m128i SurrogateBits = _mm_set1_epi16(static_cast<int16>(0xD800));
+	int32 Length = 0;
+	int32 Index = 0;
+	while (Num - Index >= 8)
+	{
+		const __m128i Units = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Chars + Index));
+		const __m128i High = _mm_and_si128(Units, HighBits);
+		if (_mm_movemask_epi8(_mm_cmpeq_epi16(High, SurrogateBits)) != 0)
+		{
+			Length += EncodedLengthUntil(Chars, Index, Index + 8, Num);
+			continue;
+		}
+		// Two mask bits per character: 1 byte for ASCII, 2 below U+0800, 3 for the rest of the BMP
+		const uint32 Ascii = static_cast<uint32>(_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(Units, AsciiBits), Zero)));
+		const uint32 Narrow = static_cast<uint32>(_mm_movemask_epi8(_mm_cmpeq_epi16(High, Zero)));
+		Length += 24 - static_cast<int32>(FMath::CountBits(Ascii) + FMath::CountBits(Narrow)) / 2;
+		Index += 8;
+	}
+	return Length + EncodedLengthUntil(Chars, Index, Num, Num);
+}
+
+static uint8* EncodeSse2(const TCHAR* Chars, int32 Num, uint8* Target)
+{
+	const __m128i Zero = _mm_setzero_si128();
+	const __m128i AsciiBits = _mm_set1_epi16(static_cast<int16>(0xFF80));
+	int32 Index = 0;
+	while (Num - Index >= 8)
+	{
+		const __m128i Units = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Chars + Index));
+		if (_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(Units, AsciiBits), Zero)) == 0xFFFF)
+		{
+			_mm_storel_epi64(reinterpret_cast<__m128i*>(Target), _mm_packus_epi16(Units, Units));
+			Target += 8;
+			Index += 8;
+		}
+		else
+		{
+			Target = EncodeUntil(Chars, Index, Index + 8, Num, Target);
+		}
+	}
+	return EncodeUntil(Chars, Index, Num, Num, Target);
+}
+
+static int32 DecodedLengthSse2(const uint8* Data, const uint8* End)
+{
+	// As signed bytes, continuation bytes are the ones below 0xC0 and 4 byte leads the negative ones above 0xEF
+	const __m128i ContinuationLimit = _mm_set1_epi8(static_cast<char>(0xC0));
+	const __m128i FourByteLimit = _mm_set1_epi8(static_cast<char>(0xEF));
+	int32 Length = 0;
+	for (; End - Data >= 16; Data += 16)
+	{
+		const __m128i Block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Data));
+		const uint32 NonAscii = static_cast<uint32>(_mm_movemask_epi8(Block));
+		if (NonAscii == 0)
+		{
+			Length += 16;
+			continue;
+		}
+		const uint32 Continuation = static_cast<uint32>(_mm_movemask_epi8(_mm_cmplt_epi8(Block, ContinuationLimit)));
+		const uint32 FourByte = static_cast<uint32>(_mm_movemask_epi8(_mm_cmpgt_epi8(Block, FourByteLimit))) & NonAscii;
+		Length += 16 - static_cast<int32>(FMath::CountBits(Continuation)) + static_cast<int32>(FMath::CountBits(FourByte));
+	}
+	return Length + DecodedLengthScalar(Data, End);
+}
+
+static TCHAR* DecodeSse2(const uint8* Data, const uint8* End, TCHAR* Out)
+{
+	const __m128i Zero = _mm_setzero_si128();
+	while (End - Data >= 16)
+	{
+		const __m128i Block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Data));
+		if (_mm_movemask_epi8(Block) == 0)
+		{
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(Out), _mm_unpacklo_epi8(Block, Zero));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(Out + 8), _mm_unpackhi_epi8(Block, Zero));
+			Data += 16;
+			Out += 16;
+		}
+		else if (!(Out = DecodeUntil(Data, Data + 16, End, Out)))
+		{
+			return nullptr;
+		}
+	}
+	return DecodeUntil(Data, End, End, Out);
+}
+
+LINKPROTO_TARGET_AVX2 static int32 EncodedLengthAvx2(const TCHAR* Chars, int32 Num)
+{
+	const __m256i Zero = _mm256_setzero_si256();
+	const __m256i AsciiBits = _mm256_set1_epi16(static_cast<int16>(0xFF80));
+	const __m256i HighBits = _mm256_set1_epi16(static_cast<int16>(0xF800));
+	const __m256i SurrogateBits = _mm256_set1_epi16(static_cast<int16>(0xD800));
+	int32 Length = 0;
+	int32 Index = 0;
+	while (Num - Index >= 16)
+	{
+		const __m256i Units = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(Chars + Index));
+		const __m256i High = _mm256_and_si256(Units, HighBits);
+		if (_mm256_movemask_epi8(_mm256_cmpeq_epi16(High, SurrogateBits)) != 0)
+		{
+			Length += EncodedLengthUntil(Chars, Index, Index + 16, Num);
+			continue;
+		}
+		const uint32 Ascii = static_cast<uint32>(_mm256_movemask_epi8(_mm256_cmpeq_epi16(_mm256_and_si256(Units, AsciiBits), Zero)));
+		const uint32 Narrow = static_cast<uint32>(_mm256_movemask_epi8(_mm256_cmpeq_epi16(High, Zero)));
+		Length += 48 - static_cast<int32>(FMath::CountBits(Ascii) + FMath::CountBits(Narrow)) / 2;
+		Index += 16;
+	}
+	return Length + EncodedLengthSse2(Chars + Index, Num - Index);
+}
+
+LINKPROTO_TARGET_AVX2 static uint8* EncodeAvx2(const TCHAR* Chars, int32 Num, uint8* Target)
+{
+	const __m256i Zero = _mm256_setzero_si256();
+	const __m256i AsciiBits = _mm256_set1_epi16(static_cast<int16>(0xFF80));
+	int32 Index = 0;
+	while (Num - Index >= 16)
+	{
+		const __m256i Units = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(Chars + Index));
+		if (static_cast<uint32>(_mm256_movemask_epi8(_mm256_cmpeq_epi16(_mm256_and_si256(Units, AsciiBits), Zero))) == 0xFFFFFFFFu)
+		{
+			// Packing works per 128 bit lane, the permute moves the second lane's bytes next to the first's
+			const __m256i Packed = _mm256_permute4x64_epi64(_mm256_packus_epi16(Units, Units), 0xD8);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(Target), _mm256_castsi256_si128(Packed));
+			Target += 16;
+			Index += 16;
+		}
+		else
+		{
+			Target = EncodeUntil(Chars, Index, Index + 16, Num, Target);
+		}
+	}
+	return EncodeSse2(Chars + Index, Num - Index, Target);
+}
+
+LINKPROTO_TARGET_AVX2 static int32 DecodedLengthAvx2(const uint8* Data, const uint8* End)
+{
+	const __m256i ContinuationLimit = _mm256_set1_epi8(static_cast<char>(0xC0));
+	const __m256i FourByteLimit = _mm256_set1_epi8(static_cast<char>(0xEF));
+	int32 Length = 0;
+	for (; End - Data >= 32; Data += 32)
+	{
+		const __m256i Block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(Data));
+		const uint32 NonAscii = static_cast<uint32>(_mm256_movemask_epi8(Block));
+		if (NonAscii == 0)
+		{
+			Length += 32;
+			continue;
+		}
+		const uint32 Continuation = static_cast<uint32>(_mm256_movemask_epi8(_mm256_cmpgt_epi8(ContinuationLimit, Block)));
+		const uint32 FourByte = static_cast<uint32>(_mm256_movemask_epi8(_mm256_cmpgt_epi8(Block, FourByteLimit))) & NonAscii;
+		Length += 32 - static_cast<int32>(FMath::CountBits(Continuation)) + static_cast<int32>(FMath::CountBits(FourByte));
+	}
+	return Length + DecodedLengthSse2(Data, End);
+}
+
+LINKPROTO_TARGET_AVX2 static TCHAR* DecodeAvx2(const uint8* Data, const uint8* End, TCHAR* Out)
+{
+	while (End - Data >= 32)
+	{
+		const __m256i Block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(Data));
+		if (_mm256_movemask_epi8(Block) == 0)
+		{
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(Out), _mm256_cvtepu8_epi16(_mm256_castsi256_si128(Block)));
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(Out + 16), _mm256_cvtepu8_epi16(_mm256_extracti128_si256(Block, 1)));
+			Data += 32;
+			Out += 32;
+		}
+		else if (!(Out = DecodeUntil(Data, Data + 32, End, Out)))
+		{
+			return nullptr;
+		}
+	}
+	return DecodeSse2(Data, End, Out);
+}
+
+static const FLinkProtoUtf8Kernels Sse2Kernels = { &EncodedLengthSse2, &EncodeSse2, &DecodedLengthSse2, &DecodeSse2, TEXT("SSE2") };
+static const FLinkProtoUtf8Kernels Avx2Kernels = { &EncodedLengthAvx2, &EncodeAvx2, &DecodedLengthAvx2, &DecodeAvx2, TEXT("AVX2") };
+
+#endif
+
+// ---------------------------------------------------------------------------------------------------------------------
+// arm64 kernels
+// ---------------------------------------------------------------------------------------------------------------------
+
+#if LINKPROTO_SIMD_NEON
+
+static int32 EncodedLengthNeon(const TCHAR* Chars, int32 Num)
+{
+	const uint16x8_t Zero = vdupq_n_u16(0);
+	int32 Length = 0;
+	int32 Index = 0;
+	while (Num - Index >= 8)
+	{
+		const uint16x8_t Units = vld1q_u16(reinterpret_cast<const uint16*>(Chars + Index));
+		const uint16x8_t High = vandq_u16(Units, vdupq_n_u16(0xF800));
+		if (vmaxvq_u16(vceqq_u16(High, vdupq_n_u16(0xD800))) != 0)
+		{
+			Length += EncodedLengthUntil(Chars, Index, Index + 8, Num);
+			continue;
+		}
+		// 1 byte for ASCII, 2 below U+0800, 3 for the rest of the BMP
+		const uint16x8_t Ascii = vshrq_n_u16(vceqq_u16(vandq_u16(Units, vdupq_n_u16(0xFF80)), Zero), 15);
+		const uint16x8_t Narrow = vshrq_n_u16(vceqq_u16(High, Zero), 15);
+		Length += 24 - static_cast<int32>(vaddvq_u16(vaddq_u16(Ascii, Narrow)));
+		Index += 8;
+	}
+	return Length + EncodedLengthUntil(Chars, Index, Num, Num);
+}
+
+static uint8* EncodeNeon(const TCHAR* Chars, int32 Num, uint8* Target)
+{
+	int32 Index = 0;
+	while (Num - Index >= 8)
+	{
+		const uint16x8_t Units = vld1q_u16(reinterpret_cast<const uint16*>(Chars + Index));
+		if (vmaxvq_u16(Units) < 0x80)
+		{
+			vst1_u8(Target, vmovn_u16(Units));
+			Target += 8;
+			Index += 8;
+		}
+		else
+		{
+			Target = EncodeUntil(Chars, Index, Index + 8, Num, Target);
+		}
+	}
+	return EncodeUntil(Chars, Index, Num, Num, Target);
+}
+
+static int32 DecodedLengthNeon(const uint8* Data, const uint8* End)
+{
+	int32 Length = 0;
+	for (; End - Data >= 16; Data += 16)
+	{
+		const uint8x16_t Block = vld1q_u8(Data);
+		if (vmaxvq_u8(Block) < 0x80)
+		{
+			Length += 16;
+			continue;
+		}
+		const uint8x16_t Continuation = vceqq_u8(vandq_u8(Block, vdupq_n_u8(0xC0)), vdupq_n_u8(0x80));
+		const uint8x16_t FourByte = vcgeq_u8(Block, vdupq_n_u8(0xF0));
+		Length += 16 - static_cast<int32>(vaddvq_u8(vshrq_n_u8(Continuation, 7))) + static_cast<int32>(vaddvq_u8(vshrq_n_u8(FourByte, 7)));
+	}
+	return Length + DecodedLengthScalar(Data, End);
+}
+
+static TCHAR* DecodeNeon(const uint8* Data, const uint8* End, TCHAR* Out)
+{
+	while (End - Data >= 16)
+	{
+		const uint8x16_t Block = vld1q_u8(Data);
+		if (vmaxvq_u8(Block) < 0x80)
+		{
+			vst1q_u16(reinterpret_cast<uint16*>(Out), vmovl_u8(vget_low_u8(Block)));
+			vst1q_u16(reinterpret_cast<uint16*>(Out + 8), vmovl_high_u8(Block));
+			Data += 16;
+			Out += 16;
+		}
+		else if (!(Out = DecodeUntil(Data, Data + 16, End, Out)))
+		{
+			return nullptr;
+		}
+	}
+	return DecodeUntil(Data, End, End, Out);
+}
+
+static const FLinkProtoUtf8Kernels NeonKernels = { &EncodedLengthNeon, &EncodeNeon, &DecodedLengthNeon, &DecodeNeon, TEXT("NEON") };
+
+#endif
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Dispatch
+// ---------------------------------------------------------------------------------------------------------------------
+
+// Every kernel set the running CPU can execute, scalar first
+static TArray<const FLinkProtoUtf8Kernels*> GetAvailableUtf8Kernels()
+{
+	TArray<const FLinkProtoUtf8Kernels*> Available;
+	Available.Add(&ScalarKernels);
+	// The vector kernels load TCHARs as UTF-16 code units
+	if (sizeof(TCHAR) == sizeof(UTF16CHAR))
+	{
+#if LINKPROTO_SIMD_X86
+		Available.Add(&Sse2Kernels);
+		if (FLinkProtoCpuFeatures::Get().bAvx2)
+		{
+			Available.Add(&Avx2Kernels);
+		}
+#elif LINKPROTO_SIMD_NEON
+		Available.Add(&NeonKernels);
+#endif
+	}
+	return Available;
+}
+
+static const FLinkProtoUtf8Kernels& SelectUtf8Kernels()
+{
+	const FLinkProtoUtf8Kernels* Best = GetAvailableUtf8Kernels().Last();
+	UE_LOG(LogProto, Log, TEXT("Proto UTF-8 kernels: %s"), Best->Name);
+	return *Best;
+}
+
+static const FLinkProtoUtf8Kernels& GetUtf8Kernels()
+{
+	static const FLinkProtoUtf8Kernels& Selected = SelectUtf8Kernels();
+	return Selected;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// FLinkProtoUtf8
+// ---------------------------------------------------------------------------------------------------------------------
+
+int32 FLinkProtoUtf8::EncodedLength(const TCHAR* Chars, int32 Num)
+{
+	return Num > 0 ? GetUtf8Kernels().EncodedLength(Chars, Num) : 0;
+}
+
+uint8* FLinkProtoUtf8::Encode(const TCHAR* Chars, int32 Num, uint8* Target)
+{
+	return Num > 0 ? GetUtf8Kernels().Encode(Chars, Num, Target) : Target;
+}
+
+void FLinkProtoUtf8::Encode(const TCHAR* Chars, int32 Num, std::string& Out)
+{
+	const FLinkProtoUtf8Kernels& Kernels = GetUtf8Kernels();
+	const int32 Length = Num > 0 ? Kernels.EncodedLength(Chars, Num) : 0;
+	Out.resize(Length);
+	if (Length > 0)
+	{
+		Kernels.Encode(Chars, Num, reinterpret_cast<uint8*>(&Out[0]));
+	}
+}
+
+// Decodes into Chars, sized to exactly the decoded characters plus Extra. Malformed input is decoded a second time,
+// leniently, into a buffer of one character per byte
+template<typename ArrayType>
+static bool DecodeInto(const ANSICHAR* Utf8, int32 Len, ArrayType& Chars, int32 Extra)
+{
+	const uint8* Data = reinterpret_cast<const uint8*>(Utf8);
+	const uint8* End = Data + Len;
+	const FLinkProtoUtf8Kernels& Kernels = GetUtf8Kernels();
+	Chars.SetNumUninitialized(Kernels.DecodedLength(Data, End) + Extra, LINKPROTO_NO_SHRINK);
+	const TCHAR* Written = Kernels.Decode(Data, End, Chars.GetData());
+	const bool bValid = Written != nullptr;
+	if (!bValid)
+	{
+		Chars.SetNumUninitialized(Len + Extra, LINKPROTO_NO_SHRINK);
+		Written = DecodeLenient(Data, End, Chars.GetData());
+	}
+	Chars.SetNumUninitialized(static_cast<int32>(Written - Chars.GetData()) + Extra, LINKPROTO_NO_SHRINK);
+	return bValid;
+}
+
+bool FLinkProtoUtf8::Decode(const ANSICHAR* Utf8, int32 Len, FString& Out)
+{
+	if (Len <= 0)
+	{
+		Out.Reset();
+		return true;
+	}
+	// Written straight into the string's allocation, one extra character for the terminator
+	TArray<TCHAR>& Chars = Out.GetCharArray();
+	const bool bValid = DecodeInto(Utf8, Len, Chars, 1);
+	Chars.Last() = TEXT('\0');
+	return bValid;
+}
+
+bool FLinkProtoUtf8::Decode(const ANSICHAR* Utf8, int32 Len, FName& Out)
+{
+	TArray<TCHAR, TInlineAllocator<NAME_SIZE>> Chars;
+	const bool bValid = Len <= 0 || DecodeInto(Utf8, Len, Chars, 0);
+	Out = FName(Chars.Num(), Chars.GetData());
+	return bValid;
+}
+
+bool FLinkProtoUtf8::Decode(const ANSICHAR* Utf8, int32 Len, FText& Out)
+{
+	FString Str;
+	const bool bValid = Decode(Utf8, Len, Str);
+	Out = FText::FromString(MoveTemp(Str));
+	return bValid;
+}
+
+// Bytes before the first non-ASCII one, eight at a time
+static FORCEINLINE int32 AsciiPrefixLength(const uint8* Data, int32 Len)
+{
+	int32 Index = 0;
+	for (; Index + 8 <= Len; Index += 8)
+	{
+		uint64 Word;
+		FMemory::Memcpy(&Word, Data + Index, sizeof(Word));
+		if (Word & 0x8080808080808080ull)
+		{
+			break;
+		}
+	}
+	while (Index < Len && Data[Index] < 0x80)
+	{
+		++Index;
+	}
+	return Index;
+}
+
+bool FLinkProtoUtf8::IsValid(const ANSICHAR* Utf8, int32 Len)
+{
+	const uint8* Data = reinterpret_cast<const uint8*>(Utf8);
+	const uint8* End = Data + FMath::Max(Len, 0);
+	while (Data < End)
+	{
+		Data += AsciiPrefixLength(Data, static_cast<int32>(End - Data));
+		uint32 CodePoint;
+		if (Data < End && !DecodeCodePoint(Data, End, CodePoint))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+bool FLinkProtoUtf8::Decode(const ANSICHAR* Utf8, int32 Len, TArray<uint8>& Out, bool bValidate)
+{
+	Len = FMath::Max(Len, 0);
+	Out.SetNumUninitialized(Len, LINKPROTO_NO_SHRINK);
+	if (Len > 0)
+	{
+		FMemory::Memcpy(Out.GetData(), Utf8, Len);
+	}
+	return !bValidate || IsValid(Utf8, Len);
+}
+
+int32 FLinkProtoUtf8::Latin1EncodedLength(const ANSICHAR* Chars, int32 Num)
+{
+	const uint8* Data = reinterpret_cast<const uint8*>(Chars);
+	int32 Length = Num;
+	for (int32 Index = AsciiPrefixLength(Data, Num); Index < Num; ++Index)
+	{
+		Length += Data[Index] >> 7;
+	}
+	return Length;
+}
+
+uint8* FLinkProtoUtf8::EncodeLatin1(const ANSICHAR* Chars, int32 Num, uint8* Target)
+{
+	const uint8* Data = reinterpret_cast<const uint8*>(Chars);
+	const int32 Ascii = AsciiPrefixLength(Data, Num);
+	if (Ascii > 0)
+	{
+		FMemory::Memcpy(Target, Data, Ascii);
+		Target += Ascii;
+	}
+	for (int32 Index = Ascii; Index < Num; ++Index)
+	{
+		Target = WriteCodePoint(Data[Index], Target);
+	}
+	return Target;
+}
+
+void FLinkProtoUtf8::EncodeLatin1(const ANSICHAR* Chars, int32 Num, std::string& Out)
+{
+	const int32 Length = Num > 0 ? Latin1EncodedLength(Chars, Num) : 0;
+	Out.resize(Length);
+	if (Length > 0)
+	{
+		EncodeLatin1(Chars, Num, reinterpret_cast<uint8*>(&Out[0]));
+	}
+}
+
+#if LINKPROTO_WITH_UTF8_STRING_PROPERTIES
+
+bool FLinkProtoUtf8::Decode(const ANSICHAR* Utf8, int32 Len, FUtf8String& Out, bool bValidate)
+{
+	if (Len <= 0)
+	{
+		Out.Reset();
+		return true;
+	}
+	// Copied straight into the string's allocation, one extra character for the terminator
+	TArray<UTF8CHAR>& Chars = Out.GetCharArray();
+	Chars.SetNumUninitialized(Len + 1, LINKPROTO_NO_SHRINK);
+	FMemory::Memcpy(Chars.GetData(), Utf8, Len);
+	Chars[Len] = UTF8CHAR(0);
+	return !bValidate || IsValid(Utf8, Len);
+}
+
+bool FLinkProtoUtf8::Decode(const ANSICHAR* Utf8, int32 Len, FAnsiString& Out)
+{
+	if (Len <= 0)
+	{
+		Out.Reset();
+		return true;
+	}
+	const uint8* Data = reinterpret_cast<const uint8*>(Utf8);
+	const uint8* End = Data + Len;
+	// Never more characters than bytes, the ASCII prefix is copied as is
+	TArray<ANSICHAR>& Chars = Out.GetCharArray();
+	Chars.SetNumUninitialized(Len + 1, LINKPROTO_NO_SHRINK);
+	const int32 Ascii = AsciiPrefixLength(Data, Len);
+	FMemory::Memcpy(Chars.GetData(), Data, Ascii);
+	ANSICHAR* Write = Chars.GetData() + Ascii;
+	Data += Ascii;
+	bool bValid = true;
+	while (Data < End)
+	{
+		uint32 CodePoint;
+		if (!DecodeCodePoint(Data, End, CodePoint))
+		{
+			bValid = false;
+			CodePoint = '?';
+			++Data;
+		}
+		*Write++ = static_cast<ANSICHAR>(CodePoint <= 0xFF ? CodePoint : '?');
+	}
+	*Write++ = '\0';
+	Chars.SetNumUninitialized(static_cast<int32>(Write - Chars.GetData()), LINKPROTO_NO_SHRINK);
+	return bValid;
+}
+
+#endif
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Benchmark
+// ---------------------------------------------------------------------------------------------------------------------
+
+#if !UE_BUILD_SHIPPING
+
+// Checks every kernel set against the scalar one and logs its throughput over the UTF-8 bytes for a few scripts
+static void RunUtf8Benchmark(const TArray<FString>& Args)
+{
+	const int32 NumChars = FMath::Clamp(Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 1 << 20, 1024, 16 << 20);
+	struct FScript
+	{
+		const TCHAR* Name;
+		// Code point range most characters are drawn from, one in eight is taken from the next script instead
+		uint32 First;
+		uint32 Last;
+	};
+	const FScript Scripts[] = {
+		{ TEXT("ASCII"), 0x20, 0x7E },
+		{ TEXT("Latin"), 0xC0, 0x17F },
+		{ TEXT("CJK"), 0x4E00, 0x9FFF },
+		{ TEXT("emoji"), 0x1F600, 0x1F64F } };
+	const int32 NumScripts = UE_ARRAY_COUNT(Scripts);
+
+	FRandomStream Random(0x5EED);
+	const FLinkProtoUtf8Kernels& Reference = ScalarKernels;
+	for (int32 ScriptIndex = 0; ScriptIndex < NumScripts; ++ScriptIndex)
+	{
+		FString Text;
+		Text.Reserve(NumChars * 2);
+		for (int32 CharIndex = 0; CharIndex < NumChars; ++CharIndex)
+		{
+			const FScript& Script = Scripts[Random.RandRange(0, 7) == 0 ? (ScriptIndex + 1) % NumScripts : ScriptIndex];
+			TCHAR Units[2];
+			const int32 NumUnits = static_cast<int32>(WriteCharacter(Script.First + Random.RandRange(0, Script.Last - Script.First), Units) - Units);
+			Text.AppendChars(Units, NumUnits);
+		}
+
+		TArray<uint8> Encoded;
+		Encoded.SetNumUninitialized(Reference.EncodedLength(*Text, Text.Len()));
+		Reference.Encode(*Text, Text.Len(), Encoded.GetData());
+		const uint8* EncodedEnd = Encoded.GetData() + Encoded.Num();
+		TArray<uint8> Reencoded;
+		TArray<TCHAR> Decoded;
+
+		for (const FLinkProtoUtf8Kernels* Kernels : GetAvailableUtf8Kernels())
+		{
+			Reencoded.SetNumZeroed(Encoded.Num());
+			Decoded.SetNumZeroed(Text.Len());
+			const bool bEncodeOk = Kernels->EncodedLength(*Text, Text.Len()) == Encoded.Num()
+				&& Kernels->Encode(*Text, Text.Len(), Reencoded.GetData()) == Reencoded.GetData() + Reencoded.Num()
+				&& Reencoded == Encoded;
+			const bool bDecodeOk = Kernels->DecodedLength(Encoded.GetData(), EncodedEnd) == Text.Len()
+				&& Kernels->Decode(Encoded.GetData(), EncodedEnd, Decoded.GetData()) == Decoded.GetData() + Decoded.Num()
+				&& FMemory::Memcmp(Decoded.GetData(), *Text, Text.Len() * sizeof(TCHAR)) == 0;
+			if (!bEncodeOk || !bDecodeOk)
+			{
+				UE_LOG(LogProto, Error, TEXT("Proto UTF-8 kernels %s disagree with the scalar kernels on %s text"), Kernels->Name, Scripts[ScriptIndex].Name);
+				continue;
+			}
+
+			const double EncodeRate = LinkProtoMeasureThroughput(Encoded.Num(), [&]()
+			{
+				Kernels->EncodedLength(*Text, Text.Len());
+				Kernels->Encode(*Text, Text.Len(), Reencoded.GetData());
+			});
+			const double DecodeRate = LinkProtoMeasureThroughput(Encoded.Num(), [&]()
+			{
+				Kernels->DecodedLength(Encoded.GetData(), EncodedEnd);
+				Kernels->Decode(Encoded.GetData(), EncodedEnd, Decoded.GetData());
+			});
+			UE_LOG(LogProto, Display, TEXT("Proto UTF-8 %-6s %-5s text: encode %6.2f GB/s, decode %6.2f GB/s (%d characters, %d bytes)"),
+				Kernels->Name, Scripts[ScriptIndex].Name, EncodeRate, DecodeRate, Text.Len(), Encoded.Num());
+		}
+	}
+}
+
+static FAutoConsoleCommand LinkProtoUtf8BenchmarkCommand(
+	TEXT("LinkProto.Utf8Benchmark"),
+	TEXT("Checks and measures the UTF-8 transcoding kernels of every instruction set this CPU supports. Usage: LinkProto.Utf8Benchmark [NumCharacters]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&RunUtf8Benchmark));
+
+#endif
@@ -0,0 +1,338 @@
+// Copyright DarkestLink-Dev 2025 All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "LinkProtobufCompat.h"
+#include "LinkProtobufConversionPlan.h"
+#include "LinkProtobufNameCache.h"
+#include "LinkProtobufRuntimeSettings.h"
+#include "LinkProtobufUtf8.h"
+#include "google/protobuf/message.h"
+#include "UObject/TextProperty.h"
+#if LINKPROTO_WITH_UTF8_STRING_PROPERTIES
+#include "UObject/AnsiStrProperty.h"
+#include "UObject/Utf8StrProperty.h"
+#endif
+
+/**
+ * Typed access to property values classified by LinkProtoClassifyProperty.
+ * Shared by the reflection converters and the wire encoder so both agree on which
+ * property types can feed which proto field types and how numbers are converted.
+ */
+struct FLinkProtoValueAccess
+{
+	// Reads any numeric/bool value as int64. Floating point values are truncated.
+	static FORCEINLINE bool ReadInt64(ELinkProtoValueType Type, const FProperty* Prop, const void* Ptr, int64& Out)
+	{
+		switch (Type)
+		{
+		case ELinkProtoValueType::Bool:   Out = static_cast<const FBoolProperty*>(Prop)->GetPropertyValue(Ptr) ? 1 : 0; return true;
+		case ELinkProtoValueType::Int8:   Out = *static_cast<const int8*>(Ptr); return true;
+		case ELinkProtoValueType::Int16:  Out = *static_cast<const int16*>(Ptr); return true;
+		case ELinkProtoValueType::Int32:  Out = *static_cast<const int32*>(Ptr); return true;
+		case ELinkProtoValueType::Int64:  Out = *static_cast<const int64*>(Ptr); return true;
+		case ELinkProtoValueType::UInt8:  Out = *static_cast<const uint8*>(Ptr); return true;
+		case ELinkProtoValueType::UInt16: Out = *static_cast<const uint16*>(Ptr); return true;
+		case ELinkProtoValueType::UInt32: Out = *static_cast<const uint32*>(Ptr); return true;
+		case ELinkProtoValueType::UInt64: Out = static_cast<int64>(*static_cast<const uint64*>(Ptr)); return true;
+		case ELinkProtoValueType::Float:  Out = static_cast<int64>(*static_cast<const float*>(Ptr)); return true;
+		case ELinkProtoValueType::Double: Out = static_cast<int64>(*static_cast<const double*>(Ptr)); return true;
+		default: return false;
+		}
+	}
+
+	// Reads any numeric/bool value as double.
+	static FORCEINLINE bool ReadDouble(ELinkProtoValueType Type, const FProperty* Prop, const void* Ptr, double& Out)
+	{
+		switch (Type)
+		{
+		case ELinkProtoValueType::Float:  Out = *static_cast<const float*>(Ptr); return true;
+		case ELinkProtoValueType::Double: Out = *static_cast<const double*>(Ptr); return true;
+		case ELinkProtoValueType::UInt64: Out = static_cast<double>(*static_cast<const uint64*>(Ptr)); return true;
+		default:
+		{
+			int64 Value;
+			if (!ReadInt64(Type, Prop, Ptr, Value)) return false;
+			Out = static_cast<double>(Value);
+			return true;
+		}
+		}
+	}
+
+	// Returns the string behind a FString/FName/FText value, Scratch holds the converted FName. Null for other types.
+	static FORCEINLINE const FString* ReadString(ELinkProtoValueType Type, const void* Ptr, FString& Scratch)
+	{
+		switch (Type)
+		{
+		case ELinkProtoValueType::String: return static_cast<const FString*>(Ptr);
+		case ELinkProtoValueType::Text:   return &static_cast<const FText*>(Ptr)->ToString();
+		case ELinkProtoValueType::Name:   static_cast<const FName*>(Ptr)->ToString(Scratch); return &Scratch;
+		default: return nullptr;
+		}
+	}
+
+	// Returns the 8-bit characters behind a FUtf8String/FAnsiString/byte array value, no copy, or the cached UTF-8
+	// of a FName. False for other types and for names the cache cannot hold.
+	// Only FAnsiString characters are not UTF-8 already, they are Latin-1.
+	static FORCEINLINE bool ReadNarrowString(ELinkProtoValueType Type, const void* Ptr, const ANSICHAR*& Chars, int32& Num)
+	{
+		switch (Type)
+		{
+		case ELinkProtoValueType::Name:
+			return FLinkProtoNameCache::Get().FindOrAddUtf8(*static_cast<const FName*>(Ptr), Chars, Num);
+#if LINKPROTO_WITH_UTF8_STRING_PROPERTIES
+		case ELinkProtoValueType::Utf8String:
+		{
+			const FUtf8String& Str = *static_cast<const FUtf8String*>(Ptr);
+			Chars = reinterpret_cast<const ANSICHAR*>(*Str);
+			Num = Str.Len();
+			return true;
+		}
+		case ELinkProtoValueType::AnsiString:
+		{
+			const FAnsiString& Str = *static_cast<const FAnsiString*>(Ptr);
+			Chars = *Str;
+			Num = Str.Len();
+			return true;
+		}
+#endif
+		case ELinkProtoValueType::Utf8Bytes:
+		case ELinkProtoValueType::ByteArray:
+		{
+			const TArray<uint8>& Bytes = *static_cast<const TArray<uint8>*>(Ptr);
+			Chars = reinterpret_cast<const ANSICHAR*>(Bytes.GetData());
+			Num = Bytes.Num();
+			return true;
+		}
+		default: return false;
+		}
+	}
+
+	// Stores an integer into any numeric/bool value.
+	static FORCEINLINE bool WriteInt64(ELinkProtoValueType Type, const FProperty* Prop, void* Ptr, int64 Value)
+	{
+		switch (Type)
+		{
+		case ELinkProtoValueType::Bool:   static_cast<const FBoolProperty*>(Prop)->SetPropertyValue(Ptr, Value != 0); return true;
+		case ELinkProtoValueType::Int8:   *static_cast<int8*>(Ptr) = static_cast<int8>(Value); return true;
+		case ELinkProtoValueType::Int16:  *static_cast<int16*>(Ptr) = static_cast<int16>(Value); return true;
+		case ELinkProtoValueType::Int32:  *static_cast<int32*>(Ptr) = static_cast<int32>(Value); return true;
+		case ELinkProtoValueType::Int64:  *static_cast<int64*>(Ptr) = Value; return true;
+		case ELinkProtoValueType::UInt8:  *static_cast<uint8*>(Ptr) = static_cast<uint8>(Value); return true;
+		case ELinkProtoValueType::UInt16: *static_cast<uint16*>(Ptr) = static_cast<uint16>(Value); return true;
+		case ELinkProtoValueType::UInt32: *static_cast<uint32*>(Ptr) = static_cast<uint32>(Value); return true;
+		case ELinkProtoValueType::UInt64: *static_cast<uint64*>(Ptr) = static_cast<uint64>(Value); return true;
+		case ELinkProtoValueType::Float:  *static_cast<float*>(Ptr) = static_cast<float>(Value); return true;
+		case ELinkProtoValueType::Double: *static_cast<double*>(Ptr) = static_cast<double>(Value); return true;
+		default: return false;
+		}
+	}
+
+	// Stores a floating point number into any numeric/bool value. Integers are truncated.
+	static FORCEINLINE bool WriteDouble(ELinkProtoValueType Type, const FProperty* Prop, void* Ptr, double Value)
+	{
+		switch (Type)
+		{
+		case ELinkProtoValueType::Float:  *static_cast<float*>(Ptr) = static_cast<float>(Value); return true;
+		case ELinkProtoValueType::Double: *static_cast<double*>(Ptr) = Value; return true;
+		default: return WriteInt64(Type, Prop, Ptr, static_cast<int64>(Value));
+		}
+	}
+
+	// Stores UTF-8 text into a string-like value. False for other types and for malformed UTF-8, which is still stored:
+	// with U+FFFD in place of the malformed sequences, or as is by the values that keep UTF-8. Those only check it
+	// when bValidateUtf8Properties is set.
+	static FORCEINLINE bool WriteString(ELinkProtoValueType Type, void* Ptr, const ANSICHAR* Utf8, int32 Len)
+	{
+		switch (Type)
+		{
+		case ELinkProtoValueType::String: return FLinkProtoUtf8::Decode(Utf8, Len, *static_cast<FString*>(Ptr));
+		case ELinkProtoValueType::Name:   return FLinkProtoNameCache::Get().Decode(Utf8, Len, *static_cast<FName*>(Ptr));
+		case ELinkProtoValueType::Text:   return FLinkProtoUtf8::Decode(Utf8, Len, *static_cast<FText*>(Ptr));
+#if LINKPROTO_WITH_UTF8_STRING_PROPERTIES
+		case ELinkProtoValueType::Utf8String:
+			return FLinkProtoUtf8::Decode(Utf8, Len, *static_cast<FUtf8String*>(Ptr), ULinkProtobufRuntimeSettings::Get()->bValidateUtf8Properties);
+		case ELinkProtoValueType::AnsiString:
+			return FLinkProtoUtf8::Decode(Utf8, Len, *static_cast<FAnsiString*>(Ptr));
+#endif
+		case ELinkProtoValueType::Utf8Bytes:
+			return FLinkProtoUtf8::Decode(Utf8, Len, *static_cast<TArray<uint8>*>(Ptr), ULinkProtobufRuntimeSettings::Get()->bValidateUtf8Properties);
+		case ELinkProtoValueType::ByteArray:
+			// Payload of a bytes field, not text
+			WriteByteArray(Ptr, Utf8, Len);
+			return true;
+		default: return false;
+		}
+	}
+
+	/**
+	 * Sets a singular field, or appends one element to a repeated field, of Msg from the value at Ptr.
+	 * Message fields are not handled here. Returns false when the value cannot feed the field type or,
+	 * for enum fields, when the number is not a value of the proto enum.
+	 */
+	static bool WriteMessageField(google::protobuf::Message& Msg, const google::protobuf::FieldDescriptor* Field,
+		ELinkProtoValueType Type, const FProperty* Prop, const void* Ptr)
+	{
+		using FieldDescriptor = google::protobuf::FieldDescriptor;
+		const google::protobuf::Reflection* Refl = Msg.GetReflection();
+		const bool bAdd = Field->is_repeated();
+		int64 IntValue = 0;
+		double FloatValue = 0;
+		switch (Field->cpp_type())
+		{
+		case FieldDescriptor::CPPTYPE_INT32:
+			if (!ReadInt64(Type, Prop, Ptr, IntValue)) return false;
+			bAdd ? Refl->AddInt32(&Msg, Field, static_cast<int32>(IntValue)) : Refl->SetInt32(&Msg, Field, static_cast<int32>(IntValue));
+			return true;
+		case FieldDescriptor::CPPTYPE_INT64:
+			if (!ReadInt64(Type, Prop, Ptr, IntValue)) return false;
+			bAdd ? Refl->AddInt64(&Msg, Field, IntValue) : Refl->SetInt64(&Msg, Field, IntValue);
+			return true;
+		case FieldDescriptor::CPPTYPE_UINT32:
+			if (!ReadInt64(Type, Prop, Ptr, IntValue)) return false;
+			bAdd ? Refl->AddUInt32(&Msg, Field, static_cast<uint32>(IntValue)) : Refl->SetUInt32(&Msg, Field, static_cast<uint32>(IntValue));
+			return true;
+		case FieldDescriptor::CPPTYPE_UINT64:
+			if (!ReadInt64(Type, Prop, Ptr, IntValue)) return false;
+			bAdd ? Refl->AddUInt64(&Msg, Field, static_cast<uint64>(IntValue)) : Refl->SetUInt64(&Msg, Field, static_cast<uint64>(IntValue));
+			return true;
+		case FieldDescriptor::CPPTYPE_FLOAT:
+			if (!ReadDouble(Type, Prop, Ptr, FloatValue)) return false;
+			bAdd ? Refl->AddFloat(&Msg, Field, static_cast<float>(FloatValue)) : Refl->SetFloat(&Msg, Field, static_cast<float>(FloatValue));
+			return true;
+		case FieldDescriptor::CPPTYPE_DOUBLE:
+			if (!ReadDouble(Type, Prop, Ptr, FloatValue)) return false;
+			bAdd ? Refl->AddDouble(&Msg, Field, FloatValue) : Refl->SetDouble(&Msg, Field, FloatValue);
+			return true;
+		case FieldDescriptor::CPPTYPE_BOOL:
+			if (!ReadInt64(Type, Prop, Ptr, IntValue)) return false;
+			bAdd ? Refl->AddBool(&Msg, Field, IntValue != 0) : Refl->SetBool(&Msg, Field, IntValue != 0);
+			return true;
+		case FieldDescriptor::CPPTYPE_ENUM:
+		{
+			if (!ReadInt64(Type, Prop, Ptr, IntValue)) return false;
+			const google::protobuf::EnumValueDescriptor* EnumValue = Field->enum_type()->FindValueByNumber(static_cast<int32>(IntValue));
+			if (!EnumValue) return false;
+			bAdd ? Refl->AddEnum(&Msg, Field, EnumValue) : Refl->SetEnum(&Msg, Field, EnumValue);
+			return true;
+		}
+		case FieldDescriptor::CPPTYPE_STRING:
+		{
+			std::string Bytes;
+			const ANSICHAR* NarrowChars = nullptr;
+			int32 NarrowNum = 0;
+			if (Field->type() == FieldDescriptor::TYPE_BYTES && Type == ELinkProtoValueType::UInt8)
+			{
+				Bytes.assign(1, static_cast<char>(*static_cast<const uint8*>(Ptr)));
+			}
+			else if (Type == ELinkProtoValueType::AnsiString && ReadNarrowString(Type, Ptr, NarrowChars, NarrowNum))
+			{
+				FLinkProtoUtf8::EncodeLatin1(NarrowChars, NarrowNum, Bytes);
+			}
+			else if (ReadNarrowString(Type, Ptr, NarrowChars, NarrowNum))
+			{
+				Bytes.assign(NarrowChars, NarrowNum);
+			}
+			else
+			{
+				FString Scratch;
+				const FString* Str = ReadString(Type, Ptr, Scratch);
+				if (!Str) return false;
+				FLinkProtoUtf8::Encode(**Str, Str->Len(), Bytes);
+			}
+			bAdd ? Refl->AddString(&Msg, Field, MoveTemp(Bytes)) : Refl->SetString(&Msg, Field, MoveTemp(Bytes));
+			return true;
+		}
+		default:
+			return false;
+		}
+	}
+
+	static FORCEINLINE bool IsStringType(ELinkProtoValueType Type)
+	{
+		return Type == ELinkProtoValueType::String || Type == ELinkProtoValueType::Name || Type == ELinkProtoValueType::Text
+			|| IsNarrowStringType(Type);
+	}
+
+	// Values stored as 8-bit characters, see ReadNarrowString
+	static FORCEINLINE bool IsNarrowStringType(ELinkProtoValueType Type)
+	{
+		return Type == ELinkProtoValueType::Utf8String || Type == ELinkProtoValueType::AnsiString || Type == ELinkProtoValueType::Utf8Bytes
+			|| Type == ELinkProtoValueType::ByteArray;
+	}
+
+	// Replaces the content of a TArray<uint8> value with Len bytes, one copy
+	static FORCEINLINE void WriteByteArray(void* Ptr, const ANSICHAR* Data, int32 Len)
+	{
+		TArray<uint8>& Bytes = *static_cast<TArray<uint8>*>(Ptr);
+		Bytes.SetNumUninitialized(Len, LINKPROTO_NO_SHRINK);
+		if (Len > 0)
+		{
+			FMemory::Memcpy(Bytes.GetData(), Data, Len);
+		}
+	}
+
+	// Returns the value of Key, added default constructed when missing. A key already in the map has its value reset,
+	// a key repeated in the input replaces the earlier value as protobuf's parser does. Hashes the key once.
+	static FORCEINLINE void* FindOrAddMapValue(FScriptMapHelper& MapHelper, const FProperty* ValueProp, const void* Key)
+	{
+		const int32 NumBefore = MapHelper.Num();
+		void* ValuePtr = MapHelper.FindOrAdd(Key);
+		if (MapHelper.Num() == NumBefore)
+		{
+			ValueProp->ClearValue(ValuePtr);
+		}
+		return ValuePtr;
+	}
+};
+
+/**
+ * Storage for one map key or set element, decoded there before it is hashed once into its container.
+ * On the stack for the scalar property types proto keys and repeated scalars bind to (numbers, names, strings).
+ */
+struct FLinkProtoScalarScratch : public FNoncopyable
+{
+	explicit FLinkProtoScalarScratch(const FProperty* InProperty)
+		: Property(InProperty)
+	{
+		const bool bFits = Property->GetSize() <= sizeof(Storage) && Property->GetMinAlignment() <= 16;
+		Data = bFits ? static_cast<void*>(Storage) : FMemory::Malloc(Property->GetSize(), Property->GetMinAlignment());
+		Property->InitializeValue(Data);
+	}
+
+	~FLinkProtoScalarScratch()
+	{
+		if (!Property->HasAnyPropertyFlags(CPF_NoDestructor))
+		{
+			Property->DestroyValue(Data);
+		}
+		if (Data != Storage)
+		{
+			FMemory::Free(Data);
+		}
+	}
+
+	FORCEINLINE void* Get() { return Data; }
+
+	// Back to the default value, for a read that failed half way
+	FORCEINLINE void Reset() { Property->ClearValue(Data); }
+
+private:
+	const FProperty* Property;
+	void* Data;
+	alignas(16) uint8 Storage[32];
+};
@@ -0,0 +1,627 @@
+// Copyright DarkestLink-Dev 2025 All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// SPDX-License-Identifier: Apache-2.0
+
+
+#include "LinkProtobufVarint.h"
+#include "google/protobuf/io/coded_stream.h"
+#include "HAL/IConsoleManager.h"
+#include "LinkProtobufRuntime.h"
+#include "LinkProtobufSimd.h"
+#include "Math/RandomStream.h"
+
+using CodedOutputStream = google::protobuf::io::CodedOutputStream;
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Scalar kernels
+// ---------------------------------------------------------------------------------------------------------------------
+
+// Decodes one varint of at most 10 bytes
+static FORCEINLINE bool DecodeOne(const uint8*& Data, const uint8* End, uint64& Out)
+{
+	uint64 Result = 0;
+	for (uint32 Shift = 0; Shift < 70; Shift += 7)
+	{
+		if (Data == End)
+		{
+			return false;
+		}
+		const uint8 Byte = *Data++;
+		Result |= static_cast<uint64>(Byte & 0x7F) << Shift;
+		if ((Byte & 0x80) == 0)
+		{
+			Out = Result;
+			return true;
+		}
+	}
+	return false;
+}
+
+static int32 CountValuesScalar(const uint8* Data, const uint8* End)
+{
+	int32 Count = 0;
+	for (; Data < End; ++Data)
+	{
+		Count += (*Data & 0x80) == 0;
+	}
+	return Count;
+}
+
+static int32 DecodeScalar(const uint8*& Data, const uint8* End, uint64* Out, int32 MaxCount)
+{
+	int32 Count = 0;
+	while (Count < MaxCount && Data < End)
+	{
+		if (!DecodeOne(Data, End, Out[Count]))
+		{
+			return INDEX_NONE;
+		}
+		++Count;
+	}
+	return Count;
+}
+
+static uint64 EncodedSizeScalar(const uint64* Values, int32 Count)
+{
+	uint64 Size = 0;
+	for (int32 Index = 0; Index < Count; ++Index)
+	{
+		Size += CodedOutputStream::VarintSize64(Values[Index]);
+	}
+	return Size;
+}
+
+static uint8* EncodeScalar(const uint64* Values, int32 Count, uint8* Target)
+{
+	for (int32 Index = 0; Index < Count; ++Index)
+	{
+		Target = CodedOutputStream::WriteVarint64ToArray(Values[Index], Target);
+	}
+	return Target;
+}
+
+static const FLinkProtoVarintKernels ScalarKernels = { &CountValuesScalar, &DecodeScalar, &EncodedSizeScalar, &EncodeScalar, TEXT("Scalar") };
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Helpers shared by the vector kernels, they only ever run on little endian CPUs
+// ---------------------------------------------------------------------------------------------------------------------
+
+#if LINKPROTO_SIMD_X86 || LINKPROTO_SIMD_NEON
+
+// Values per group of the encoders, the vector part ORs the group together to find its widest value
+static constexpr int32 EncodeGroupSize = 8;
+
+// Compacts the 7 bit groups of a varint of at most 8 bytes loaded into Word, the bytes past its end must be cleared
+static FORCEINLINE uint64 FoldVarint(uint64 Word)
+{
+	Word &= 0x7F7F7F7F7F7F7F7FULL;
+	Word = ((Word & 0x7F007F007F007F00ULL) >> 1) | (Word & 0x007F007F007F007FULL);
+	Word = ((Word & 0x3FFF00003FFF0000ULL) >> 2) | (Word & 0x00003FFF00003FFFULL);
+	Word = ((Word & 0x0FFFFFFF00000000ULL) >> 4) | (Word & 0x000000000FFFFFFFULL);
+	return Word;
+}
+
+/**
+ * Decodes the varints of a block that end in it, Ends has one bit per byte without the continuation bit.
+ * Varints of up to 8 bytes are folded out of a single load. Returns the number of bytes consumed,
+ * the position after the last terminator, or INDEX_NONE for a malformed varint.
+ */
+static FORCEINLINE int32 DecodeMixedBlock(const uint8* Data, const uint8* End, uint32 Ends, uint64* Out, int32& OutNum)
+{
+	const int64 Available = End - Data;
+	int32 Pos = 0;
+	int32 Num = 0;
+	while (Ends != 0)
+	{
+		const int32 Last = static_cast<int32>(FMath::CountTrailingZeros(Ends));
+		const int32 Length = Last - Pos + 1;
+		if (Length <= 8 && Pos + 8 <= Available)
+		{
+			uint64 Word;
+			FMemory::Memcpy(&Word, Data + Pos, sizeof(Word));
+			if (Length < 8)
+			{
+				Word &= (1ULL << (Length * 8)) - 1;
+			}
+			Out[Num++] = FoldVarint(Word);
+		}
+		else
+		{
+			const uint8* Cursor = Data + Pos;
+			if (!DecodeOne(Cursor, End, Out[Num++]))
+			{
+				return INDEX_NONE;
+			}
+		}
+		Pos = Last + 1;
+		Ends &= Ends - 1;
+	}
+	OutNum = Num;
+	return Pos;
+}
+
+// Finishes a block the fast paths did not take, returns false for a malformed varint
+static FORCEINLINE bool DecodeBlockSlow(const uint8*& Data, const uint8* End, uint32 Ends, uint64* Out, int32& Count)
+{
+	int32 Num = 0;
+	const int32 Consumed = DecodeMixedBlock(Data, End, Ends, Out + Count, Num);
+	if (Consumed == INDEX_NONE)
+	{
+		return false;
+	}
+	if (Consumed == 0)
+	{
+		// No varint ends in the block, it is either longer than the block or malformed
+		if (!DecodeOne(Data, End, Out[Count]))
+		{
+			return false;
+		}
+		++Count;
+		return true;
+	}
+	Data += Consumed;
+	Count += Num;
+	return true;
+}
+
+static FORCEINLINE uint64 GroupSize(const uint64* Values, uint64 Widest)
+{
+	if (Widest < (1ULL << 7))
+	{
+		return EncodeGroupSize;
+	}
+	if (Widest < (1ULL << 14))
+	{
+		uint64 Size = EncodeGroupSize;
+		for (int32 Index = 0; Index < EncodeGroupSize; ++Index)
+		{
+			Size += Values[Index] >= 0x80;
+		}
+		return Size;
+	}
+	return EncodedSizeScalar(Values, EncodeGroupSize);
+}
+
+// Widest is the OR of the group, it has the width of its widest value
+static FORCEINLINE uint8* EncodeGroup(const uint64* Values, uint64 Widest, uint8* Target)
+{
+	if (Widest < (1ULL << 7))
+	{
+		for (int32 Index = 0; Index < EncodeGroupSize; ++Index)
+		{
+			Target[Index] = static_cast<uint8>(Values[Index]);
+		}
+		return Target + EncodeGroupSize;
+	}
+	if (Widest < (1ULL << 14))
+	{
+		// One or two bytes each, written without branches. The second byte is always stored, so the last value
+		// of the group goes through the scalar path to never touch the byte past the output
+		for (int32 Index = 0; Index < EncodeGroupSize - 1; ++Index)
+		{
+			const uint64 Value = Values[Index];
+			const uint32 bTwoBytes = Value >= 0x80;
+			Target[0] = static_cast<uint8>(Value | (bTwoBytes << 7));
+			Target[1] = static_cast<uint8>(Value >> 7);
+			Target += 1 + bTwoBytes;
+		}
+		return CodedOutputStream::WriteVarint64ToArray(Values[EncodeGroupSize - 1], Target);
+	}
+	return EncodeScalar(Values, EncodeGroupSize, Target);
+}
+
+#endif
+
+// ---------------------------------------------------------------------------------------------------------------------
+// x86_64 kernels
+// ---------------------------------------------------------------------------------------------------------------------
+
+#if LINKPROTO_SIMD_X86
+
+LINKPROTO_TARGET_SSE41 static int32 CountValuesSse41(const uint8* Data, const uint8* End)
+{
+	int32 Count = 0;
+	for (; End - Data >= 16; Data += 16)
+	{
+		const uint32 Mask = static_cast<uint32>(_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(Data))));
+		Count += 16 - static_cast<int32>(FMath::CountBits(Mask));
+	}
+	return Count + CountValuesScalar(Data, End);
+}
+
+LINKPROTO_TARGET_SSE41 static int32 DecodeSse41(const uint8*& Data, const uint8* End, uint64* Out, int32 MaxCount)
+{
+	int32 Count = 0;
+	while (End - Data >= 16 && MaxCount - Count >= 16)
+	{
+		const __m128i Block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Data));
+		const uint32 Mask = static_cast<uint32>(_mm_movemask_epi8(Block));
+		__m128i* Dst = reinterpret_cast<__m128i*>(Out + Count);
+		if (Mask == 0)
+		{
+			// Sixteen one byte varints
+			_mm_storeu_si128(Dst + 0, _mm_cvtepu8_epi64(Block));
+			_mm_storeu_si128(Dst + 1, _mm_cvtepu8_epi64(_mm_srli_si128(Block, 2)));
+			_mm_storeu_si128(Dst + 2, _mm_cvtepu8_epi64(_mm_srli_si128(Block, 4)));
+			_mm_storeu_si128(Dst + 3, _mm_cvtepu8_epi64(_mm_srli_si128(Block, 6)));
+			_mm_storeu_si128(Dst + 4, _mm_cvtepu8_epi64(_mm_srli_si128(Block, 8)));
+			_mm_storeu_si128(Dst + 5, _mm_cvtepu8_epi64(_mm_srli_si128(Block, 10)));
+			_mm_storeu_si128(Dst + 6, _mm_cvtepu8_epi64(_mm_srli_si128(Block, 12)));
+			_mm_storeu_si128(Dst + 7, _mm_cvtepu8_epi64(_mm_srli_si128(Block, 14)));
+			Data += 16;
+			Count += 16;
+		}
+		else if (Mask == 0x5555)
+		{
+			// Eight two byte varints
+			const __m128i Low = _mm_and_si128(Block, _mm_set1_epi16(0x007F));
+			const __m128i High = _mm_srli_epi16(_mm_and_si128(Block, _mm_set1_epi16(0x7F00)), 1);
+			const __m128i Values = _mm_or_si128(Low, High);
+			_mm_storeu_si128(Dst + 0, _mm_cvtepu16_epi64(Values));
+			_mm_storeu_si128(Dst + 1, _mm_cvtepu16_epi64(_mm_srli_si128(Values, 4)));
+			_mm_storeu_si128(Dst + 2, _mm_cvtepu16_epi64(_mm_srli_si128(Values, 8)));
+			_mm_storeu_si128(Dst + 3, _mm_cvtepu16_epi64(_mm_srli_si128(Values, 12)));
+			Data += 16;
+			Count += 8;
+		}
+		else if (!DecodeBlockSlow(Data, End, ~Mask & 0xFFFF, Out, Count))
+		{
+			return INDEX_NONE;
+		}
+	}
+	const int32 Tail = DecodeScalar(Data, End, Out + Count, MaxCount - Count);
+	return Tail == INDEX_NONE ? INDEX_NONE : Count + Tail;
+}
+
+LINKPROTO_TARGET_SSE41 static FORCEINLINE uint64 OrGroupSse41(const uint64* Values)
+{
+	const __m128i* Src = reinterpret_cast<const __m128i*>(Values);
+	const __m128i Or = _mm_or_si128(
+		_mm_or_si128(_mm_loadu_si128(Src + 0), _mm_loadu_si128(Src + 1)),
+		_mm_or_si128(_mm_loadu_si128(Src + 2), _mm_loadu_si128(Src + 3)));
+	return static_cast<uint64>(_mm_cvtsi128_si64(Or)) | static_cast<uint64>(_mm_extract_epi64(Or, 1));
+}
+
+LINKPROTO_TARGET_SSE41 static uint64 EncodedSizeSse41(const uint64* Values, int32 Count)
+{
+	uint64 Size = 0;
+	int32 Index = 0;
+	for (; Index + EncodeGroupSize <= Count; Index += EncodeGroupSize)
+	{
+		Size += GroupSize(Values + Index, OrGroupSse41(Values + Index));
+	}
+	return Size + EncodedSizeScalar(Values + Index, Count - Index);
+}
+
+LINKPROTO_TARGET_SSE41 static uint8* EncodeSse41(const uint64* Values, int32 Count, uint8* Target)
+{
+	int32 Index = 0;
+	for (; Index + EncodeGroupSize <= Count; Index += EncodeGroupSize)
+	{
+		Target = EncodeGroup(Values + Index, OrGroupSse41(Values + Index), Target);
+	}
+	return EncodeScalar(Values + Index, Count - Index, Target);
+}
+
+LINKPROTO_TARGET_AVX2 static int32 CountValuesAvx2(const uint8* Data, const uint8* End)
+{
+	int32 Count = 0;
+	for (; End - Data >= 32; Data += 32)
+	{
+		const uint32 Mask = static_cast<uint32>(_mm256_movemask_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(Data))));
+		Count += 32 - static_cast<int32>(FMath::CountBits(Mask));
+	}
+	return Count + CountValuesScalar(Data, End);
+}
+
+LINKPROTO_TARGET_AVX2 static int32 DecodeAvx2(const uint8*& Data, const uint8* End, uint64* Out, int32 MaxCount)
+{
+	int32 Count = 0;
+	while (End - Data >= 32 && MaxCount - Count >= 32)
+	{
+		const __m256i Block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(Data));
+		const uint32 Mask = static_cast<uint32>(_mm256_movemask_epi8(Block));
+		__m256i* Dst = reinterpret_cast<__m256i*>(Out + Count);
+		if (Mask == 0)
+		{
+			// Thirty two one byte varints
+			const __m128i Low = _mm256_castsi256_si128(Block);
+			const __m128i High = _mm256_extracti128_si256(Block, 1);
+			_mm256_storeu_si256(Dst + 0, _mm256_cvtepu8_epi64(Low));
+			_mm256_storeu_si256(Dst + 1, _mm256_cvtepu8_epi64(_mm_srli_si128(Low, 4)));
+			_mm256_storeu_si256(Dst + 2, _mm256_cvtepu8_epi64(_mm_srli_si128(Low, 8)));
+			_mm256_storeu_si256(Dst + 3, _mm256_cvtepu8_epi64(_mm_srli_si128(Low, 12)));
+			_mm256_storeu_si256(Dst + 4, _mm256_cvtepu8_epi64(High));
+			_mm256_storeu_si256(Dst + 5, _mm256_cvtepu8_epi64(_mm_srli_si128(High, 4)));
+			_mm256_storeu_si256(Dst + 6, _mm256_cvtepu8_epi64(_mm_srli_si128(High, 8)));
+			_mm256_storeu_si256(Dst + 7, _mm256_cvtepu8_epi64(_mm_srli_si128(High, 12)));
+			Data += 32;
+			Count += 32;
+		}
+		else if (Mask == 0x55555555)
+		{
+			// Sixteen two byte varints
+			const __m256i LowBits = _mm256_and_si256(Block, _mm256_set1_epi16(0x007F));
+			const __m256i HighBits = _mm256_srli_epi16(_mm256_and_si256(Block, _mm256_set1_epi16(0x7F00)), 1);
+			const __m256i Values = _mm256_or_si256(LowBits, HighBits);
+			const __m128i Low = _mm256_castsi256_si128(Values);
+			const __m128i High = _mm256_extracti128_si256(Values, 1);
+			_mm256_storeu_si256(Dst + 0, _mm256_cvtepu16_epi64(Low));
+			_mm256_storeu_si256(Dst + 1, _mm256_cvtepu16_epi64(_mm_srli_si128(Low, 8)));
+			_mm256_storeu_si256(Dst + 2, _mm256_cvtepu16_epi64(High));
+			_mm256_storeu_si256(Dst + 3, _mm256_cvtepu16_epi64(_mm_srli_si128(High, 8)));
+			Data += 32;
+			Count += 16;
+		}
+		else if (!DecodeBlockSlow(Data, End, ~Mask, Out, Count))
+		{
+			return INDEX_NONE;
+		}
+	}
+	const int32 Tail = DecodeSse41(Data, End, Out + Count, MaxCount - Count);
+	return Tail == INDEX_NONE ? INDEX_NONE : Count + Tail;
+}
+
+LINKPROTO_TARGET_AVX2 static FORCEINLINE uint64 OrGroupAvx2(const uint64* Values)
+{
+	const __m256i* Src = reinterpret_cast<const __m256i*>(Values);
+	const __m256i Or = _mm256_or_si256(_mm256_loadu_si256(Src + 0), _mm256_loadu_si256(Src + 1));
+	const __m128i Half = _mm_or_si128(_mm256_castsi256_si128(Or), _mm256_extracti128_si256(Or, 1));
+	return static_cast<uint64>(_mm_cvtsi128_si64(Half)) | static_cast<uint64>(_mm_extract_epi64(Half, 1));
+}
+
+LINKPROTO_TARGET_AVX2 static uint64 EncodedSizeAvx2(const uint64* Values, int32 Count)
+{
+	uint64 Size = 0;
+	int32 Index = 0;
+	for (; Index + EncodeGroupSize <= Count; Index += EncodeGroupSize)
+	{
+		Size += GroupSize(Values + Index, OrGroupAvx2(Values + Index));
+	}
+	return Size + EncodedSizeScalar(Values + Index, Count - Index);
+}
+
+LINKPROTO_TARGET_AVX2 static uint8* EncodeAvx2(const uint64* Values, int32 Count, uint8* Target)
+{
+	int32 Index = 0;
+	for (; Index + EncodeGroupSize <= Count; Index += EncodeGroupSize)
+	{
+		Target = EncodeGroup(Values + Index, OrGroupAvx2(Values + Index), Target);
+	}
+	return EncodeScalar(Values + Index, Count - Index, Target);
+}
+
+static const FLinkProtoVarintKernels Sse41Kernels = { &CountValuesSse41, &DecodeSse41, &EncodedSizeSse41, &EncodeSse41, TEXT("SSE4.1") };
+static const FLinkProtoVarintKernels Avx2Kernels = { &CountValuesAvx2, &DecodeAvx2, &EncodedSizeAvx2, &EncodeAvx2, TEXT("AVX2") };
+
+#endif
+
+// ---------------------------------------------------------------------------------------------------------------------
+// arm64 kernels
+// ---------------------------------------------------------------------------------------------------------------------
+
+#if LINKPROTO_SIMD_NEON
+
+// Continuation bits of a 16 byte block, bit i for byte i
+static FORCEINLINE uint32 ContinuationMaskNeon(uint8x16_t Block)
+{
+	static const int8 Shifts[16] = { 0, 1, 2, 3, 4, 5, 6, 7, 0, 1, 2, 3, 4, 5, 6, 7 };
+	const uint8x16_t Bits = vshlq_u8(vshrq_n_u8(Block, 7), vld1q_s8(Shifts));
+	return static_cast<uint32>(vaddv_u8(vget_low_u8(Bits))) | (static_cast<uint32>(vaddv_u8(vget_high_u8(Bits))) << 8);
+}
+
+static FORCEINLINE void StoreWidenedNeon(uint16x8_t Values, uint64* Dst)
+{
+	const uint32x4_t Low = vmovl_u16(vget_low_u16(Values));
+	const uint32x4_t High = vmovl_high_u16(Values);
+	vst1q_u64(Dst + 0, vmovl_u32(vget_low_u32(Low)));
+	vst1q_u64(Dst + 2, vmovl_high_u32(Low));
+	vst1q_u64(Dst + 4, vmovl_u32(vget_low_u32(High)));
+	vst1q_u64(Dst + 6, vmovl_high_u32(High));
+}
+
+static int32 CountValuesNeon(const uint8* Data, const uint8* End)
+{
+	int32 Count = 0;
+	for (; End - Data >= 16; Data += 16)
+	{
+		Count += 16 - static_cast<int32>(vaddvq_u8(vshrq_n_u8(vld1q_u8(Data), 7)));
+	}
+	return Count + CountValuesScalar(Data, End);
+}
+
+static int32 DecodeNeon(const uint8*& Data, const uint8* End, uint64* Out, int32 MaxCount)
+{
+	int32 Count = 0;
+	while (End - Data >= 16 && MaxCount - Count >= 16)
+	{
+		const uint8x16_t Block = vld1q_u8(Data);
+		const uint32 Mask = ContinuationMaskNeon(Block);
+		if (Mask == 0)
+		{
+			// Sixteen one byte varints
+			StoreWidenedNeon(vmovl_u8(vget_low_u8(Block)), Out + Count);
+			StoreWidenedNeon(vmovl_high_u8(Block), Out + Count + 8);
+			Data += 16;
+			Count += 16;
+		}
+		else if (Mask == 0x5555)
+		{
+			// Eight two byte varints
+			const uint16x8_t Pairs = vreinterpretq_u16_u8(Block);
+			const uint16x8_t Values = vorrq_u16(vandq_u16(Pairs, vdupq_n_u16(0x007F)), vshrq_n_u16(vandq_u16(Pairs, vdupq_n_u16(0x7F00)), 1));
+			StoreWidenedNeon(Values, Out + Count);
+			Data += 16;
+			Count += 8;
+		}
+		else if (!DecodeBlockSlow(Data, End, ~Mask & 0xFFFF, Out, Count))
+		{
+			return INDEX_NONE;
+		}
+	}
+	const int32 Tail = DecodeScalar(Data, End, Out + Count, MaxCount - Count);
+	return Tail == INDEX_NONE ? INDEX_NONE : Count + Tail;
+}
+
+static FORCEINLINE uint64 OrGroupNeon(const uint64* Values)
+{
+	const uint64x2_t Or = vorrq_u64(vorrq_u64(vld1q_u64(Values), vld1q_u64(Values + 2)), vorrq_u64(vld1q_u64(Values + 4), vld1q_u64(Values + 6)));
+	return vgetq_lane_u64(Or, 0) | vgetq_lane_u64(Or, 1);
+}
+
+static uint64 EncodedSizeNeon(const uint64* Values, int32 Count)
+{
+	uint64 Size = 0;
+	int32 Index = 0;
+	for (; Index + EncodeGroupSize <= Count; Index += EncodeGroupSize)
+	{
+		Size += GroupSize(Values + Index, OrGroupNeon(Values + Index));
+	}
+	return Size + EncodedSizeScalar(Values + Index, Count - Index);
+}
+
+static uint8* EncodeNeon(const uint64* Values, int32 Count, uint8* Target)
+{
+	int32 Index = 0;
+	for (; Index + EncodeGroupSize <= Count; Index += EncodeGroupSize)
+	{
+		Target = EncodeGroup(Values + Index, OrGroupNeon(Values + Index), Target);
+	}
+	return EncodeScalar(Values + Index, Count - Index, Target);
+}
+
+static const FLinkProtoVarintKernels NeonKernels = { &CountValuesNeon, &DecodeNeon, &EncodedSizeNeon, &EncodeNeon, TEXT("NEON") };
+
+#endif
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Dispatch
+// ---------------------------------------------------------------------------------------------------------------------
+
+TArray<const FLinkProtoVarintKernels*> FLinkProtoVarintKernels::GetAvailable()
+{
+	TArray<const FLinkProtoVarintKernels*> Available;
+	Available.Add(&ScalarKernels);
+#if LINKPROTO_SIMD_X86
+	const FLinkProtoCpuFeatures& Features = FLinkProtoCpuFeatures::Get();
+	if (Features.bSse41)
+	{
+		Available.Add(&Sse41Kernels);
+	}
+	if (Features.bAvx2)
+	{
+		Available.Add(&Avx2Kernels);
+	}
+#elif LINKPROTO_SIMD_NEON
+	// NEON is part of every arm64 CPU
+	Available.Add(&NeonKernels);
+#endif
+	return Available;
+}
+
+static const FLinkProtoVarintKernels& SelectVarintKernels()
+{
+	const FLinkProtoVarintKernels* Best = FLinkProtoVarintKernels::GetAvailable().Last();
+	UE_LOG(LogProto, Log, TEXT("Proto varint kernels: %s"), Best->Name);
+	return *Best;
+}
+
+const FLinkProtoVarintKernels& FLinkProtoVarintKernels::Get()
+{
+	static const FLinkProtoVarintKernels& Selected = SelectVarintKernels();
+	return Selected;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Benchmark
+// ---------------------------------------------------------------------------------------------------------------------
+
+#if !UE_BUILD_SHIPPING
+
+// Checks every kernel set against the scalar one and logs its throughput over the encoded bytes for a few value widths
+static void RunVarintBenchmark(const TArray<FString>& Args)
+{
+	const int32 NumValues = FMath::Clamp(Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 1 << 20, 1024, 16 << 20);
+	struct FDistribution
+	{
+		const TCHAR* Name;
+		// Bit width of the values, 0 for a random width per value
+		int32 Bits;
+	};
+	const FDistribution Distributions[] = { { TEXT("7 bit"), 7 }, { TEXT("14 bit"), 14 }, { TEXT("32 bit"), 32 }, { TEXT("mixed"), 0 } };
+
+	FRandomStream Random(0x5EED);
+	TArray<uint64> Values;
+	TArray<uint64> Decoded;
+	TArray<uint8> Encoded;
+	TArray<uint8> Reencoded;
+	Values.SetNumUninitialized(NumValues);
+	Decoded.SetNumUninitialized(NumValues);
+	Encoded.SetNumUninitialized(NumValues * 10);
+	Reencoded.SetNumUninitialized(NumValues * 10);
+
+	for (const FDistribution& Distribution : Distributions)
+	{
+		for (uint64& Value : Values)
+		{
+			const int32 Bits = Distribution.Bits > 0 ? Distribution.Bits : Random.RandRange(1, 64);
+			const uint64 Raw = (static_cast<uint64>(Random.GetUnsignedInt()) << 32) | Random.GetUnsignedInt();
+			Value = Bits >= 64 ? Raw : Raw & ((1ULL << Bits) - 1);
+		}
+		const int64 EncodedBytes = ScalarKernels.Encode(Values.GetData(), NumValues, Encoded.GetData()) - Encoded.GetData();
+		const uint8* EncodedEnd = Encoded.GetData() + EncodedBytes;
+
+		for (const FLinkProtoVarintKernels* Kernels : FLinkProtoVarintKernels::GetAvailable())
+		{
+			const uint8* Cursor = Encoded.GetData();
+			const bool bDecodeOk = Kernels->Decode(Cursor, EncodedEnd, Decoded.GetData(), NumValues) == NumValues && Decoded == Values;
+			const bool bEncodeOk = Kernels->Encode(Values.GetData(), NumValues, Reencoded.GetData()) - Reencoded.GetData() == EncodedBytes
+				&& FMemory::Memcmp(Reencoded.GetData(), Encoded.GetData(), EncodedBytes) == 0;
+			const bool bCountOk = Kernels->CountValues(Encoded.GetData(), EncodedEnd) == NumValues
+				&& Kernels->EncodedSize(Values.GetData(), NumValues) == static_cast<uint64>(EncodedBytes);
+			if (!bDecodeOk || !bEncodeOk || !bCountOk)
+			{
+				UE_LOG(LogProto, Error, TEXT("Proto varint kernels %s disagree with the scalar kernels on %s values"), Kernels->Name, Distribution.Name);
+				continue;
+			}
+
+			const double DecodeRate = LinkProtoMeasureThroughput(EncodedBytes, [&]()
+			{
+				const uint8* Data = Encoded.GetData();
+				Kernels->Decode(Data, EncodedEnd, Decoded.GetData(), NumValues);
+			});
+			const double EncodeRate = LinkProtoMeasureThroughput(EncodedBytes, [&]()
+			{
+				Kernels->Encode(Values.GetData(), NumValues, Reencoded.GetData());
+			});
+			const double CountRate = LinkProtoMeasureThroughput(EncodedBytes, [&]()
+			{
+				Kernels->CountValues(Encoded.GetData(), EncodedEnd);
+			});
+			const double SizeRate = LinkProtoMeasureThroughput(EncodedBytes, [&]()
+			{
+				Kernels->EncodedSize(Values.GetData(), NumValues);
+			});
+			UE_LOG(LogProto, Display, TEXT("Proto varint %-6s %-6s values: decode %6.2f GB/s, encode %6.2f GB/s, count %6.2f GB/s, size %6.2f GB/s (%d values, %lld bytes)"),
+				Kernels->Name, Distribution.Name, DecodeRate, EncodeRate, CountRate, SizeRate, NumValues, EncodedBytes);
+		}
+	}
+}
+
+static FAutoConsoleCommand LinkProtoVarintBenchmarkCommand(
+	TEXT("LinkProto.VarintBenchmark"),
+	TEXT("Checks and measures the varint kernels of every instruction set this CPU supports. Usage: LinkProto.VarintBenchmark [NumValues]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&RunVarintBenchmark));
+
+#endif
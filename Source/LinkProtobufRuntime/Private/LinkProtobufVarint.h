@@ -0,0 +1,50 @@
+// Copyright DarkestLink-Dev 2025 All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// SPDX-License-Identifier: Apache-2.0
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Batch varint kernels of the packed repeated paths of the wire encoder and decoder.
+ *
+ * There is one set per instruction set (scalar, SSE4.1 and AVX2 on x86_64, NEON on arm64), the best set the CPU
+ * supports is picked on first use. Every set produces and accepts exactly the same bytes, the vector sets only
+ * speed up runs of short varints and fall back to scalar code for the rest.
+ */
+struct FLinkProtoVarintKernels
+{
+	// Number of varints ending in [Data, End), one per byte without the continuation bit.
+	int32 (*CountValues)(const uint8* Data, const uint8* End);
+
+	// Decodes up to MaxCount varints from Data into Out and advances Data past them.
+	// Returns the number of values decoded, INDEX_NONE when a varint is longer than 10 bytes or runs past End.
+	int32 (*Decode)(const uint8*& Data, const uint8* End, uint64* Out, int32 MaxCount);
+
+	// Encoded size of Count values.
+	uint64 (*EncodedSize)(const uint64* Values, int32 Count);
+
+	// Writes Count values as varints and returns the end of the written bytes.
+	uint8* (*Encode)(const uint64* Values, int32 Count, uint8* Target);
+
+	const TCHAR* Name;
+
+	// Kernels of the best instruction set of the running CPU.
+	static const FLinkProtoVarintKernels& Get();
+
+	// Every kernel set the running CPU can execute, scalar first.
+	static TArray<const FLinkProtoVarintKernels*> GetAvailable();
+};
@@ -0,0 +1,738 @@
+// Copyright DarkestLink-Dev 2025 All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "LinkProtobufWireDecoder.h"
+#include "LinkProtobufCompat.h"
+#include "google/protobuf/descriptor.h"
+#include "google/protobuf/io/coded_stream.h"
+#include "google/protobuf/io/zero_copy_stream_impl_lite.h"
+#include "google/protobuf/wire_format_lite.h"
+#include "LinkProtobufRuntime.h"
+#include "LinkProtobufValueAccess.h"
+#include "LinkProtobufVarint.h"
+#include "Misc/ScopeExit.h"
+
+using FieldDescriptor      = google::protobuf::FieldDescriptor;
+using CodedInputStream     = google::protobuf::io::CodedInputStream;
+using CodedOutputStream    = google::protobuf::io::CodedOutputStream;
+using StringOutputStream   = google::protobuf::io::StringOutputStream;
+using ZeroCopyInputStream  = google::protobuf::io::ZeroCopyInputStream;
+using WireFormatLite       = google::protobuf::internal::WireFormatLite;
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Value readers
+// ---------------------------------------------------------------------------------------------------------------------
+
+static FORCEINLINE bool IsLengthDelimited(const FieldDescriptor* Field)
+{
+	return Field->cpp_type() == FieldDescriptor::CPPTYPE_STRING;
+}
+
+static FORCEINLINE WireFormatLite::WireType ElementWireType(const FieldDescriptor* Field)
+{
+	return WireFormatLite::WireTypeForFieldType(static_cast<WireFormatLite::FieldType>(Field->type()));
+}
+
+static FORCEINLINE bool ReadLength(CodedInputStream& Input, int32& OutLength)
+{
+	uint32 Length = 0;
+	if (!Input.ReadVarint32(&Length) || Length > static_cast<uint32>(MAX_int32))
+	{
+		return false;
+	}
+	OutLength = static_cast<int32>(Length);
+	return true;
+}
+
+// Interprets the raw varint of a varint encoded field type
+static FORCEINLINE int64 DecodeVarintValue(FieldDescriptor::Type FieldType, uint64 Bits)
+{
+	switch (FieldType)
+	{
+	case FieldDescriptor::TYPE_INT32:
+	case FieldDescriptor::TYPE_ENUM:   return static_cast<int32>(Bits);
+	case FieldDescriptor::TYPE_UINT32: return static_cast<uint32>(Bits);
+	case FieldDescriptor::TYPE_SINT32: return WireFormatLite::ZigZagDecode32(static_cast<uint32>(Bits));
+	case FieldDescriptor::TYPE_SINT64: return WireFormatLite::ZigZagDecode64(Bits);
+	case FieldDescriptor::TYPE_BOOL:   return Bits != 0 ? 1 : 0;
+	default:                           return static_cast<int64>(Bits);
+	}
+}
+
+// Reads one numeric value of the field type and stores it into the property, values the property cannot hold are consumed and dropped
+static FORCEINLINE bool ReadNumeric(FieldDescriptor::Type FieldType, ELinkProtoValueType ValueType, const FProperty* Prop, void* Ptr, CodedInputStream& Input)
+{
+	uint32 Bits32 = 0;
+	uint64 Bits64 = 0;
+	switch (FieldType)
+	{
+	case FieldDescriptor::TYPE_DOUBLE:
+		if (!Input.ReadLittleEndian64(&Bits64)) return false;
+		FLinkProtoValueAccess::WriteDouble(ValueType, Prop, Ptr, WireFormatLite::DecodeDouble(Bits64));
+		return true;
+	case FieldDescriptor::TYPE_FLOAT:
+		if (!Input.ReadLittleEndian32(&Bits32)) return false;
+		FLinkProtoValueAccess::WriteDouble(ValueType, Prop, Ptr, WireFormatLite::DecodeFloat(Bits32));
+		return true;
+	case FieldDescriptor::TYPE_FIXED32:
+		if (!Input.ReadLittleEndian32(&Bits32)) return false;
+		FLinkProtoValueAccess::WriteInt64(ValueType, Prop, Ptr, static_cast<int64>(Bits32));
+		return true;
+	case FieldDescriptor::TYPE_SFIXED32:
+		if (!Input.ReadLittleEndian32(&Bits32)) return false;
+		FLinkProtoValueAccess::WriteInt64(ValueType, Prop, Ptr, static_cast<int32>(Bits32));
+		return true;
+	case FieldDescriptor::TYPE_FIXED64:
+	case FieldDescriptor::TYPE_SFIXED64:
+		if (!Input.ReadLittleEndian64(&Bits64)) return false;
+		FLinkProtoValueAccess::WriteInt64(ValueType, Prop, Ptr, static_cast<int64>(Bits64));
+		return true;
+	default:
+		break;
+	}
+
+	if (!Input.ReadVarint64(&Bits64)) return false;
+	FLinkProtoValueAccess::WriteInt64(ValueType, Prop, Ptr, DecodeVarintValue(FieldType, Bits64));
+	return true;
+}
+
+// Proto3 string fields must hold valid UTF-8, protobuf's own parser rejects the message otherwise
+static FORCEINLINE bool RequiresValidUtf8(const FieldDescriptor* Field)
+{
+	return Field->type() == FieldDescriptor::TYPE_STRING && Field->file()->syntax() == google::protobuf::FileDescriptor::SYNTAX_PROTO3;
+}
+
+// Reads a string/bytes value and stores it into the property
+static FORCEINLINE bool ReadString(const FieldDescriptor* Field, ELinkProtoValueType ValueType, void* Ptr, CodedInputStream& Input)
+{
+	int32 Length = 0;
+	if (!ReadLength(Input, Length))
+	{
+		return false;
+	}
+
+	if (ValueType == ELinkProtoValueType::ByteArray)
+	{
+		// Read straight into the array, one copy whether the input is flat or not. The length is checked against
+		// the input first so a corrupt prefix cannot allocate more than the message holds.
+		const int BytesUntilLimit = Input.BytesUntilLimit();
+		if ((BytesUntilLimit >= 0 && Length > BytesUntilLimit) || Length > Input.BytesUntilTotalBytesLimit())
+		{
+			return false;
+		}
+		TArray<uint8>& Bytes = *static_cast<TArray<uint8>*>(Ptr);
+		Bytes.SetNumUninitialized(Length, LINKPROTO_NO_SHRINK);
+		return Input.ReadRaw(Bytes.GetData(), Length);
+	}
+
+	// Flat inputs hand out the payload in place, otherwise it is copied once
+	const ANSICHAR* Data = "";
+	std::string Copied;
+	const void* Buffer = nullptr;
+	int BufferSize = 0;
+	if (Length > 0)
+	{
+		if (Input.GetDirectBufferPointer(&Buffer, &BufferSize) && BufferSize >= Length)
+		{
+			Data = static_cast<const ANSICHAR*>(Buffer);
+			Input.Skip(Length);
+		}
+		else
+		{
+			if (!Input.ReadString(&Copied, Length))
+			{
+				return false;
+			}
+			Data = Copied.data();
+		}
+	}
+
+	if (ValueType == ELinkProtoValueType::UInt8 && Field->type() == FieldDescriptor::TYPE_BYTES)
+	{
+		*static_cast<uint8*>(Ptr) = Length > 0 ? static_cast<uint8>(Data[0]) : 0;
+		return true;
+	}
+	// The UTF-8 is validated while it is transcoded, no separate pass
+	return FLinkProtoValueAccess::WriteString(ValueType, Ptr, Data, Length) || !RequiresValidUtf8(Field);
+}
+
+static FORCEINLINE bool ReadValue(const FieldDescriptor* Field, ELinkProtoValueType ValueType, const FProperty* Prop, void* Ptr, CodedInputStream& Input)
+{
+	return IsLengthDelimited(Field)
+		? ReadString(Field, ValueType, Ptr, Input)
+		: ReadNumeric(Field->type(), ValueType, Prop, Ptr, Input);
+}
+
+static bool ReadNestedMessage(const FLinkProtoStructPlan& SubPlan, CodedInputStream& Input, void* ValuePtr, ELinkProtoUnknownFieldPolicy NestedPolicy)
+{
+	int32 Length = 0;
+	if (!ReadLength(Input, Length))
+	{
+		return false;
+	}
+	const std::pair<CodedInputStream::Limit, int> LimitAndDepth = Input.IncrementRecursionDepthAndPushLimit(Length);
+	if (LimitAndDepth.second < 0)
+	{
+		UE_LOG(LogProto, Error, TEXT("Proto wire decode: recursion limit exceeded in %s"), *SubPlan.StructName);
+		return false;
+	}
+	if (!FLinkProtoWireDecoder::DecodeFields(SubPlan, Input, ValuePtr, NestedPolicy))
+	{
+		return false;
+	}
+	return Input.DecrementRecursionDepthAndPopLimit(LimitAndDepth.first);
+}
+
+static FORCEINLINE void* AddElement(const FLinkProtoFieldPlan& FieldPlan, void* ValuePtr)
+{
+	if (FieldPlan.Kind == ELinkProtoFieldKind::Array)
+	{
+		FScriptArrayHelper ArrayHelper(static_cast<const FArrayProperty*>(FieldPlan.Property), ValuePtr);
+		return ArrayHelper.GetRawPtr(ArrayHelper.AddValue());
+	}
+	// Struct elements are hashed once decoded, the set is rehashed when the enclosing message is done
+	FScriptSetHelper SetHelper(static_cast<const FSetProperty*>(FieldPlan.Property), ValuePtr);
+	return SetHelper.GetElementPtr(SetHelper.AddDefaultValue_Invalid_NeedsRehash());
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Packed runs
+// ---------------------------------------------------------------------------------------------------------------------
+
+// Bytes of a packed fixed size run read at once when the input has no limit to check the length against
+static constexpr int32 UnboundedFixedRunStep = 64 * 1024;
+
+// Appends a packed run of a FixedWireSize field to the array, the payload already has the array memory layout
+static bool ReadFixedRun(const FLinkProtoFieldPlan& FieldPlan, CodedInputStream& Input, void* ValuePtr, int32 Length)
+{
+	if (Length % FieldPlan.FixedWireSize != 0)
+	{
+		return false;
+	}
+	// Do not trust the length for the allocation before the bytes are known to be there
+	const int32 Available = Input.BytesUntilLimit();
+	if (Available >= 0 && Available < Length)
+	{
+		return false;
+	}
+	// Without a limit (top level of a stream) the array grows in steps as the bytes arrive
+	const int32 Step = Available >= 0 ? Length : FMath::Max(UnboundedFixedRunStep / FieldPlan.FixedWireSize, 1) * FieldPlan.FixedWireSize;
+	FScriptArrayHelper ArrayHelper(static_cast<const FArrayProperty*>(FieldPlan.Property), ValuePtr);
+	for (int32 Offset = 0; Offset < Length; Offset += Step)
+	{
+		const int32 StepLength = FMath::Min(Step, Length - Offset);
+		const int32 First = ArrayHelper.AddUninitializedValues(StepLength / FieldPlan.FixedWireSize);
+		if (!Input.ReadRaw(ArrayHelper.GetRawPtr(First), StepLength))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+// Values decoded per call to the varint kernels
+static constexpr int32 VarintChunkSize = 256;
+
+template<typename ElementType>
+static FORCEINLINE bool DecodeVarintRun(FieldDescriptor::Type FieldType, const uint8* Data, const uint8* End, ElementType* Out)
+{
+	const FLinkProtoVarintKernels& Kernels = FLinkProtoVarintKernels::Get();
+	uint64 Raw[VarintChunkSize];
+	while (Data < End)
+	{
+		const int32 Num = Kernels.Decode(Data, End, Raw, VarintChunkSize);
+		if (Num <= 0)
+		{
+			return false;
+		}
+		for (int32 Index = 0; Index < Num; ++Index)
+		{
+			*Out++ = static_cast<ElementType>(DecodeVarintValue(FieldType, Raw[Index]));
+		}
+	}
+	return true;
+}
+
+// Appends a packed varint run to an integer array when the whole run sits in the input buffer.
+// The element count is known up front (one terminating byte per value), so the array grows once.
+// Returns false with bOutHandled unset when the run has to go through the generic path.
+static bool ReadVarintRun(const FLinkProtoFieldPlan& FieldPlan, CodedInputStream& Input, void* ValuePtr, int32 Length, bool& bOutHandled)
+{
+	bOutHandled = false;
+	if (FieldPlan.Kind != ELinkProtoFieldKind::Array || ElementWireType(FieldPlan.Field) != WireFormatLite::WIRETYPE_VARINT)
+	{
+		return false;
+	}
+	switch (FieldPlan.ValueType)
+	{
+	case ELinkProtoValueType::Int8: case ELinkProtoValueType::Int16: case ELinkProtoValueType::Int32: case ELinkProtoValueType::Int64:
+	case ELinkProtoValueType::UInt8: case ELinkProtoValueType::UInt16: case ELinkProtoValueType::UInt32: case ELinkProtoValueType::UInt64:
+		break;
+	default:
+		return false;
+	}
+	const void* Buffer = nullptr;
+	int BufferSize = 0;
+	if (!Input.GetDirectBufferPointer(&Buffer, &BufferSize) || BufferSize < Length)
+	{
+		return false;
+	}
+
+	bOutHandled = true;
+	const uint8* Data = static_cast<const uint8*>(Buffer);
+	const uint8* End = Data + Length;
+	const int32 Count = FLinkProtoVarintKernels::Get().CountValues(Data, End);
+	if (Count == 0)
+	{
+		return Length == 0;
+	}
+
+	FScriptArrayHelper ArrayHelper(static_cast<const FArrayProperty*>(FieldPlan.Property), ValuePtr);
+	const int32 First = ArrayHelper.AddUninitializedValues(Count);
+	void* Out = ArrayHelper.GetRawPtr(First);
+	const FieldDescriptor::Type FieldType = FieldPlan.Field->type();
+	bool bOk;
+	switch (FieldPlan.ValueType)
+	{
+	case ELinkProtoValueType::Int8:   bOk = DecodeVarintRun(FieldType, Data, End, static_cast<int8*>(Out)); break;
+	case ELinkProtoValueType::Int16:  bOk = DecodeVarintRun(FieldType, Data, End, static_cast<int16*>(Out)); break;
+	case ELinkProtoValueType::Int32:  bOk = DecodeVarintRun(FieldType, Data, End, static_cast<int32*>(Out)); break;
+	case ELinkProtoValueType::Int64:  bOk = DecodeVarintRun(FieldType, Data, End, static_cast<int64*>(Out)); break;
+	case ELinkProtoValueType::UInt8:  bOk = DecodeVarintRun(FieldType, Data, End, static_cast<uint8*>(Out)); break;
+	case ELinkProtoValueType::UInt16: bOk = DecodeVarintRun(FieldType, Data, End, static_cast<uint16*>(Out)); break;
+	case ELinkProtoValueType::UInt32: bOk = DecodeVarintRun(FieldType, Data, End, static_cast<uint32*>(Out)); break;
+	default:                          bOk = DecodeVarintRun(FieldType, Data, End, static_cast<uint64*>(Out)); break;
+	}
+	return bOk && Input.Skip(Length);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Field decoders
+// ---------------------------------------------------------------------------------------------------------------------
+
+static bool DecodeScalarField(const FLinkProtoFieldPlan& FieldPlan, CodedInputStream& Input, uint32 Tag, void* StructPtr, ELinkProtoUnknownFieldPolicy NestedPolicy)
+{
+	return ReadValue(FieldPlan.Field, FieldPlan.ValueType, FieldPlan.Property, FieldPlan.GetValuePtr(StructPtr), Input);
+}
+
+static bool DecodeStructField(const FLinkProtoFieldPlan& FieldPlan, CodedInputStream& Input, uint32 Tag, void* StructPtr, ELinkProtoUnknownFieldPolicy NestedPolicy)
+{
+	// Repeated occurrences of a message field merge into the same struct
+	return ReadNestedMessage(*FieldPlan.SubPlan, Input, FieldPlan.GetValuePtr(StructPtr), NestedPolicy);
+}
+
+static bool DecodeRepeatedMessageField(const FLinkProtoFieldPlan& FieldPlan, CodedInputStream& Input, uint32 Tag, void* StructPtr, ELinkProtoUnknownFieldPolicy NestedPolicy)
+{
+	void* ElemPtr = AddElement(FieldPlan, FieldPlan.GetValuePtr(StructPtr));
+	return ReadNestedMessage(*FieldPlan.SubPlan, Input, ElemPtr, NestedPolicy);
+}
+
+static bool DecodeRepeatedValueField(const FLinkProtoFieldPlan& FieldPlan, CodedInputStream& Input, uint32 Tag, void* StructPtr, ELinkProtoUnknownFieldPolicy NestedPolicy)
+{
+	void* ValuePtr = FieldPlan.GetValuePtr(StructPtr);
+	const bool bPackedRun = !IsLengthDelimited(FieldPlan.Field) && WireFormatLite::GetTagWireType(Tag) == WireFormatLite::WIRETYPE_LENGTH_DELIMITED;
+	if (!bPackedRun)
+	{
+		return ReadValue(FieldPlan.Field, FieldPlan.ValueType, FieldPlan.ElementProperty, AddElement(FieldPlan, ValuePtr), Input);
+	}
+
+	int32 Length = 0;
+	if (!ReadLength(Input, Length))
+	{
+		return false;
+	}
+	if (FieldPlan.FixedWireSize > 0)
+	{
+		return ReadFixedRun(FieldPlan, Input, ValuePtr, Length);
+	}
+	bool bHandled = false;
+	const bool bRunOk = ReadVarintRun(FieldPlan, Input, ValuePtr, Length, bHandled);
+	if (bHandled)
+	{
+		return bRunOk;
+	}
+
+	const CodedInputStream::Limit Limit = Input.PushLimit(Length);
+	const FieldDescriptor::Type FieldType = FieldPlan.Field->type();
+	while (Input.BytesUntilLimit() > 0)
+	{
+		if (!ReadNumeric(FieldType, FieldPlan.ValueType, FieldPlan.ElementProperty, AddElement(FieldPlan, ValuePtr), Input))
+		{
+			return false;
+		}
+	}
+	Input.PopLimit(Limit);
+	return true;
+}
+
+// Scalar set elements are decoded on the stack and hashed once into the set, a repeated element is kept once
+static bool DecodeSetValueField(const FLinkProtoFieldPlan& FieldPlan, CodedInputStream& Input, uint32 Tag, void* StructPtr, ELinkProtoUnknownFieldPolicy NestedPolicy)
+{
+	FScriptSetHelper SetHelper(static_cast<const FSetProperty*>(FieldPlan.Property), FieldPlan.GetValuePtr(StructPtr));
+	FLinkProtoScalarScratch Element(FieldPlan.ElementProperty);
+	const bool bPackedRun = !IsLengthDelimited(FieldPlan.Field) && WireFormatLite::GetTagWireType(Tag) == WireFormatLite::WIRETYPE_LENGTH_DELIMITED;
+	if (!bPackedRun)
+	{
+		if (!ReadValue(FieldPlan.Field, FieldPlan.ValueType, FieldPlan.ElementProperty, Element.Get(), Input))
+		{
+			return false;
+		}
+		SetHelper.AddElement(Element.Get());
+		return true;
+	}
+
+	int32 Length = 0;
+	if (!ReadLength(Input, Length))
+	{
+		return false;
+	}
+	const CodedInputStream::Limit Limit = Input.PushLimit(Length);
+	const FieldDescriptor::Type FieldType = FieldPlan.Field->type();
+	while (Input.BytesUntilLimit() > 0)
+	{
+		if (!ReadNumeric(FieldType, FieldPlan.ValueType, FieldPlan.ElementProperty, Element.Get(), Input))
+		{
+			return false;
+		}
+		SetHelper.AddElement(Element.Get());
+	}
+	Input.PopLimit(Limit);
+	return true;
+}
+
+// Map of plain old data keys and values (TMap<int32, float>, TMap<FName, int32>...): the whole entry is decoded on the
+// stack, in whatever order its fields come, then the key is hashed once and the value copied into its slot
+static bool DecodePodMapField(const FLinkProtoFieldPlan& FieldPlan, CodedInputStream& Input, uint32 Tag, void* StructPtr, ELinkProtoUnknownFieldPolicy NestedPolicy)
+{
+	int32 Length = 0;
+	if (!ReadLength(Input, Length))
+	{
+		return false;
+	}
+	const CodedInputStream::Limit Limit = Input.PushLimit(Length);
+
+	FLinkProtoScalarScratch Key(FieldPlan.ElementProperty);
+	FLinkProtoScalarScratch Value(FieldPlan.ValueProperty);
+	const uint32 KeyTag = WireFormatLite::MakeTag(1, ElementWireType(FieldPlan.KeyField));
+	const uint32 ValueTag = WireFormatLite::MakeTag(2, ElementWireType(FieldPlan.ValueField));
+	for (uint32 EntryTag = Input.ReadTag(); EntryTag != 0; EntryTag = Input.ReadTag())
+	{
+		bool bOk;
+		if (EntryTag == KeyTag)
+		{
+			bOk = ReadValue(FieldPlan.KeyField, FieldPlan.ValueType, FieldPlan.ElementProperty, Key.Get(), Input);
+		}
+		else if (EntryTag == ValueTag)
+		{
+			bOk = ReadValue(FieldPlan.ValueField, FieldPlan.MapValueType, FieldPlan.ValueProperty, Value.Get(), Input);
+		}
+		else
+		{
+			bOk = WireFormatLite::SkipField(&Input, EntryTag);
+		}
+		if (!bOk)
+		{
+			return false;
+		}
+	}
+	if (!Input.ConsumedEntireMessage())
+	{
+		return false;
+	}
+	Input.PopLimit(Limit);
+
+	FScriptMapHelper MapHelper(static_cast<const FMapProperty*>(FieldPlan.Property), FieldPlan.GetValuePtr(StructPtr));
+	FMemory::Memcpy(MapHelper.FindOrAdd(Key.Get()), Value.Get(), FieldPlan.ValueProperty->GetSize());
+	return true;
+}
+
+// Moves the value already decoded under OldKey to NewKey. Only for entries whose key follows their value,
+// which protobuf's serializer and the wire encoder never write.
+static void* RebindMapValue(const FLinkProtoFieldPlan& FieldPlan, FScriptMapHelper& MapHelper, const void* OldKey, const void* NewKey)
+{
+	if (FieldPlan.ElementProperty->Identical(OldKey, NewKey))
+	{
+		return MapHelper.FindOrAdd(NewKey);
+	}
+	void* NewValPtr = FLinkProtoValueAccess::FindOrAddMapValue(MapHelper, FieldPlan.ValueProperty, NewKey);
+	// Looked up after the add, which may have moved the pairs
+	const int32 OldIndex = MapHelper.FindMapIndexWithKey(OldKey);
+	FieldPlan.ValueProperty->CopyCompleteValue(NewValPtr, MapHelper.GetValuePtr(OldIndex));
+	// Removing leaves the other pairs in place
+	MapHelper.RemoveAt(OldIndex);
+	return NewValPtr;
+}
+
+// The key is decoded on the stack and hashed once, the value is then decoded in place into the slot of the key
+static bool DecodeMapField(const FLinkProtoFieldPlan& FieldPlan, CodedInputStream& Input, uint32 Tag, void* StructPtr, ELinkProtoUnknownFieldPolicy NestedPolicy)
+{
+	int32 Length = 0;
+	if (!ReadLength(Input, Length))
+	{
+		return false;
+	}
+	const CodedInputStream::Limit Limit = Input.PushLimit(Length);
+
+	FScriptMapHelper MapHelper(static_cast<const FMapProperty*>(FieldPlan.Property), FieldPlan.GetValuePtr(StructPtr));
+	FLinkProtoScalarScratch Key(FieldPlan.ElementProperty);
+	// Slot of Key, bound by the first value
+	void* ValPtr = nullptr;
+
+	const uint32 KeyTag = WireFormatLite::MakeTag(1, ElementWireType(FieldPlan.KeyField));
+	const uint32 ValueTag = WireFormatLite::MakeTag(2, ElementWireType(FieldPlan.ValueField));
+	for (uint32 EntryTag = Input.ReadTag(); EntryTag != 0; EntryTag = Input.ReadTag())
+	{
+		bool bOk;
+		if (EntryTag == KeyTag)
+		{
+			if (!ValPtr)
+			{
+				bOk = ReadValue(FieldPlan.KeyField, FieldPlan.ValueType, FieldPlan.ElementProperty, Key.Get(), Input);
+			}
+			else
+			{
+				FLinkProtoScalarScratch NewKey(FieldPlan.ElementProperty);
+				bOk = ReadValue(FieldPlan.KeyField, FieldPlan.ValueType, FieldPlan.ElementProperty, NewKey.Get(), Input);
+				if (bOk)
+				{
+					ValPtr = RebindMapValue(FieldPlan, MapHelper, Key.Get(), NewKey.Get());
+					FieldPlan.ElementProperty->CopyCompleteValue(Key.Get(), NewKey.Get());
+				}
+			}
+		}
+		else if (EntryTag == ValueTag)
+		{
+			if (!ValPtr)
+			{
+				ValPtr = FLinkProtoValueAccess::FindOrAddMapValue(MapHelper, FieldPlan.ValueProperty, Key.Get());
+			}
+			bOk = FieldPlan.SubPlan
+				? ReadNestedMessage(*FieldPlan.SubPlan, Input, ValPtr, NestedPolicy)
+				: ReadValue(FieldPlan.ValueField, FieldPlan.MapValueType, FieldPlan.ValueProperty, ValPtr, Input);
+		}
+		else
+		{
+			bOk = WireFormatLite::SkipField(&Input, EntryTag);
+		}
+		if (!bOk)
+		{
+			return false;
+		}
+	}
+	if (!Input.ConsumedEntireMessage())
+	{
+		return false;
+	}
+	Input.PopLimit(Limit);
+	if (!ValPtr)
+	{
+		// Entry without a value, the key maps to the default value
+		FLinkProtoValueAccess::FindOrAddMapValue(MapHelper, FieldPlan.ValueProperty, Key.Get());
+	}
+	return true;
+}
+
+// Key and value of a map both plain old data, decoded by DecodePodMapField
+static bool IsPodMap(const FLinkProtoFieldPlan& FieldPlan)
+{
+	const EPropertyFlags PodFlags = CPF_IsPlainOldData | CPF_NoDestructor;
+	return !FieldPlan.SubPlan
+		&& FieldPlan.ElementProperty->HasAllPropertyFlags(PodFlags)
+		&& FieldPlan.ValueProperty->HasAllPropertyFlags(PodFlags);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// FLinkProtoWireDecoder
+// ---------------------------------------------------------------------------------------------------------------------
+
+FLinkProtoFieldWireDecodeFunc FLinkProtoWireDecoder::ResolveFieldDecoder(const FLinkProtoFieldPlan& FieldPlan)
+{
+	switch (FieldPlan.Kind)
+	{
+	case ELinkProtoFieldKind::Scalar:
+		return &DecodeScalarField;
+	case ELinkProtoFieldKind::Struct:
+		return &DecodeStructField;
+	case ELinkProtoFieldKind::Array:
+		return FieldPlan.SubPlan ? &DecodeRepeatedMessageField : &DecodeRepeatedValueField;
+	case ELinkProtoFieldKind::Set:
+		return FieldPlan.SubPlan ? &DecodeRepeatedMessageField : &DecodeSetValueField;
+	case ELinkProtoFieldKind::Map:
+		return IsPodMap(FieldPlan) ? &DecodePodMapField : &DecodeMapField;
+	default:
+		return nullptr;
+	}
+}
+
+// A repeated numeric field accepts both its packed and its unpacked encoding
+bool FLinkProtoWireDecoder::AcceptsTag(const FLinkProtoFieldPlan& FieldPlan, uint32 Tag)
+{
+	if (Tag == FieldPlan.WireTag)
+	{
+		return true;
+	}
+	if ((FieldPlan.Kind != ELinkProtoFieldKind::Array && FieldPlan.Kind != ELinkProtoFieldKind::Set) || FieldPlan.SubPlan || IsLengthDelimited(FieldPlan.Field))
+	{
+		return false;
+	}
+	const WireFormatLite::WireType WireType = WireFormatLite::GetTagWireType(Tag);
+	return WireType == WireFormatLite::WIRETYPE_LENGTH_DELIMITED || WireType == ElementWireType(FieldPlan.Field);
+}
+
+static bool PreserveUnknownField(CodedInputStream& Input, uint32 Tag, TArray<uint8>* OutUnknownFields)
+{
+	std::string Raw;
+	{
+		StringOutputStream RawStream(&Raw);
+		CodedOutputStream RawOutput(&RawStream);
+		if (!WireFormatLite::SkipField(&Input, Tag, &RawOutput))
+		{
+			return false;
+		}
+	}
+	if (OutUnknownFields)
+	{
+		OutUnknownFields->Append(reinterpret_cast<const uint8*>(Raw.data()), static_cast<int32>(Raw.size()));
+	}
+	return true;
+}
+
+bool FLinkProtoWireDecoder::DecodeFields(const FLinkProtoStructPlan& Plan, CodedInputStream& Input, void* StructPtr,
+	ELinkProtoUnknownFieldPolicy UnknownFieldPolicy, TArray<uint8>* OutUnknownFields)
+{
+	const ELinkProtoUnknownFieldPolicy NestedPolicy = UnknownFieldPolicy == ELinkProtoUnknownFieldPolicy::Fail
+		? ELinkProtoUnknownFieldPolicy::Fail : ELinkProtoUnknownFieldPolicy::Skip;
+
+	// Sets of structs are filled without hashing, rehash them on every exit so the containers stay usable after a failure.
+	// Maps and scalar sets hash every key as it is decoded.
+	TArray<const FLinkProtoFieldPlan*, TInlineAllocator<4>> PendingRehash;
+	ON_SCOPE_EXIT
+	{
+		for (const FLinkProtoFieldPlan* FieldPlan : PendingRehash)
+		{
+			FScriptSetHelper(static_cast<const FSetProperty*>(FieldPlan->Property), FieldPlan->GetValuePtr(StructPtr)).Rehash();
+		}
+	};
+
+	for (uint32 Tag = Input.ReadTag(); Tag != 0; Tag = Input.ReadTag())
+	{
+		const int32 FieldNumber = WireFormatLite::GetTagFieldNumber(Tag);
+		const FLinkProtoFieldPlan* FieldPlan = Plan.FindFieldByNumber(FieldNumber);
+		if (FieldPlan && AcceptsTag(*FieldPlan, Tag))
+		{
+			if (FieldPlan->Kind == ELinkProtoFieldKind::Set && FieldPlan->SubPlan)
+			{
+				PendingRehash.AddUnique(FieldPlan);
+			}
+			if (!FieldPlan->WireDecode(*FieldPlan, Input, Tag, StructPtr, NestedPolicy))
+			{
+				UE_LOG(LogProto, Error, TEXT("Proto wire decode: malformed field %s in %s"), *FieldPlan->Name, *Plan.StructName);
+				return false;
+			}
+			continue;
+		}
+
+		if (WireFormatLite::GetTagWireType(Tag) == WireFormatLite::WIRETYPE_END_GROUP)
+		{
+			UE_LOG(LogProto, Error, TEXT("Proto wire decode: unexpected end group tag in %s"), *Plan.StructName);
+			return false;
+		}
+
+		// Fields of the descriptor without a bound property, or sent with a mismatching wire type, are not unknown fields
+		const bool bKnownField = FieldPlan || Plan.Descriptor->FindFieldByNumber(FieldNumber);
+		if (bKnownField || UnknownFieldPolicy == ELinkProtoUnknownFieldPolicy::Skip)
+		{
+			if (!WireFormatLite::SkipField(&Input, Tag))
+			{
+				UE_LOG(LogProto, Error, TEXT("Proto wire decode: malformed field %d in %s"), FieldNumber, *Plan.StructName);
+				return false;
+			}
+		}
+		else if (UnknownFieldPolicy == ELinkProtoUnknownFieldPolicy::Fail)
+		{
+			UE_LOG(LogProto, Error, TEXT("Proto wire decode: unknown field %d in %s"), FieldNumber, *Plan.StructName);
+			return false;
+		}
+		else if (!PreserveUnknownField(Input, Tag, OutUnknownFields))
+		{
+			UE_LOG(LogProto, Error, TEXT("Proto wire decode: malformed unknown field %d in %s"), FieldNumber, *Plan.StructName);
+			return false;
+		}
+	}
+	return true;
+}
+
+static bool DecodeMessage(const FLinkProtoStructPlan& Plan, CodedInputStream& Input, void* StructPtr,
+	ELinkProtoUnknownFieldPolicy UnknownFieldPolicy, TArray<uint8>* OutUnknownFields)
+{
+	FLinkProtoWireDecoder::ResetFields(Plan, StructPtr);
+	if (!FLinkProtoWireDecoder::DecodeFields(Plan, Input, StructPtr, UnknownFieldPolicy, OutUnknownFields))
+	{
+		return false;
+	}
+	if (!Input.ConsumedEntireMessage())
+	{
+		UE_LOG(LogProto, Error, TEXT("Proto wire decode: invalid tag in %s"), *Plan.StructName);
+		return false;
+	}
+	return true;
+}
+
+bool FLinkProtoWireDecoder::Decode(const FLinkProtoStructPlan& Plan, TConstArrayView<uint8> Data, void* StructPtr,
+	ELinkProtoUnknownFieldPolicy UnknownFieldPolicy, TArray<uint8>* OutUnknownFields)
+{
+	if (!Plan.IsValid() || !StructPtr)
+	{
+		UE_LOG(LogProto, Error, TEXT("Proto wire decode: invalid plan or struct for %s"), *Plan.StructName);
+		return false;
+	}
+
+	CodedInputStream Input(Data.GetData(), Data.Num());
+	return DecodeMessage(Plan, Input, StructPtr, UnknownFieldPolicy, OutUnknownFields);
+}
+
+bool FLinkProtoWireDecoder::Decode(const FLinkProtoStructPlan& Plan, ZeroCopyInputStream& Stream, void* StructPtr,
+	ELinkProtoUnknownFieldPolicy UnknownFieldPolicy, TArray<uint8>* OutUnknownFields)
+{
+	if (!Plan.IsValid() || !StructPtr)
+	{
+		UE_LOG(LogProto, Error, TEXT("Proto wire decode: invalid plan or struct for %s"), *Plan.StructName);
+		return false;
+	}
+
+	CodedInputStream Input(&Stream);
+	return DecodeMessage(Plan, Input, StructPtr, UnknownFieldPolicy, OutUnknownFields);
+}
+
+void FLinkProtoWireDecoder::ResetFields(const FLinkProtoStructPlan& Plan, void* StructPtr)
+{
+	for (const FLinkProtoFieldPlan& FieldPlan : Plan.Fields)
+	{
+		void* ValuePtr = FieldPlan.GetValuePtr(StructPtr);
+		if (FieldPlan.Kind == ELinkProtoFieldKind::Struct)
+		{
+			ResetFields(*FieldPlan.SubPlan, ValuePtr);
+		}
+		else
+		{
+			FieldPlan.Property->ClearValue(ValuePtr);
+			if (FieldPlan.bNonZeroDefault && Plan.Prototype)
+			{
+				// The prototype has no field set, so its getters return the declared defaults
+				FieldPlan.FromMessage(FieldPlan, *Plan.Prototype, StructPtr);
+			}
+		}
+	}
+}
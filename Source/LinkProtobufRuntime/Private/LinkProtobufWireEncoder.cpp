@@ -0,0 +1,738 @@
+// Copyright DarkestLink-Dev 2025 All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "LinkProtobufWireEncoder.h"
+#include "LinkProtobufCompat.h"
+#include "google/protobuf/descriptor.h"
+#include "google/protobuf/io/coded_stream.h"
+#include "google/protobuf/wire_format.h"
+#include "google/protobuf/wire_format_lite.h"
+#include "LinkProtobufConversionPlan.h"
+#include "LinkProtobufRuntime.h"
+#include "LinkProtobufUtf8.h"
+#include "LinkProtobufValueAccess.h"
+#include "LinkProtobufVarint.h"
+
+using FieldDescriptor      = google::protobuf::FieldDescriptor;
+using CodedOutputStream    = google::protobuf::io::CodedOutputStream;
+using ZeroCopyOutputStream = google::protobuf::io::ZeroCopyOutputStream;
+using WireFormat           = google::protobuf::internal::WireFormat;
+using WireFormatLite       = google::protobuf::internal::WireFormatLite;
+
+// Tag of the value field of a map entry holding a message
+static constexpr uint32 MapMessageValueTag = (2 << 3) | WireFormatLite::WIRETYPE_LENGTH_DELIMITED;
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Value helpers
+// ---------------------------------------------------------------------------------------------------------------------
+
+struct FLinkProtoStringPayload
+{
+	const TCHAR* Chars = nullptr;
+	// 8-bit characters of a FUtf8String/FAnsiString/byte array value, used instead of Chars when set
+	const ANSICHAR* NarrowChars = nullptr;
+	int32 Num = 0;
+	uint8 Byte = 0;
+	// uint8 property bound to a bytes field, written as a single byte
+	bool bSingleByte = false;
+	// NarrowChars are Latin-1 (FAnsiString) rather than UTF-8
+	bool bLatin1 = false;
+
+	FORCEINLINE bool IsEmpty() const { return !bSingleByte && Num == 0; }
+};
+
+static FORCEINLINE bool IsLengthDelimited(const FieldDescriptor* Field)
+{
+	return Field->cpp_type() == FieldDescriptor::CPPTYPE_STRING;
+}
+
+static FORCEINLINE WireFormatLite::WireType ElementWireType(const FieldDescriptor* Field)
+{
+	return WireFormatLite::WireTypeForFieldType(static_cast<WireFormatLite::FieldType>(Field->type()));
+}
+
+// Loads a numeric value as its wire payload (varint value or fixed32/fixed64 bits), false if the property cannot feed the field
+static FORCEINLINE bool LoadNumeric(const FieldDescriptor* Field, ELinkProtoValueType ValueType, const FProperty* Prop, const void* Ptr, uint64& OutRaw)
+{
+	int64 IntValue = 0;
+	double FloatValue = 0;
+	switch (Field->type())
+	{
+	case FieldDescriptor::TYPE_DOUBLE:
+		if (!FLinkProtoValueAccess::ReadDouble(ValueType, Prop, Ptr, FloatValue)) return false;
+		OutRaw = WireFormatLite::EncodeDouble(FloatValue);
+		return true;
+	case FieldDescriptor::TYPE_FLOAT:
+		if (!FLinkProtoValueAccess::ReadDouble(ValueType, Prop, Ptr, FloatValue)) return false;
+		OutRaw = WireFormatLite::EncodeFloat(static_cast<float>(FloatValue));
+		return true;
+	default:
+		break;
+	}
+
+	if (!FLinkProtoValueAccess::ReadInt64(ValueType, Prop, Ptr, IntValue)) return false;
+	switch (Field->type())
+	{
+	case FieldDescriptor::TYPE_INT32:
+		OutRaw = static_cast<uint64>(static_cast<int64>(static_cast<int32>(IntValue)));
+		return true;
+	case FieldDescriptor::TYPE_SINT32:
+		OutRaw = WireFormatLite::ZigZagEncode32(static_cast<int32>(IntValue));
+		return true;
+	case FieldDescriptor::TYPE_UINT32:
+	case FieldDescriptor::TYPE_FIXED32:
+	case FieldDescriptor::TYPE_SFIXED32:
+		OutRaw = static_cast<uint32>(IntValue);
+		return true;
+	case FieldDescriptor::TYPE_INT64:
+	case FieldDescriptor::TYPE_UINT64:
+	case FieldDescriptor::TYPE_FIXED64:
+	case FieldDescriptor::TYPE_SFIXED64:
+		OutRaw = static_cast<uint64>(IntValue);
+		return true;
+	case FieldDescriptor::TYPE_SINT64:
+		OutRaw = WireFormatLite::ZigZagEncode64(IntValue);
+		return true;
+	case FieldDescriptor::TYPE_BOOL:
+		OutRaw = IntValue != 0 ? 1 : 0;
+		return true;
+	case FieldDescriptor::TYPE_ENUM:
+		// Same as the reflection path, numbers unknown to the enum are not written
+		if (!Field->enum_type()->FindValueByNumber(static_cast<int32>(IntValue))) return false;
+		OutRaw = static_cast<uint64>(static_cast<int64>(static_cast<int32>(IntValue)));
+		return true;
+	default:
+		return false;
+	}
+}
+
+static FORCEINLINE uint32 NumericSize(WireFormatLite::WireType WireType, uint64 Raw)
+{
+	switch (WireType)
+	{
+	case WireFormatLite::WIRETYPE_FIXED32: return 4;
+	case WireFormatLite::WIRETYPE_FIXED64: return 8;
+	default: return static_cast<uint32>(CodedOutputStream::VarintSize64(Raw));
+	}
+}
+
+static FORCEINLINE uint8* WriteNumeric(WireFormatLite::WireType WireType, uint64 Raw, uint8* Target)
+{
+	switch (WireType)
+	{
+	case WireFormatLite::WIRETYPE_FIXED32: return CodedOutputStream::WriteLittleEndian32ToArray(static_cast<uint32>(Raw), Target);
+	case WireFormatLite::WIRETYPE_FIXED64: return CodedOutputStream::WriteLittleEndian64ToArray(Raw, Target);
+	default: return CodedOutputStream::WriteVarint64ToArray(Raw, Target);
+	}
+}
+
+static FORCEINLINE bool LoadStringPayload(const FieldDescriptor* Field, ELinkProtoValueType ValueType, const void* Ptr, FString& Scratch, FLinkProtoStringPayload& Out)
+{
+	if (ValueType == ELinkProtoValueType::UInt8 && Field->type() == FieldDescriptor::TYPE_BYTES)
+	{
+		Out.bSingleByte = true;
+		Out.Byte = *static_cast<const uint8*>(Ptr);
+		return true;
+	}
+	if (FLinkProtoValueAccess::ReadNarrowString(ValueType, Ptr, Out.NarrowChars, Out.Num))
+	{
+		Out.bLatin1 = ValueType == ELinkProtoValueType::AnsiString;
+		return true;
+	}
+	const FString* Str = FLinkProtoValueAccess::ReadString(ValueType, Ptr, Scratch);
+	if (!Str)
+	{
+		return false;
+	}
+	Out.Chars = **Str;
+	Out.Num = Str->Len();
+	return true;
+}
+
+static FORCEINLINE uint32 StringPayloadLength(const FLinkProtoStringPayload& Payload)
+{
+	if (Payload.bSingleByte) return 1;
+	if (Payload.NarrowChars)
+	{
+		return static_cast<uint32>(Payload.bLatin1 ? FLinkProtoUtf8::Latin1EncodedLength(Payload.NarrowChars, Payload.Num) : Payload.Num);
+	}
+	return static_cast<uint32>(FLinkProtoUtf8::EncodedLength(Payload.Chars, Payload.Num));
+}
+
+static FORCEINLINE uint8* WriteStringPayload(const FLinkProtoStringPayload& Payload, uint32 Length, uint8* Target)
+{
+	if (Payload.bSingleByte)
+	{
+		*Target = Payload.Byte;
+		return Target + 1;
+	}
+	if (Payload.NarrowChars)
+	{
+		if (Payload.bLatin1)
+		{
+			return FLinkProtoUtf8::EncodeLatin1(Payload.NarrowChars, Payload.Num, Target);
+		}
+		// Already UTF-8 or raw bytes, one copy
+		if (Length > 0)
+		{
+			FMemory::Memcpy(Target, Payload.NarrowChars, Length);
+		}
+		return Target + Length;
+	}
+	return FLinkProtoUtf8::Encode(Payload.Chars, Payload.Num, Target);
+}
+
+// Size of one tagged non-message value, 0 when nothing is written
+template<typename PrefixSinkType>
+static uint64 TaggedValueSize(const FieldDescriptor* Field, uint32 TagSize, ELinkProtoValueType ValueType, const FProperty* Prop,
+	const void* Ptr, bool bSkipDefault, PrefixSinkType& LengthPrefixes)
+{
+	if (IsLengthDelimited(Field))
+	{
+		FString Scratch;
+		FLinkProtoStringPayload Payload;
+		if (!LoadStringPayload(Field, ValueType, Ptr, Scratch, Payload) || (bSkipDefault && Payload.IsEmpty()))
+		{
+			return 0;
+		}
+		const uint32 Length = StringPayloadLength(Payload);
+		LengthPrefixes.Add(Length);
+		return TagSize + CodedOutputStream::VarintSize32(Length) + Length;
+	}
+
+	uint64 Raw = 0;
+	if (!LoadNumeric(Field, ValueType, Prop, Ptr, Raw) || (bSkipDefault && Raw == 0))
+	{
+		return 0;
+	}
+	return TagSize + NumericSize(ElementWireType(Field), Raw);
+}
+
+static uint8* WriteTaggedValue(const FieldDescriptor* Field, uint32 Tag, ELinkProtoValueType ValueType, const FProperty* Prop,
+	const void* Ptr, bool bSkipDefault, const uint32*& LengthPrefixes, uint8* Target)
+{
+	if (IsLengthDelimited(Field))
+	{
+		FString Scratch;
+		FLinkProtoStringPayload Payload;
+		if (!LoadStringPayload(Field, ValueType, Ptr, Scratch, Payload) || (bSkipDefault && Payload.IsEmpty()))
+		{
+			return Target;
+		}
+		const uint32 Length = *LengthPrefixes++;
+		Target = CodedOutputStream::WriteTagToArray(Tag, Target);
+		Target = CodedOutputStream::WriteVarint32ToArray(Length, Target);
+		return WriteStringPayload(Payload, Length, Target);
+	}
+
+	uint64 Raw = 0;
+	if (!LoadNumeric(Field, ValueType, Prop, Ptr, Raw) || (bSkipDefault && Raw == 0))
+	{
+		return Target;
+	}
+	Target = CodedOutputStream::WriteTagToArray(Tag, Target);
+	return WriteNumeric(ElementWireType(Field), Raw, Target);
+}
+
+template<typename FuncType>
+static FORCEINLINE void ForEachElement(const FLinkProtoFieldPlan& FieldPlan, const void* ValuePtr, FuncType&& Func)
+{
+	if (FieldPlan.Kind == ELinkProtoFieldKind::Array)
+	{
+		FScriptArrayHelper ArrayHelper(static_cast<const FArrayProperty*>(FieldPlan.Property), ValuePtr);
+		for (int32 i = 0; i < ArrayHelper.Num(); ++i)
+		{
+			Func(ArrayHelper.GetRawPtr(i));
+		}
+	}
+	else
+	{
+		FScriptSetHelper SetHelper(static_cast<const FSetProperty*>(FieldPlan.Property), ValuePtr);
+		for (int32 i = 0; i < SetHelper.GetMaxIndex(); ++i)
+		{
+			if (SetHelper.IsValidIndex(i))
+			{
+				Func(SetHelper.GetElementPtr(i));
+			}
+		}
+	}
+}
+
+// Values handed to the varint kernels per call
+static constexpr int32 VarintChunkSize = 256;
+
+// Loads the varint payloads of a packed repeated field in chunks and hands each chunk to Func
+template<typename FuncType>
+static FORCEINLINE void ForEachVarintChunk(const FLinkProtoFieldPlan& FieldPlan, const void* ValuePtr, FuncType&& Func)
+{
+	uint64 Raw[VarintChunkSize];
+	int32 Num = 0;
+	ForEachElement(FieldPlan, ValuePtr, [&](const void* ElemPtr)
+	{
+		if (LoadNumeric(FieldPlan.Field, FieldPlan.ValueType, FieldPlan.ElementProperty, ElemPtr, Raw[Num]) && ++Num == VarintChunkSize)
+		{
+			Func(Raw, Num);
+			Num = 0;
+		}
+	});
+	if (Num > 0)
+	{
+		Func(Raw, Num);
+	}
+}
+
+static FORCEINLINE uint64 DelimitedSize(uint32 TagSize, uint64 PayloadSize)
+{
+	return TagSize + CodedOutputStream::VarintSize32(static_cast<uint32>(PayloadSize)) + PayloadSize;
+}
+
+static FORCEINLINE uint8* WriteDelimitedHeader(uint32 Tag, uint32 Length, uint8* Target)
+{
+	Target = CodedOutputStream::WriteTagToArray(Tag, Target);
+	return CodedOutputStream::WriteVarint32ToArray(Length, Target);
+}
+
+// Nested sizes are stored as uint32, anything larger fails the final size check
+static FORCEINLINE uint32 ClampPrefix(uint64 Size)
+{
+	return static_cast<uint32>(FMath::Min<uint64>(Size, MAX_uint32));
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Size pass
+// ---------------------------------------------------------------------------------------------------------------------
+
+// Length prefix sink of a size only pass, nothing is recorded since no write pass follows
+struct FLinkProtoDiscardedPrefixes
+{
+	uint32 Discarded = 0;
+
+	FORCEINLINE int32 AddUninitialized(int32) { return 0; }
+	FORCEINLINE int32 Add(uint32) { return 0; }
+	FORCEINLINE uint32& operator[](int32) { return Discarded; }
+};
+
+template<typename PrefixSinkType>
+static uint64 StructSize(const FLinkProtoStructPlan& Plan, const void* StructPtr, PrefixSinkType& LengthPrefixes, TArray<FLinkProtoFieldSize>* OutFieldSizes = nullptr);
+
+template<typename PrefixSinkType>
+static uint64 NestedMessageSize(const FLinkProtoStructPlan& SubPlan, uint32 TagSize, const void* ValuePtr, PrefixSinkType& LengthPrefixes)
+{
+	const int32 Slot = LengthPrefixes.AddUninitialized(1);
+	const uint64 NestedSize = StructSize(SubPlan, ValuePtr, LengthPrefixes);
+	LengthPrefixes[Slot] = ClampPrefix(NestedSize);
+	return DelimitedSize(TagSize, NestedSize);
+}
+
+template<typename PrefixSinkType>
+static uint64 RepeatedFieldSize(const FLinkProtoFieldPlan& FieldPlan, const void* ValuePtr, PrefixSinkType& LengthPrefixes)
+{
+	uint64 Size = 0;
+	if (FieldPlan.SubPlan)
+	{
+		ForEachElement(FieldPlan, ValuePtr, [&](const void* ElemPtr)
+		{
+			Size += NestedMessageSize(*FieldPlan.SubPlan, FieldPlan.TagSize, ElemPtr, LengthPrefixes);
+		});
+	}
+	else if (FieldPlan.bPacked)
+	{
+		const int32 Slot = LengthPrefixes.AddUninitialized(1);
+		const WireFormatLite::WireType WireType = ElementWireType(FieldPlan.Field);
+		uint64 PayloadSize = 0;
+		if (FieldPlan.FixedWireSize > 0)
+		{
+			FScriptArrayHelper ArrayHelper(static_cast<const FArrayProperty*>(FieldPlan.Property), ValuePtr);
+			PayloadSize = static_cast<uint64>(ArrayHelper.Num()) * FieldPlan.FixedWireSize;
+		}
+		else if (WireType == WireFormatLite::WIRETYPE_VARINT)
+		{
+			const FLinkProtoVarintKernels& Kernels = FLinkProtoVarintKernels::Get();
+			ForEachVarintChunk(FieldPlan, ValuePtr, [&](const uint64* Raw, int32 Num)
+			{
+				PayloadSize += Kernels.EncodedSize(Raw, Num);
+			});
+		}
+		else
+		{
+			ForEachElement(FieldPlan, ValuePtr, [&](const void* ElemPtr)
+			{
+				uint64 Raw = 0;
+				if (LoadNumeric(FieldPlan.Field, FieldPlan.ValueType, FieldPlan.ElementProperty, ElemPtr, Raw))
+				{
+					PayloadSize += NumericSize(WireType, Raw);
+				}
+			});
+		}
+		LengthPrefixes[Slot] = ClampPrefix(PayloadSize);
+		if (PayloadSize > 0)
+		{
+			Size += DelimitedSize(FieldPlan.TagSize, PayloadSize);
+		}
+	}
+	else
+	{
+		ForEachElement(FieldPlan, ValuePtr, [&](const void* ElemPtr)
+		{
+			Size += TaggedValueSize(FieldPlan.Field, FieldPlan.TagSize, FieldPlan.ValueType, FieldPlan.ElementProperty, ElemPtr, false, LengthPrefixes);
+		});
+	}
+	return Size;
+}
+
+template<typename PrefixSinkType>
+static uint64 MapFieldSize(const FLinkProtoFieldPlan& FieldPlan, const void* ValuePtr, PrefixSinkType& LengthPrefixes)
+{
+	uint64 Size = 0;
+	FScriptMapHelper MapHelper(static_cast<const FMapProperty*>(FieldPlan.Property), ValuePtr);
+	for (int32 idx = 0; idx < MapHelper.GetMaxIndex(); ++idx)
+	{
+		if (!MapHelper.IsValidIndex(idx))
+			continue;
+
+		// Map entries always carry both key and value
+		const int32 Slot = LengthPrefixes.AddUninitialized(1);
+		uint64 EntrySize = TaggedValueSize(FieldPlan.KeyField, 1, FieldPlan.ValueType, FieldPlan.ElementProperty, MapHelper.GetKeyPtr(idx), false, LengthPrefixes);
+		if (FieldPlan.SubPlan)
+		{
+			EntrySize += NestedMessageSize(*FieldPlan.SubPlan, 1, MapHelper.GetValuePtr(idx), LengthPrefixes);
+		}
+		else
+		{
+			EntrySize += TaggedValueSize(FieldPlan.ValueField, 1, FieldPlan.MapValueType, FieldPlan.ValueProperty, MapHelper.GetValuePtr(idx), false, LengthPrefixes);
+		}
+		LengthPrefixes[Slot] = ClampPrefix(EntrySize);
+		Size += DelimitedSize(FieldPlan.TagSize, EntrySize);
+	}
+	return Size;
+}
+
+template<typename PrefixSinkType>
+static uint64 StructSize(const FLinkProtoStructPlan& Plan, const void* StructPtr, PrefixSinkType& LengthPrefixes, TArray<FLinkProtoFieldSize>* OutFieldSizes)
+{
+	uint64 Size = 0;
+	for (const FLinkProtoFieldPlan& FieldPlan : Plan.Fields)
+	{
+		const void* ValuePtr = FieldPlan.GetValuePtr(StructPtr);
+		uint64 FieldSize = 0;
+		switch (FieldPlan.Kind)
+		{
+		case ELinkProtoFieldKind::Scalar:
+			FieldSize = TaggedValueSize(FieldPlan.Field, FieldPlan.TagSize, FieldPlan.ValueType, FieldPlan.Property, ValuePtr, FieldPlan.bImplicitPresence, LengthPrefixes);
+			break;
+		case ELinkProtoFieldKind::Struct:
+			// Nested messages are always present, an empty struct still writes its tag and a zero length
+			FieldSize = NestedMessageSize(*FieldPlan.SubPlan, FieldPlan.TagSize, ValuePtr, LengthPrefixes);
+			break;
+		case ELinkProtoFieldKind::Array:
+		case ELinkProtoFieldKind::Set:
+			FieldSize = RepeatedFieldSize(FieldPlan, ValuePtr, LengthPrefixes);
+			break;
+		case ELinkProtoFieldKind::Map:
+			FieldSize = MapFieldSize(FieldPlan, ValuePtr, LengthPrefixes);
+			break;
+		}
+		if (OutFieldSizes)
+		{
+			OutFieldSizes->Add({ FieldPlan.Field->number(), FieldPlan.Name, FieldSize });
+		}
+		Size += FieldSize;
+	}
+	return Size;
+}
+
+uint64 FLinkProtoWireEncoder::ComputeSize(const FLinkProtoStructPlan& Plan, const void* StructPtr, TArray<uint32>& LengthPrefixes)
+{
+	return StructSize(Plan, StructPtr, LengthPrefixes);
+}
+
+uint64 FLinkProtoWireEncoder::ComputeEncodedSize(const FLinkProtoStructPlan& Plan, const void* StructPtr, TArray<FLinkProtoFieldSize>* OutFieldSizes)
+{
+	FLinkProtoDiscardedPrefixes LengthPrefixes;
+	if (OutFieldSizes)
+	{
+		OutFieldSizes->Reset(Plan.Fields.Num());
+	}
+	return StructSize(Plan, StructPtr, LengthPrefixes, OutFieldSizes);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Write pass
+// ---------------------------------------------------------------------------------------------------------------------
+
+static uint8* WriteNestedMessage(const FLinkProtoStructPlan& SubPlan, uint32 Tag, const void* ValuePtr, const uint32*& LengthPrefixes, uint8* Target)
+{
+	Target = WriteDelimitedHeader(Tag, *LengthPrefixes++, Target);
+	return FLinkProtoWireEncoder::Write(SubPlan, ValuePtr, LengthPrefixes, Target);
+}
+
+static uint8* WriteRepeatedField(const FLinkProtoFieldPlan& FieldPlan, const void* ValuePtr, const uint32*& LengthPrefixes, uint8* Target)
+{
+	if (FieldPlan.SubPlan)
+	{
+		ForEachElement(FieldPlan, ValuePtr, [&](const void* ElemPtr)
+		{
+			Target = WriteNestedMessage(*FieldPlan.SubPlan, FieldPlan.WireTag, ElemPtr, LengthPrefixes, Target);
+		});
+	}
+	else if (FieldPlan.bPacked)
+	{
+		const uint32 PayloadSize = *LengthPrefixes++;
+		if (PayloadSize == 0)
+		{
+			return Target;
+		}
+		const WireFormatLite::WireType WireType = ElementWireType(FieldPlan.Field);
+		Target = WriteDelimitedHeader(FieldPlan.WireTag, PayloadSize, Target);
+		if (FieldPlan.FixedWireSize > 0)
+		{
+			// The array memory is the payload
+			FScriptArrayHelper ArrayHelper(static_cast<const FArrayProperty*>(FieldPlan.Property), ValuePtr);
+			FMemory::Memcpy(Target, ArrayHelper.GetRawPtr(0), PayloadSize);
+			return Target + PayloadSize;
+		}
+		if (WireType == WireFormatLite::WIRETYPE_VARINT)
+		{
+			const FLinkProtoVarintKernels& Kernels = FLinkProtoVarintKernels::Get();
+			ForEachVarintChunk(FieldPlan, ValuePtr, [&](const uint64* Raw, int32 Num)
+			{
+				Target = Kernels.Encode(Raw, Num, Target);
+			});
+			return Target;
+		}
+		ForEachElement(FieldPlan, ValuePtr, [&](const void* ElemPtr)
+		{
+			uint64 Raw = 0;
+			if (LoadNumeric(FieldPlan.Field, FieldPlan.ValueType, FieldPlan.ElementProperty, ElemPtr, Raw))
+			{
+				Target = WriteNumeric(WireType, Raw, Target);
+			}
+		});
+	}
+	else
+	{
+		ForEachElement(FieldPlan, ValuePtr, [&](const void* ElemPtr)
+		{
+			Target = WriteTaggedValue(FieldPlan.Field, FieldPlan.WireTag, FieldPlan.ValueType, FieldPlan.ElementProperty, ElemPtr, false, LengthPrefixes, Target);
+		});
+	}
+	return Target;
+}
+
+static uint8* WriteMapField(const FLinkProtoFieldPlan& FieldPlan, const void* ValuePtr, const uint32*& LengthPrefixes, uint8* Target)
+{
+	const uint32 KeyTag = WireFormat::MakeTag(FieldPlan.KeyField);
+	const uint32 ValueTag = WireFormat::MakeTag(FieldPlan.ValueField);
+	FScriptMapHelper MapHelper(static_cast<const FMapProperty*>(FieldPlan.Property), ValuePtr);
+	for (int32 idx = 0; idx < MapHelper.GetMaxIndex(); ++idx)
+	{
+		if (!MapHelper.IsValidIndex(idx))
+			continue;
+
+		Target = WriteDelimitedHeader(FieldPlan.WireTag, *LengthPrefixes++, Target);
+		Target = WriteTaggedValue(FieldPlan.KeyField, KeyTag, FieldPlan.ValueType, FieldPlan.ElementProperty, MapHelper.GetKeyPtr(idx), false, LengthPrefixes, Target);
+		if (FieldPlan.SubPlan)
+		{
+			Target = WriteNestedMessage(*FieldPlan.SubPlan, MapMessageValueTag, MapHelper.GetValuePtr(idx), LengthPrefixes, Target);
+		}
+		else
+		{
+			Target = WriteTaggedValue(FieldPlan.ValueField, ValueTag, FieldPlan.MapValueType, FieldPlan.ValueProperty, MapHelper.GetValuePtr(idx), false, LengthPrefixes, Target);
+		}
+	}
+	return Target;
+}
+
+uint8* FLinkProtoWireEncoder::Write(const FLinkProtoStructPlan& Plan, const void* StructPtr, const uint32*& LengthPrefixes, uint8* Target)
+{
+	for (const FLinkProtoFieldPlan& FieldPlan : Plan.Fields)
+	{
+		const void* ValuePtr = FieldPlan.GetValuePtr(StructPtr);
+		switch (FieldPlan.Kind)
+		{
+		case ELinkProtoFieldKind::Scalar:
+			Target = WriteTaggedValue(FieldPlan.Field, FieldPlan.WireTag, FieldPlan.ValueType, FieldPlan.Property, ValuePtr, FieldPlan.bImplicitPresence, LengthPrefixes, Target);
+			break;
+		case ELinkProtoFieldKind::Struct:
+			Target = WriteNestedMessage(*FieldPlan.SubPlan, FieldPlan.WireTag, ValuePtr, LengthPrefixes, Target);
+			break;
+		case ELinkProtoFieldKind::Array:
+		case ELinkProtoFieldKind::Set:
+			Target = WriteRepeatedField(FieldPlan, ValuePtr, LengthPrefixes, Target);
+			break;
+		case ELinkProtoFieldKind::Map:
+			Target = WriteMapField(FieldPlan, ValuePtr, LengthPrefixes, Target);
+			break;
+		}
+	}
+	return Target;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Entry points
+// ---------------------------------------------------------------------------------------------------------------------
+
+// Length prefix scratch reused by every encode on the calling thread
+static TArray<uint32>& GetLengthPrefixScratch()
+{
+	static thread_local TArray<uint32> LengthPrefixes;
+	LengthPrefixes.Reset();
+	return LengthPrefixes;
+}
+
+template<typename BufferType>
+static bool EncodeInto(const FLinkProtoStructPlan& Plan, const void* StructPtr, BufferType& OutBuffer)
+{
+	if (!Plan.IsValid() || !StructPtr)
+	{
+		UE_LOG(LogProto, Error, TEXT("Proto wire encode: invalid plan or struct for %s"), *Plan.StructName);
+		return false;
+	}
+
+	TArray<uint32>& LengthPrefixes = GetLengthPrefixScratch();
+	const uint64 Size = FLinkProtoWireEncoder::ComputeSize(Plan, StructPtr, LengthPrefixes);
+	if (Size > static_cast<uint64>(MAX_int32))
+	{
+		UE_LOG(LogProto, Error, TEXT("Proto wire encode: %s exceeds the 2GB message limit (%llu bytes)"), *Plan.StructName, Size);
+		return false;
+	}
+
+	uint8* Begin = OutBuffer.Allocate(static_cast<int32>(Size));
+	const uint32* Cursor = LengthPrefixes.GetData();
+	uint8* End = FLinkProtoWireEncoder::Write(Plan, StructPtr, Cursor, Begin);
+	check(End == Begin + Size);
+	check(Cursor == LengthPrefixes.GetData() + LengthPrefixes.Num());
+	return true;
+}
+
+struct FLinkProtoByteArrayBuffer
+{
+	TArray<uint8>& Bytes;
+	uint8* Allocate(int32 Size)
+	{
+		Bytes.SetNumUninitialized(Size, LINKPROTO_NO_SHRINK);
+		return Bytes.GetData();
+	}
+};
+
+struct FLinkProtoStdStringBuffer
+{
+	std::string& String;
+	uint8* Allocate(int32 Size)
+	{
+		String.resize(Size);
+		return reinterpret_cast<uint8*>(&String[0]);
+	}
+};
+
+// Writes into the coded stream's buffer when it has room for the whole struct, through Scratch otherwise
+struct FLinkProtoCodedStreamBuffer
+{
+	CodedOutputStream& Output;
+	TArray<uint8>& Scratch;
+	bool bLengthPrefixed;
+	bool bDirect = false;
+
+	uint8* Allocate(int32 Size)
+	{
+		if (bLengthPrefixed)
+		{
+			Output.WriteVarint32(static_cast<uint32>(Size));
+		}
+		if (uint8* Direct = Output.GetDirectBufferForNBytesAndAdvance(Size))
+		{
+			bDirect = true;
+			return Direct;
+		}
+		Scratch.SetNumUninitialized(Size, LINKPROTO_NO_SHRINK);
+		return Scratch.GetData();
+	}
+
+	bool Finish()
+	{
+		if (!bDirect)
+		{
+			Output.WriteRaw(Scratch.GetData(), Scratch.Num());
+		}
+		return !Output.HadError();
+	}
+};
+
+bool FLinkProtoWireEncoder::Encode(const FLinkProtoStructPlan& Plan, const void* StructPtr, TArray<uint8>& OutBytes)
+{
+	FLinkProtoByteArrayBuffer Buffer{OutBytes};
+	return EncodeInto(Plan, StructPtr, Buffer);
+}
+
+bool FLinkProtoWireEncoder::Encode(const FLinkProtoStructPlan& Plan, const void* StructPtr, std::string& OutString)
+{
+	FLinkProtoStdStringBuffer Buffer{OutString};
+	return EncodeInto(Plan, StructPtr, Buffer);
+}
+
+bool FLinkProtoWireEncoder::Encode(const FLinkProtoStructPlan& Plan, const void* StructPtr, ZeroCopyOutputStream& Output)
+{
+	CodedOutputStream CodedOutput(&Output);
+	TArray<uint8> Scratch;
+	FLinkProtoCodedStreamBuffer Buffer{CodedOutput, Scratch, false};
+	if (!EncodeInto(Plan, StructPtr, Buffer))
+	{
+		return false;
+	}
+	Buffer.Finish();
+	CodedOutput.Trim();
+	if (CodedOutput.HadError())
+	{
+		UE_LOG(LogProto, Error, TEXT("Proto wire encode: output stream failed for %s"), *Plan.StructName);
+		return false;
+	}
+	return true;
+}
+
+bool FLinkProtoWireEncoder::EncodeDelimited(const FLinkProtoStructPlan& Plan, const void* StructPtr, CodedOutputStream& Output, TArray<uint8>& Scratch)
+{
+	FLinkProtoCodedStreamBuffer Buffer{Output, Scratch, true};
+	if (!EncodeInto(Plan, StructPtr, Buffer))
+	{
+		return false;
+	}
+	if (!Buffer.Finish())
+	{
+		UE_LOG(LogProto, Error, TEXT("Proto wire encode: output stream failed for %s"), *Plan.StructName);
+		return false;
+	}
+	return true;
+}
+
+bool FLinkProtoWireEncoder::EncodeMapField(const FLinkProtoFieldPlan& FieldPlan, const void* StructPtr, std::string& OutString)
+{
+	check(FieldPlan.Kind == ELinkProtoFieldKind::Map);
+	const void* ValuePtr = FieldPlan.GetValuePtr(StructPtr);
+	TArray<uint32>& LengthPrefixes = GetLengthPrefixScratch();
+	const uint64 Size = MapFieldSize(FieldPlan, ValuePtr, LengthPrefixes);
+	if (Size > static_cast<uint64>(MAX_int32))
+	{
+		UE_LOG(LogProto, Error, TEXT("Proto wire encode: map %s exceeds the 2GB message limit (%llu bytes)"), *FieldPlan.Name, Size);
+		return false;
+	}
+
+	FLinkProtoStdStringBuffer Buffer{OutString};
+	uint8* Begin = Buffer.Allocate(static_cast<int32>(Size));
+	const uint32* Cursor = LengthPrefixes.GetData();
+	uint8* End = WriteMapField(FieldPlan, ValuePtr, Cursor, Begin);
+	check(End == Begin + Size);
+	check(Cursor == LengthPrefixes.GetData() + LengthPrefixes.Num());
+	return true;
+}
@@ -0,0 +1,332 @@
+// Copyright DarkestLink-Dev 2025 All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// SPDX-License-Identifier: Apache-2.0
+
+
+#include "LinkProtobufWirePatch.h"
+#include "LinkProtobufCompat.h"
+#include "LinkProtobufRuntime.h"
+#include "google/protobuf/descriptor.h"
+#include "google/protobuf/io/coded_stream.h"
+#include "google/protobuf/wire_format_lite.h"
+
+using CodedInputStream  = google::protobuf::io::CodedInputStream;
+using CodedOutputStream = google::protobuf::io::CodedOutputStream;
+using WireFormatLite    = google::protobuf::internal::WireFormatLite;
+
+namespace
+{
+	// Length prefix of a nested message on the path
+	struct FEnclosingMessage
+	{
+		int32 PrefixOffset = 0;
+		int32 PrefixSize = 0;
+		int32 Length = 0;
+	};
+
+	struct FFieldLocation
+	{
+		TArray<FEnclosingMessage, TInlineAllocator<8>> Enclosing;
+		// Path segments found, the field itself exists when this is the path length
+		int32 FoundDepth = 0;
+		// Last occurrence of the field: its value (after the tag) and wire type
+		int32 ValueOffset = 0;
+		int32 ValueEnd = 0;
+		WireFormatLite::WireType WireType = WireFormatLite::WIRETYPE_VARINT;
+		// End of the innermost existing message, where absent fields are appended
+		int32 AppendOffset = 0;
+	};
+
+	typedef TArray<uint8, TInlineAllocator<16>> FEncodedValue;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Scan
+// ---------------------------------------------------------------------------------------------------------------------
+
+// Finds the last occurrence of Number among the fields in [Begin, End). False on malformed bytes
+static bool FindLastOccurrence(const uint8* Data, int32 Begin, int32 End, int32 Number, FFieldLocation& Location, bool& bOutFound)
+{
+	bOutFound = false;
+	CodedInputStream Input(Data + Begin, End - Begin);
+	for (uint32 Tag = Input.ReadTag(); Tag != 0; Tag = Input.ReadTag())
+	{
+		const int32 ValueOffset = Begin + Input.CurrentPosition();
+		if (WireFormatLite::GetTagWireType(Tag) == WireFormatLite::WIRETYPE_END_GROUP || !WireFormatLite::SkipField(&Input, Tag))
+		{
+			return false;
+		}
+		if (WireFormatLite::GetTagFieldNumber(Tag) == Number)
+		{
+			bOutFound = true;
+			Location.ValueOffset = ValueOffset;
+			Location.ValueEnd = Begin + Input.CurrentPosition();
+			Location.WireType = WireFormatLite::GetTagWireType(Tag);
+		}
+	}
+	return Input.ConsumedEntireMessage();
+}
+
+static bool LocateField(TConstArrayView<uint8> Data, TConstArrayView<int32> FieldPath, FFieldLocation& Location)
+{
+	if (FieldPath.Num() == 0)
+	{
+		UE_LOG(LogProto, Error, TEXT("Proto wire patch: empty field path"));
+		return false;
+	}
+
+	int32 Begin = 0;
+	int32 End = Data.Num();
+	for (int32 Depth = 0; Depth < FieldPath.Num(); ++Depth)
+	{
+		const int32 Number = FieldPath[Depth];
+		if (Number <= 0 || Number > google::protobuf::FieldDescriptor::kMaxNumber)
+		{
+			UE_LOG(LogProto, Error, TEXT("Proto wire patch: invalid field number %d"), Number);
+			return false;
+		}
+		bool bFound = false;
+		if (!FindLastOccurrence(Data.GetData(), Begin, End, Number, Location, bFound))
+		{
+			UE_LOG(LogProto, Error, TEXT("Proto wire patch: malformed message at depth %d"), Depth);
+			return false;
+		}
+		if (!bFound)
+		{
+			Location.FoundDepth = Depth;
+			Location.AppendOffset = End;
+			return true;
+		}
+		if (Depth == FieldPath.Num() - 1)
+		{
+			break;
+		}
+		if (Location.WireType != WireFormatLite::WIRETYPE_LENGTH_DELIMITED)
+		{
+			UE_LOG(LogProto, Error, TEXT("Proto wire patch: field %d on the path is not a message"), Number);
+			return false;
+		}
+
+		// SkipField already validated the prefix
+		CodedInputStream Prefix(Data.GetData() + Location.ValueOffset, Location.ValueEnd - Location.ValueOffset);
+		uint32 Length = 0;
+		Prefix.ReadVarint32(&Length);
+		FEnclosingMessage& Message = Location.Enclosing.AddDefaulted_GetRef();
+		Message.PrefixOffset = Location.ValueOffset;
+		Message.PrefixSize = Prefix.CurrentPosition();
+		Message.Length = static_cast<int32>(Length);
+		Begin = Message.PrefixOffset + Message.PrefixSize;
+		End = Location.ValueEnd;
+	}
+	Location.FoundDepth = FieldPath.Num();
+	return true;
+}
+
+// Locates an existing field of the expected wire type and opens a stream on its value
+template<typename ReadFuncType>
+static bool ReadField(TConstArrayView<uint8> Data, TConstArrayView<int32> FieldPath, WireFormatLite::WireType WireType, ReadFuncType&& Read)
+{
+	FFieldLocation Location;
+	if (!LocateField(Data, FieldPath, Location) || Location.FoundDepth != FieldPath.Num() || Location.WireType != WireType)
+	{
+		return false;
+	}
+	CodedInputStream Input(Data.GetData() + Location.ValueOffset, Location.ValueEnd - Location.ValueOffset);
+	return Read(Input, Location.ValueOffset);
+}
+
+bool FLinkProtoWirePatch::ReadVarint(TConstArrayView<uint8> Data, TConstArrayView<int32> FieldPath, uint64& OutValue)
+{
+	return ReadField(Data, FieldPath, WireFormatLite::WIRETYPE_VARINT,
+		[&OutValue](CodedInputStream& Input, int32) { return Input.ReadVarint64(&OutValue); });
+}
+
+bool FLinkProtoWirePatch::ReadFixed32(TConstArrayView<uint8> Data, TConstArrayView<int32> FieldPath, uint32& OutValue)
+{
+	return ReadField(Data, FieldPath, WireFormatLite::WIRETYPE_FIXED32,
+		[&OutValue](CodedInputStream& Input, int32) { return Input.ReadLittleEndian32(&OutValue); });
+}
+
+bool FLinkProtoWirePatch::ReadFixed64(TConstArrayView<uint8> Data, TConstArrayView<int32> FieldPath, uint64& OutValue)
+{
+	return ReadField(Data, FieldPath, WireFormatLite::WIRETYPE_FIXED64,
+		[&OutValue](CodedInputStream& Input, int32) { return Input.ReadLittleEndian64(&OutValue); });
+}
+
+bool FLinkProtoWirePatch::ReadLengthDelimited(TConstArrayView<uint8> Data, TConstArrayView<int32> FieldPath, TConstArrayView<uint8>& OutValue)
+{
+	return ReadField(Data, FieldPath, WireFormatLite::WIRETYPE_LENGTH_DELIMITED,
+		[&Data, &OutValue](CodedInputStream& Input, int32 ValueOffset)
+		{
+			uint32 Length = 0;
+			if (!Input.ReadVarint32(&Length))
+			{
+				return false;
+			}
+			OutValue = MakeArrayView(Data.GetData() + ValueOffset + Input.CurrentPosition(), static_cast<int32>(Length));
+			return true;
+		});
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Patch
+// ---------------------------------------------------------------------------------------------------------------------
+
+template<typename ArrayType>
+static void AppendVarint(ArrayType& Out, uint64 Value)
+{
+	uint8 Buffer[10];
+	const uint8* End = CodedOutputStream::WriteVarint64ToArray(Value, Buffer);
+	Out.Append(Buffer, static_cast<int32>(End - Buffer));
+}
+
+// Writes Value as a varint of exactly Size bytes, padding it with continuation bytes. VarintSize64(Value) must be <= Size
+static void WritePaddedVarint(uint64 Value, int32 Size, uint8* Out)
+{
+	for (int32 Index = 0; Index < Size; ++Index)
+	{
+		const uint8 Bits = static_cast<uint8>(Value & 0x7F);
+		Value >>= 7;
+		Out[Index] = Index < Size - 1 ? (Bits | 0x80) : Bits;
+	}
+}
+
+// Replaces OldSize bytes at Offset with Bytes, returns the change in size
+static int32 Splice(TArray<uint8>& Data, int32 Offset, int32 OldSize, TConstArrayView<uint8> Bytes)
+{
+	const int32 Delta = Bytes.Num() - OldSize;
+	if (Delta > 0)
+	{
+		Data.InsertUninitialized(Offset + OldSize, Delta);
+	}
+	else if (Delta < 0)
+	{
+		Data.RemoveAt(Offset + Bytes.Num(), -Delta, LINKPROTO_NO_SHRINK);
+	}
+	FMemory::Memcpy(Data.GetData() + Offset, Bytes.GetData(), Bytes.Num());
+	return Delta;
+}
+
+// Grows or shrinks the enclosing length prefixes by Delta, innermost first. Prefixes precede the bytes that changed,
+// so rewriting one never moves the ones further out
+static bool UpdateEnclosingLengths(TArray<uint8>& Data, TConstArrayView<FEnclosingMessage> Enclosing, int32 Delta)
+{
+	for (int32 Index = Enclosing.Num() - 1; Index >= 0 && Delta != 0; --Index)
+	{
+		const FEnclosingMessage& Message = Enclosing[Index];
+		const int64 NewLength = static_cast<int64>(Message.Length) + Delta;
+		if (NewLength < 0 || NewLength > MAX_int32)
+		{
+			return false;
+		}
+		const int32 NewPrefixSize = static_cast<int32>(CodedOutputStream::VarintSize32(static_cast<uint32>(NewLength)));
+		if (NewPrefixSize <= Message.PrefixSize)
+		{
+			WritePaddedVarint(static_cast<uint64>(NewLength), Message.PrefixSize, Data.GetData() + Message.PrefixOffset);
+			continue;
+		}
+		FEncodedValue Prefix;
+		AppendVarint(Prefix, static_cast<uint64>(NewLength));
+		Delta += Splice(Data, Message.PrefixOffset, Message.PrefixSize, Prefix);
+	}
+	return true;
+}
+
+// Writes the encoded value (without tag) of the last field of the path. VarintValue is set for varint fields, whose
+// shorter encodings are padded to stay in place
+static bool WriteField(TArray<uint8>& Data, TConstArrayView<int32> FieldPath, WireFormatLite::WireType WireType,
+	TConstArrayView<uint8> Encoded, const uint64* VarintValue)
+{
+	FFieldLocation Location;
+	if (!LocateField(Data, FieldPath, Location))
+	{
+		return false;
+	}
+
+	int32 Delta = 0;
+	if (Location.FoundDepth == FieldPath.Num())
+	{
+		if (Location.WireType != WireType)
+		{
+			UE_LOG(LogProto, Error, TEXT("Proto wire patch: field %d has wire type %d, not %d"), FieldPath[FieldPath.Num() - 1], static_cast<int32>(Location.WireType), static_cast<int32>(WireType));
+			return false;
+		}
+		const int32 OldSize = Location.ValueEnd - Location.ValueOffset;
+		if (Encoded.Num() == OldSize)
+		{
+			FMemory::Memcpy(Data.GetData() + Location.ValueOffset, Encoded.GetData(), Encoded.Num());
+			return true;
+		}
+		if (VarintValue && Encoded.Num() < OldSize)
+		{
+			WritePaddedVarint(*VarintValue, OldSize, Data.GetData() + Location.ValueOffset);
+			return true;
+		}
+		Delta = Splice(Data, Location.ValueOffset, OldSize, Encoded);
+	}
+	else
+	{
+		// Tag and value of the field, wrapped in every nested message of the path that is missing
+		TArray<uint8> Inserted;
+		AppendVarint(Inserted, WireFormatLite::MakeTag(FieldPath[FieldPath.Num() - 1], WireType));
+		Inserted.Append(Encoded.GetData(), Encoded.Num());
+		for (int32 Depth = FieldPath.Num() - 2; Depth >= Location.FoundDepth; --Depth)
+		{
+			TArray<uint8> Wrapped;
+			AppendVarint(Wrapped, WireFormatLite::MakeTag(FieldPath[Depth], WireFormatLite::WIRETYPE_LENGTH_DELIMITED));
+			AppendVarint(Wrapped, static_cast<uint64>(Inserted.Num()));
+			Wrapped.Append(Inserted);
+			Inserted = MoveTemp(Wrapped);
+		}
+		Delta = Splice(Data, Location.AppendOffset, 0, Inserted);
+	}
+
+	if (!UpdateEnclosingLengths(Data, Location.Enclosing, Delta))
+	{
+		UE_LOG(LogProto, Error, TEXT("Proto wire patch: nested message grew too large"));
+		return false;
+	}
+	return true;
+}
+
+bool FLinkProtoWirePatch::WriteVarint(TArray<uint8>& Data, TConstArrayView<int32> FieldPath, uint64 Value)
+{
+	FEncodedValue Encoded;
+	AppendVarint(Encoded, Value);
+	return WriteField(Data, FieldPath, WireFormatLite::WIRETYPE_VARINT, Encoded, &Value);
+}
+
+bool FLinkProtoWirePatch::WriteFixed32(TArray<uint8>& Data, TConstArrayView<int32> FieldPath, uint32 Value)
+{
+	uint8 Encoded[sizeof(uint32)];
+	CodedOutputStream::WriteLittleEndian32ToArray(Value, Encoded);
+	return WriteField(Data, FieldPath, WireFormatLite::WIRETYPE_FIXED32, MakeArrayView(Encoded, UE_ARRAY_COUNT(Encoded)), nullptr);
+}
+
+bool FLinkProtoWirePatch::WriteFixed64(TArray<uint8>& Data, TConstArrayView<int32> FieldPath, uint64 Value)
+{
+	uint8 Encoded[sizeof(uint64)];
+	CodedOutputStream::WriteLittleEndian64ToArray(Value, Encoded);
+	return WriteField(Data, FieldPath, WireFormatLite::WIRETYPE_FIXED64, MakeArrayView(Encoded, UE_ARRAY_COUNT(Encoded)), nullptr);
+}
+
+bool FLinkProtoWirePatch::WriteLengthDelimited(TArray<uint8>& Data, TConstArrayView<int32> FieldPath, TConstArrayView<uint8> Value)
+{
+	// Also copies Value out of Data in case it is a view into it
+	TArray<uint8> Encoded;
+	Encoded.Reserve(Value.Num() + 5);
+	AppendVarint(Encoded, static_cast<uint64>(Value.Num()));
+	Encoded.Append(Value.GetData(), Value.Num());
+	return WriteField(Data, FieldPath, WireFormatLite::WIRETYPE_LENGTH_DELIMITED, Encoded, nullptr);
+}
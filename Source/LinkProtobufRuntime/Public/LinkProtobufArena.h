@@ -0,0 +1,45 @@
+// Copyright DarkestLink-Dev 2025 All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// SPDX-License-Identifier: Apache-2.0
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "google/protobuf/message.h"
+
+/**
+ * Gives the conversion functions a per-thread google::protobuf::Arena for their temporary messages.
+ *
+ * Every thread owns one arena built from the ArenaOptions in ULinkProtobufRuntimeSettings, its blocks come from FMemory.
+ * Scopes nest, the arena is reset when the outermost scope of the thread ends, which frees every message,
+ * sub-message, map entry and string created in it at once while keeping the initial block for the next call.
+ * Messages created through a scope must not outlive it.
+ */
+class LINKPROTOBUFRUNTIME_API FLinkProtoArenaScope : public FNoncopyable
+{
+public:
+	FLinkProtoArenaScope();
+	~FLinkProtoArenaScope();
+
+	// Null when arenas are disabled in the runtime settings.
+	google::protobuf::Arena* GetArena() const { return Arena; }
+
+	// Creates an empty message of the prototype's type, on the arena or, when arenas are disabled, on the heap owned by this scope.
+	google::protobuf::Message* NewMessage(const google::protobuf::Message& Prototype);
+
+private:
+	google::protobuf::Arena* Arena;
+	TArray<google::protobuf::Message*> HeapMessages;
+};
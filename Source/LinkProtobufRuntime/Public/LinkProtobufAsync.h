@@ -0,0 +1,95 @@
+// Copyright DarkestLink-Dev 2025 All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// SPDX-License-Identifier: Apache-2.0
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Runtime/Launch/Resources/Version.h"
+#include "Async/Async.h"
+#include "LinkProtobufConversionPlan.h"
+#include "LinkProtobufFunctionLibrary.h"
+#if (ENGINE_MAJOR_VERSION > 5) || (ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 5)
+#include "StructUtils/InstancedStruct.h"
+#else
+// Lives in the StructUtils plugin before UE 5.5
+#include "InstancedStruct.h"
+#endif
+
+/**
+ * Struct <-> proto binary conversion on the thread pool, for payloads large enough to hitch the calling thread.
+ *
+ * The input is copied (or moved) into the task before the call returns, so the caller's data may change right away.
+ * The conversion plan is resolved on the calling thread and handed to the task. The returned futures are fulfilled on
+ * the worker thread, chain a continuation that hops back with AsyncTask(ENamedThreads::GameThread, ...) to touch game state.
+ * An unset optional means the conversion failed, the reason is logged.
+ */
+class LINKPROTOBUFRUNTIME_API FLinkProtoAsync
+{
+public:
+	// Encodes a copy of the struct.
+	static TFuture<TOptional<TArray<uint8>>> EncodeStruct(const UScriptStruct* StructDefinition, const void* Struct);
+
+	// Encodes the instanced struct, which is moved into the task.
+	static TFuture<TOptional<TArray<uint8>>> EncodeStruct(FInstancedStruct Struct);
+
+	template<typename StructType>
+	static TFuture<TOptional<TArray<uint8>>> EncodeStruct(StructType Struct)
+	{
+		FLinkProtoStructPlanPtr Plan = FindPlan(StructType::StaticStruct());
+		if (!Plan)
+		{
+			return MakeFulfilledPromise<TOptional<TArray<uint8>>>().GetFuture();
+		}
+		return Async(EAsyncExecution::ThreadPool, [Plan = MoveTemp(Plan), Struct = MoveTemp(Struct)]()
+		{
+			TArray<uint8> Bytes;
+			if (!Encode(*Plan, &Struct, Bytes))
+			{
+				return TOptional<TArray<uint8>>();
+			}
+			return TOptional<TArray<uint8>>(MoveTemp(Bytes));
+		});
+	}
+
+	// Decodes the bytes, which are moved into the task, into a new instance of the struct.
+	static TFuture<TOptional<FInstancedStruct>> DecodeStruct(UScriptStruct* StructDefinition, TArray<uint8> Bytes, bool bAllowIncomplete = true);
+
+	template<typename StructType>
+	static TFuture<TOptional<StructType>> DecodeStruct(TArray<uint8> Bytes, bool bAllowIncomplete = true)
+	{
+		FLinkProtoStructPlanPtr Plan = FindPlan(StructType::StaticStruct());
+		if (!Plan)
+		{
+			return MakeFulfilledPromise<TOptional<StructType>>().GetFuture();
+		}
+		return Async(EAsyncExecution::ThreadPool, [Plan = MoveTemp(Plan), Bytes = MoveTemp(Bytes), bAllowIncomplete]()
+		{
+			StructType Struct;
+			if (!Decode(*Plan, Bytes, bAllowIncomplete, &Struct))
+			{
+				return TOptional<StructType>();
+			}
+			return TOptional<StructType>(MoveTemp(Struct));
+		});
+	}
+
+private:
+	// Runs on the calling thread, the task keeps the returned plan so the worker never looks it up
+	static FLinkProtoStructPlanPtr FindPlan(const UScriptStruct* StructDefinition);
+
+	static bool Encode(const FLinkProtoStructPlan& Plan, const void* Struct, TArray<uint8>& OutBytes);
+	static bool Decode(const FLinkProtoStructPlan& Plan, TConstArrayView<uint8> Bytes, bool bAllowIncomplete, void* OutStruct);
+};
@@ -0,0 +1,80 @@
+// Copyright DarkestLink-Dev 2025 All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// SPDX-License-Identifier: Apache-2.0
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Runtime/Launch/Resources/Version.h"
+#include "Kismet/BlueprintAsyncActionBase.h"
+#if (ENGINE_MAJOR_VERSION > 5) || (ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 5)
+#include "StructUtils/InstancedStruct.h"
+#else
+// Lives in the StructUtils plugin before UE 5.5
+#include "InstancedStruct.h"
+#endif
+#include "LinkProtobufAsyncAction.generated.h"
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FLinkProtoEncodeAsyncCompleted, bool, bSuccess, const TArray<uint8>&, ProtoBinaryBytes);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FLinkProtoDecodeAsyncCompleted, bool, bSuccess, const FInstancedStruct&, ResultStruct);
+
+// Blueprint node encoding a struct on a worker thread, Completed fires on the game thread.
+UCLASS()
+class LINKPROTOBUFRUNTIME_API ULinkProtobufEncodeAsyncAction : public UBlueprintAsyncActionBase
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(BlueprintAssignable)
+	FLinkProtoEncodeAsyncCompleted Completed;
+
+	// Copies the struct and converts it to proto binary bytes without blocking the game thread
+	UFUNCTION(BlueprintCallable, Category = "Proto", meta = (BlueprintInternalUseOnly = "true", WorldContext = "WorldContextObject", DisplayName = "Convert Struct To Proto Binary Bytes Async"))
+	static ULinkProtobufEncodeAsyncAction* StructToBinaryProtoBytesAsync(UObject* WorldContextObject, const FInstancedStruct& Struct);
+
+	virtual void Activate() override;
+
+private:
+	void Finish(TOptional<TArray<uint8>> Result);
+
+	UPROPERTY()
+	FInstancedStruct Struct;
+};
+
+// Blueprint node decoding proto binary bytes on a worker thread, Completed fires on the game thread.
+UCLASS()
+class LINKPROTOBUFRUNTIME_API ULinkProtobufDecodeAsyncAction : public UBlueprintAsyncActionBase
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(BlueprintAssignable)
+	FLinkProtoDecodeAsyncCompleted Completed;
+
+	// Copies the bytes and converts them to a new instance of StructDefinition without blocking the game thread
+	UFUNCTION(BlueprintCallable, Category = "Proto", meta = (BlueprintInternalUseOnly = "true", WorldContext = "WorldContextObject", DisplayName = "Convert Proto Binary Bytes To Struct Async"))
+	static ULinkProtobufDecodeAsyncAction* ProtoBinaryBytesToStructAsync(UObject* WorldContextObject, UScriptStruct* StructDefinition, bool bAllowIncomplete, const TArray<uint8>& ProtoBinaryBytes);
+
+	virtual void Activate() override;
+
+private:
+	void Finish(TOptional<FInstancedStruct> Result);
+
+	UPROPERTY()
+	TObjectPtr<UScriptStruct> StructDefinition;
+
+	bool bAllowIncomplete = false;
+	TArray<uint8> Bytes;
+};
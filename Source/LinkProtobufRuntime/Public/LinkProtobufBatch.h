@@ -0,0 +1,74 @@
+// Copyright DarkestLink-Dev 2025 All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// SPDX-License-Identifier: Apache-2.0
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** Records encoded by FLinkProtoBatch::EncodeStructs, stored back to back in one buffer. */
+struct LINKPROTOBUFRUNTIME_API FLinkProtoEncodedBatch
+{
+	TArray<uint8> Bytes;
+	// One entry per record plus the end of the last record, record I spans [Offsets[I], Offsets[I + 1]).
+	TArray<int32> Offsets;
+
+	int32 Num() const { return FMath::Max(Offsets.Num() - 1, 0); }
+
+	TConstArrayView<uint8> GetRecord(int32 Index) const
+	{
+		return MakeArrayView(Bytes.GetData() + Offsets[Index], Offsets[Index + 1] - Offsets[Index]);
+	}
+};
+
+/**
+ * Converts many structs of one type at once, spread over the task graph with ParallelFor.
+ *
+ * Encoding runs a parallel size pass over fixed size chunks of structs, lays the records out in one buffer from the sizes
+ * and then writes every chunk in parallel at its offsets, each chunk consuming the length prefixes its size pass recorded.
+ * The plan is looked up once per call and the per chunk scratch arrays are kept by the calling thread for its next batch.
+ */
+class LINKPROTOBUFRUNTIME_API FLinkProtoBatch
+{
+public:
+	// Encodes Num structs stored as a C array of StructDefinition. OutBatch is overwritten, its allocations are reused.
+	static bool EncodeStructs(const UScriptStruct* StructDefinition, const void* Structs, int32 Num, FLinkProtoEncodedBatch& OutBatch);
+
+	template<typename StructType>
+	static bool EncodeStructs(TConstArrayView<StructType> Structs, FLinkProtoEncodedBatch& OutBatch)
+	{
+		return EncodeStructs(StructType::StaticStruct(), Structs.GetData(), Structs.Num(), OutBatch);
+	}
+
+	// Decodes Records[I] into the I-th struct of OutStructs, a C array of Records.Num() constructed structs.
+	// Returns false when any record failed to decode, the failed ones are logged and the others are still decoded.
+	static bool DecodeStructs(const UScriptStruct* StructDefinition, TConstArrayView<TConstArrayView<uint8>> Records, void* OutStructs, bool bAllowIncomplete = true);
+
+	static bool DecodeStructs(const UScriptStruct* StructDefinition, const FLinkProtoEncodedBatch& Batch, void* OutStructs, bool bAllowIncomplete = true);
+
+	template<typename StructType>
+	static bool DecodeStructs(TConstArrayView<TConstArrayView<uint8>> Records, TArrayView<StructType> OutStructs, bool bAllowIncomplete = true)
+	{
+		check(Records.Num() == OutStructs.Num());
+		return DecodeStructs(StructType::StaticStruct(), Records, OutStructs.GetData(), bAllowIncomplete);
+	}
+
+	template<typename StructType>
+	static bool DecodeStructs(const FLinkProtoEncodedBatch& Batch, TArrayView<StructType> OutStructs, bool bAllowIncomplete = true)
+	{
+		check(Batch.Num() == OutStructs.Num());
+		return DecodeStructs(StructType::StaticStruct(), Batch, OutStructs.GetData(), bAllowIncomplete);
+	}
+};
@@ -0,0 +1,728 @@
+// Copyright DarkestLink-Dev 2025 All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// SPDX-License-Identifier: Apache-2.0
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "LinkProtobufCompat.h"
+#include "LinkProtobufConversionPlan.h"
+#include "LinkProtobufFunctionLibrary.h"
+#include "LinkProtobufNameCache.h"
+#include "LinkProtobufUtf8.h"
+#include "LinkProtobufWireEncoder.h"
+#include "google/protobuf/io/coded_stream.h"
+#include "google/protobuf/io/zero_copy_stream_impl_lite.h"
+#include "google/protobuf/wire_format_lite.h"
+#include <string>
+#include <type_traits>
+
+/**
+ * Typed C++ entry point for converting one struct type:
+ *
+ *   TArray<uint8> Bytes;
+ *   TProtoCodec<FMyStruct>::Encode(MyStruct, Bytes);
+ *   TProtoCodec<FMyStruct>::Decode(Bytes, MyStruct);
+ *
+ * Unspecialized types go through the conversion plan of the struct, like the UScriptStruct based functions.
+ * Types bound with LINKPROTO_CODEC get a codec compiled for their fields, see below.
+ */
+template<typename TStruct>
+struct TProtoCodec
+{
+	// False for the plan based codec, true for codecs declared with LINKPROTO_CODEC.
+	static constexpr bool bStaticCodec = false;
+
+	static bool Encode(const TStruct& Value, TArray<uint8>& OutBytes)
+	{
+		return ULinkProtobufFunctionLibrary::ConvertStructToBinaryProtoBytes(TStruct::StaticStruct(), &Value, OutBytes);
+	}
+
+	static bool Decode(TConstArrayView<uint8> Data, TStruct& OutValue)
+	{
+		google::protobuf::io::ArrayInputStream Input(Data.GetData(), Data.Num());
+		return ULinkProtobufFunctionLibrary::ConvertProtoBinaryBytesToStruct(TStruct::StaticStruct(), true, Input, &OutValue);
+	}
+
+	// Encoded size of the value, 0 when the struct has no message type.
+	static uint64 ByteSize(const TStruct& Value)
+	{
+		const FLinkProtoStructPlanPtr Plan = FLinkProtoPlanCache::Get().FindOrBuild(TStruct::StaticStruct());
+		if (!Plan)
+		{
+			return 0;
+		}
+		return FLinkProtoWireEncoder::ComputeEncodedSize(*Plan, &Value);
+	}
+};
+
+// Proto type of a field bound with LINKPROTO_FIELD.
+enum class ELinkProtoFieldType : uint8
+{
+	Int32,
+	Int64,
+	UInt32,
+	UInt64,
+	SInt32,
+	SInt64,
+	Fixed32,
+	Fixed64,
+	SFixed32,
+	SFixed64,
+	Float,
+	Double,
+	Bool,
+	Enum,
+	// FString, FName, FText, FUtf8String or FAnsiString member, or a TArray<uint8> holding UTF-8
+	String,
+	// TArray<uint8> member
+	Bytes,
+	// Member of a struct type that has its own LINKPROTO_CODEC
+	Message
+};
+
+namespace LinkProtoCodec
+{
+	using WireFormatLite = google::protobuf::internal::WireFormatLite;
+	using CodedInputStream = google::protobuf::io::CodedInputStream;
+	using CodedOutputStream = google::protobuf::io::CodedOutputStream;
+
+	constexpr uint32 MakeTag(uint32 Number, WireFormatLite::WireType WireType)
+	{
+		return (Number << 3) | static_cast<uint32>(WireType);
+	}
+
+	constexpr uint32 VarintSize(uint32 Value)
+	{
+		return Value < (1u << 7) ? 1 : Value < (1u << 14) ? 2 : Value < (1u << 21) ? 3 : Value < (1u << 28) ? 4 : 5;
+	}
+
+	// Proto3 default check, floating point values are compared bitwise like the generated code does (-0.0 is written)
+	template<typename T>
+	FORCEINLINE bool IsZero(T Value)
+	{
+		if constexpr (std::is_floating_point_v<T>)
+		{
+			std::conditional_t<sizeof(T) == 4, uint32, uint64> Bits;
+			FMemory::Memcpy(&Bits, &Value, sizeof(T));
+			return Bits == 0;
+		}
+		else
+		{
+			return Value == T();
+		}
+	}
+
+	// Wire encoding of the numeric field types
+	template<ELinkProtoFieldType Type>
+	struct TNumber;
+
+#define LINKPROTO_CODEC_NUMBER(Type, InCppType, ProtoType, InWireType, SizeExpr, Name) \
+	template<> \
+	struct TNumber<ELinkProtoFieldType::Type> \
+	{ \
+		using CppType = InCppType; \
+		static constexpr WireFormatLite::WireType WireType = WireFormatLite::InWireType; \
+		static FORCEINLINE uint32 Size(CppType Value) { return static_cast<uint32>(SizeExpr); } \
+		static FORCEINLINE uint8* Write(CppType Value, uint8* Target) { return WireFormatLite::Write##Name##NoTagToArray(Value, Target); } \
+		static FORCEINLINE bool Read(CodedInputStream& Input, CppType& Value) { return WireFormatLite::ReadPrimitive<CppType, WireFormatLite::ProtoType>(&Input, &Value); } \
+	};
+
+	LINKPROTO_CODEC_NUMBER(Int32,    int32_t,  TYPE_INT32,    WIRETYPE_VARINT,  WireFormatLite::Int32Size(Value),  Int32)
+	LINKPROTO_CODEC_NUMBER(Int64,    int64_t,  TYPE_INT64,    WIRETYPE_VARINT,  WireFormatLite::Int64Size(Value),  Int64)
+	LINKPROTO_CODEC_NUMBER(UInt32,   uint32_t, TYPE_UINT32,   WIRETYPE_VARINT,  WireFormatLite::UInt32Size(Value), UInt32)
+	LINKPROTO_CODEC_NUMBER(UInt64,   uint64_t, TYPE_UINT64,   WIRETYPE_VARINT,  WireFormatLite::UInt64Size(Value), UInt64)
+	LINKPROTO_CODEC_NUMBER(SInt32,   int32_t,  TYPE_SINT32,   WIRETYPE_VARINT,  WireFormatLite::SInt32Size(Value), SInt32)
+	LINKPROTO_CODEC_NUMBER(SInt64,   int64_t,  TYPE_SINT64,   WIRETYPE_VARINT,  WireFormatLite::SInt64Size(Value), SInt64)
+	LINKPROTO_CODEC_NUMBER(Fixed32,  uint32_t, TYPE_FIXED32,  WIRETYPE_FIXED32, WireFormatLite::kFixed32Size,      Fixed32)
+	LINKPROTO_CODEC_NUMBER(Fixed64,  uint64_t, TYPE_FIXED64,  WIRETYPE_FIXED64, WireFormatLite::kFixed64Size,      Fixed64)
+	LINKPROTO_CODEC_NUMBER(SFixed32, int32_t,  TYPE_SFIXED32, WIRETYPE_FIXED32, WireFormatLite::kSFixed32Size,     SFixed32)
+	LINKPROTO_CODEC_NUMBER(SFixed64, int64_t,  TYPE_SFIXED64, WIRETYPE_FIXED64, WireFormatLite::kSFixed64Size,     SFixed64)
+	LINKPROTO_CODEC_NUMBER(Float,    float,    TYPE_FLOAT,    WIRETYPE_FIXED32, WireFormatLite::kFloatSize,        Float)
+	LINKPROTO_CODEC_NUMBER(Double,   double,   TYPE_DOUBLE,   WIRETYPE_FIXED64, WireFormatLite::kDoubleSize,       Double)
+	LINKPROTO_CODEC_NUMBER(Bool,     bool,     TYPE_BOOL,     WIRETYPE_VARINT,  WireFormatLite::kBoolSize,         Bool)
+	LINKPROTO_CODEC_NUMBER(Enum,     int,      TYPE_ENUM,     WIRETYPE_VARINT,  WireFormatLite::EnumSize(Value),   Enum)
+
+#undef LINKPROTO_CODEC_NUMBER
+
+	FORCEINLINE bool ReadLength(CodedInputStream& Input, int32& OutLength)
+	{
+		uint32 Length = 0;
+		if (!Input.ReadVarint32(&Length) || Length > static_cast<uint32>(MAX_int32))
+		{
+			return false;
+		}
+		OutLength = static_cast<int32>(Length);
+		return true;
+	}
+
+	// Reads a length delimited payload, in place when the input is flat and copied to Scratch otherwise
+	FORCEINLINE bool ReadPayload(CodedInputStream& Input, const ANSICHAR*& OutData, int32& OutLength, std::string& Scratch)
+	{
+		if (!ReadLength(Input, OutLength))
+		{
+			return false;
+		}
+		const void* Buffer = nullptr;
+		int BufferSize = 0;
+		if (OutLength == 0 || (Input.GetDirectBufferPointer(&Buffer, &BufferSize) && BufferSize >= OutLength))
+		{
+			OutData = OutLength > 0 ? static_cast<const ANSICHAR*>(Buffer) : "";
+			return Input.Skip(OutLength);
+		}
+		if (!Input.ReadString(&Scratch, OutLength))
+		{
+			return false;
+		}
+		OutData = Scratch.data();
+		return true;
+	}
+
+	FORCEINLINE const FString& AsString(const FString& Value, FString& Scratch) { return Value; }
+	FORCEINLINE const FString& AsString(const FText& Value, FString& Scratch) { return Value.ToString(); }
+	FORCEINLINE const FString& AsString(const FName& Value, FString& Scratch) { Value.ToString(Scratch); return Scratch; }
+
+	// Members that already hold UTF-8 and are copied without transcoding
+	template<typename TValue>
+	constexpr bool IsUtf8Member()
+	{
+#if LINKPROTO_WITH_UTF8_STRING_PROPERTIES
+		if constexpr (std::is_same_v<TValue, FUtf8String>)
+		{
+			return true;
+		}
+#endif
+		return std::is_same_v<TValue, TArray<uint8>>;
+	}
+
+	template<typename TValue>
+	constexpr bool IsLatin1Member()
+	{
+#if LINKPROTO_WITH_UTF8_STRING_PROPERTIES
+		return std::is_same_v<TValue, FAnsiString>;
+#else
+		return false;
+#endif
+	}
+
+	template<typename TValue>
+	FORCEINLINE const ANSICHAR* NarrowChars(const TValue& Value)
+	{
+		if constexpr (std::is_same_v<TValue, TArray<uint8>>)
+		{
+			return reinterpret_cast<const ANSICHAR*>(Value.GetData());
+		}
+		else
+		{
+			return reinterpret_cast<const ANSICHAR*>(*Value);
+		}
+	}
+
+	/**
+	 * Encoding of one value of a field (the whole value of a singular field, one element of a repeated one)
+	 * stored in a TValue member. Length delimited types report the size of their payload without the length prefix.
+	 */
+	template<ELinkProtoFieldType Type, typename TValue>
+	struct TValueCodec
+	{
+		using FNumber = TNumber<Type>;
+		static constexpr WireFormatLite::WireType WireType = FNumber::WireType;
+		static constexpr bool bLengthDelimited = false;
+
+		static FORCEINLINE bool IsDefault(const TValue& Value) { return IsZero(static_cast<typename FNumber::CppType>(Value)); }
+		static FORCEINLINE uint32 PayloadSize(const TValue& Value) { return FNumber::Size(static_cast<typename FNumber::CppType>(Value)); }
+		static FORCEINLINE uint8* WritePayload(const TValue& Value, uint32 Size, uint8* Target) { return FNumber::Write(static_cast<typename FNumber::CppType>(Value), Target); }
+
+		static FORCEINLINE bool Read(CodedInputStream& Input, TValue& OutValue)
+		{
+			typename FNumber::CppType Value;
+			if (!FNumber::Read(Input, Value))
+			{
+				return false;
+			}
+			OutValue = static_cast<TValue>(Value);
+			return true;
+		}
+	};
+
+	template<typename TValue>
+	struct TValueCodec<ELinkProtoFieldType::String, TValue>
+	{
+		static_assert(std::is_same_v<TValue, FString> || std::is_same_v<TValue, FName> || std::is_same_v<TValue, FText>
+			|| IsUtf8Member<TValue>() || IsLatin1Member<TValue>(),
+			"String fields must be bound to a FString, FName, FText, FUtf8String, FAnsiString or UTF-8 TArray<uint8> member");
+		static constexpr WireFormatLite::WireType WireType = WireFormatLite::WIRETYPE_LENGTH_DELIMITED;
+		static constexpr bool bLengthDelimited = true;
+
+		// Names are written as their string, None included, like the plan based encoder does
+		static FORCEINLINE bool IsDefault(const TValue& Value)
+		{
+			if constexpr (std::is_same_v<TValue, FName>)
+			{
+				return false;
+			}
+			else if constexpr (std::is_same_v<TValue, TArray<uint8>>)
+			{
+				return Value.Num() == 0;
+			}
+			else
+			{
+				return Value.IsEmpty();
+			}
+		}
+
+		static FORCEINLINE uint32 PayloadSize(const TValue& Value)
+		{
+			if constexpr (std::is_same_v<TValue, TArray<uint8>>)
+			{
+				return static_cast<uint32>(Value.Num());
+			}
+			else if constexpr (IsUtf8Member<TValue>())
+			{
+				return static_cast<uint32>(Value.Len());
+			}
+			else if constexpr (IsLatin1Member<TValue>())
+			{
+				return static_cast<uint32>(FLinkProtoUtf8::Latin1EncodedLength(NarrowChars(Value), Value.Len()));
+			}
+			else
+			{
+				if constexpr (std::is_same_v<TValue, FName>)
+				{
+					const ANSICHAR* Chars = nullptr;
+					int32 Num = 0;
+					if (FLinkProtoNameCache::Get().FindOrAddUtf8(Value, Chars, Num))
+					{
+						return static_cast<uint32>(Num);
+					}
+				}
+				FString Scratch;
+				const FString& Str = AsString(Value, Scratch);
+				return static_cast<uint32>(FLinkProtoUtf8::EncodedLength(*Str, Str.Len()));
+			}
+		}
+
+		static FORCEINLINE uint8* WritePayload(const TValue& Value, uint32 Size, uint8* Target)
+		{
+			if (Size == 0)
+			{
+				return Target;
+			}
+			if constexpr (IsUtf8Member<TValue>())
+			{
+				FMemory::Memcpy(Target, NarrowChars(Value), Size);
+				return Target + Size;
+			}
+			else if constexpr (IsLatin1Member<TValue>())
+			{
+				return FLinkProtoUtf8::EncodeLatin1(NarrowChars(Value), Value.Len(), Target);
+			}
+			else
+			{
+				// The cached bytes are the transcoded string, whichever path PayloadSize took
+				if constexpr (std::is_same_v<TValue, FName>)
+				{
+					const ANSICHAR* Chars = nullptr;
+					int32 Num = 0;
+					if (FLinkProtoNameCache::Get().FindOrAddUtf8(Value, Chars, Num))
+					{
+						FMemory::Memcpy(Target, Chars, Num);
+						return Target + Num;
+					}
+				}
+				FString Scratch;
+				const FString& Str = AsString(Value, Scratch);
+				return FLinkProtoUtf8::Encode(*Str, Str.Len(), Target);
+			}
+		}
+
+		static FORCEINLINE bool Read(CodedInputStream& Input, TValue& OutValue)
+		{
+			const ANSICHAR* Data = nullptr;
+			int32 Length = 0;
+			std::string Scratch;
+			if (!ReadPayload(Input, Data, Length, Scratch))
+			{
+				return false;
+			}
+			// Malformed UTF-8 is kept as U+FFFD rather than failing the message, the UTF-8 members keep it as is
+			if constexpr (IsUtf8Member<TValue>())
+			{
+				FLinkProtoUtf8::Decode(Data, Length, OutValue, false);
+			}
+			else if constexpr (std::is_same_v<TValue, FName>)
+			{
+				FLinkProtoNameCache::Get().Decode(Data, Length, OutValue);
+			}
+			else
+			{
+				FLinkProtoUtf8::Decode(Data, Length, OutValue);
+			}
+			return true;
+		}
+	};
+
+	template<typename TValue>
+	struct TValueCodec<ELinkProtoFieldType::Bytes, TValue>
+	{
+		static_assert(std::is_same_v<TValue, TArray<uint8>> || std::is_same_v<TValue, TArray64<uint8>>, "Bytes fields must be bound to a TArray<uint8> or TArray64<uint8> member");
+		static constexpr WireFormatLite::WireType WireType = WireFormatLite::WIRETYPE_LENGTH_DELIMITED;
+		static constexpr bool bLengthDelimited = true;
+
+		static FORCEINLINE bool IsDefault(const TValue& Value) { return Value.Num() == 0; }
+		static FORCEINLINE uint32 PayloadSize(const TValue& Value) { return static_cast<uint32>(Value.Num()); }
+
+		static FORCEINLINE uint8* WritePayload(const TValue& Value, uint32 Size, uint8* Target)
+		{
+			FMemory::Memcpy(Target, Value.GetData(), Size);
+			return Target + Size;
+		}
+
+		static FORCEINLINE bool Read(CodedInputStream& Input, TValue& OutValue)
+		{
+			int32 Length = 0;
+			if (!ReadLength(Input, Length))
+			{
+				return false;
+			}
+			// Checked against the input first so a corrupt prefix cannot allocate more than the message holds
+			const int BytesUntilLimit = Input.BytesUntilLimit();
+			if ((BytesUntilLimit >= 0 && Length > BytesUntilLimit) || Length > Input.BytesUntilTotalBytesLimit())
+			{
+				return false;
+			}
+			OutValue.SetNumUninitialized(Length, LINKPROTO_NO_SHRINK);
+			return Input.ReadRaw(OutValue.GetData(), Length);
+		}
+	};
+
+	template<typename TValue>
+	struct TValueCodec<ELinkProtoFieldType::Message, TValue>
+	{
+		static_assert(TProtoCodec<TValue>::bStaticCodec, "Message fields must be bound to a struct that has its own LINKPROTO_CODEC");
+		static constexpr WireFormatLite::WireType WireType = WireFormatLite::WIRETYPE_LENGTH_DELIMITED;
+		static constexpr bool bLengthDelimited = true;
+
+		// Nested structs are always present, an empty one is written as a zero length message
+		static FORCEINLINE bool IsDefault(const TValue& Value) { return false; }
+		static FORCEINLINE uint32 PayloadSize(const TValue& Value) { return static_cast<uint32>(TProtoCodec<TValue>::ByteSize(Value)); }
+		static FORCEINLINE uint8* WritePayload(const TValue& Value, uint32 Size, uint8* Target) { return TProtoCodec<TValue>::EncodeToArray(Value, Target); }
+
+		static FORCEINLINE bool Read(CodedInputStream& Input, TValue& OutValue)
+		{
+			int32 Length = 0;
+			if (!ReadLength(Input, Length))
+			{
+				return false;
+			}
+			const std::pair<CodedInputStream::Limit, int> LimitAndDepth = Input.IncrementRecursionDepthAndPushLimit(Length);
+			if (LimitAndDepth.second < 0 || !TProtoCodec<TValue>::DecodeFields(Input, OutValue))
+			{
+				return false;
+			}
+			return Input.DecrementRecursionDepthAndPopLimit(LimitAndDepth.first);
+		}
+	};
+
+	// Singular field
+	template<uint32 Number, ELinkProtoFieldType Type, typename TMember, bool bRepeated>
+	struct TFieldCodec
+	{
+		using FValue = TValueCodec<Type, TMember>;
+		static constexpr uint32 Tag = MakeTag(Number, FValue::WireType);
+		static constexpr uint32 TagSize = VarintSize(Tag);
+
+		static FORCEINLINE uint64 Size(const TMember& Value)
+		{
+			if (FValue::IsDefault(Value))
+			{
+				return 0;
+			}
+			const uint32 Payload = FValue::PayloadSize(Value);
+			return TagSize + (FValue::bLengthDelimited ? CodedOutputStream::VarintSize32(Payload) : 0) + Payload;
+		}
+
+		static FORCEINLINE uint8* Write(const TMember& Value, uint8* Target)
+		{
+			if (FValue::IsDefault(Value))
+			{
+				return Target;
+			}
+			const uint32 Payload = FValue::bLengthDelimited ? FValue::PayloadSize(Value) : 0;
+			Target = CodedOutputStream::WriteVarint32ToArray(Tag, Target);
+			if (FValue::bLengthDelimited)
+			{
+				Target = CodedOutputStream::WriteVarint32ToArray(Payload, Target);
+			}
+			return FValue::WritePayload(Value, Payload, Target);
+		}
+
+		// False when the tag is not the expected one, the caller skips the field then
+		static FORCEINLINE bool Read(CodedInputStream& Input, uint32 WireTag, TMember& OutValue, bool& bOutMatched)
+		{
+			bOutMatched = WireTag == Tag;
+			return !bOutMatched || FValue::Read(Input, OutValue);
+		}
+	};
+
+	// Repeated field bound to a TArray, numbers are packed
+	template<uint32 Number, ELinkProtoFieldType Type, typename TElement, typename TAllocator>
+	struct TFieldCodec<Number, Type, TArray<TElement, TAllocator>, true>
+	{
+		using FValue = TValueCodec<Type, TElement>;
+		using FArray = TArray<TElement, TAllocator>;
+		static constexpr bool bPacked = !FValue::bLengthDelimited;
+		static constexpr uint32 ElementTag = MakeTag(Number, FValue::WireType);
+		static constexpr uint32 PackedTag = MakeTag(Number, WireFormatLite::WIRETYPE_LENGTH_DELIMITED);
+		static constexpr uint32 TagSize = VarintSize(PackedTag);
+
+		static FORCEINLINE uint64 PackedPayloadSize(const FArray& Values)
+		{
+			if constexpr (FValue::WireType == WireFormatLite::WIRETYPE_FIXED32 || FValue::WireType == WireFormatLite::WIRETYPE_FIXED64)
+			{
+				return static_cast<uint64>(Values.Num()) * (FValue::WireType == WireFormatLite::WIRETYPE_FIXED32 ? 4 : 8);
+			}
+			else
+			{
+				uint64 Payload = 0;
+				for (const TElement& Value : Values)
+				{
+					Payload += FValue::PayloadSize(Value);
+				}
+				return Payload;
+			}
+		}
+
+		static FORCEINLINE uint64 Size(const FArray& Values)
+		{
+			if (Values.Num() == 0)
+			{
+				return 0;
+			}
+			if constexpr (bPacked)
+			{
+				const uint64 Payload = PackedPayloadSize(Values);
+				return TagSize + CodedOutputStream::VarintSize32(static_cast<uint32>(Payload)) + Payload;
+			}
+			else
+			{
+				uint64 Total = static_cast<uint64>(Values.Num()) * TagSize;
+				for (const TElement& Value : Values)
+				{
+					const uint32 Payload = FValue::PayloadSize(Value);
+					Total += CodedOutputStream::VarintSize32(Payload) + Payload;
+				}
+				return Total;
+			}
+		}
+
+		static FORCEINLINE uint8* Write(const FArray& Values, uint8* Target)
+		{
+			if (Values.Num() == 0)
+			{
+				return Target;
+			}
+			if constexpr (bPacked)
+			{
+				Target = CodedOutputStream::WriteVarint32ToArray(PackedTag, Target);
+				Target = CodedOutputStream::WriteVarint32ToArray(static_cast<uint32>(PackedPayloadSize(Values)), Target);
+				for (const TElement& Value : Values)
+				{
+					Target = FValue::WritePayload(Value, 0, Target);
+				}
+			}
+			else
+			{
+				for (const TElement& Value : Values)
+				{
+					const uint32 Payload = FValue::PayloadSize(Value);
+					Target = CodedOutputStream::WriteVarint32ToArray(ElementTag, Target);
+					Target = CodedOutputStream::WriteVarint32ToArray(Payload, Target);
+					Target = FValue::WritePayload(Value, Payload, Target);
+				}
+			}
+			return Target;
+		}
+
+		// Packed and unpacked encodings of numbers are both accepted, elements are appended
+		static FORCEINLINE bool Read(CodedInputStream& Input, uint32 WireTag, FArray& OutValues, bool& bOutMatched)
+		{
+			if (bPacked && WireTag == PackedTag)
+			{
+				bOutMatched = true;
+				int32 Length = 0;
+				if (!ReadLength(Input, Length))
+				{
+					return false;
+				}
+				const CodedInputStream::Limit Limit = Input.PushLimit(Length);
+				while (Input.BytesUntilLimit() > 0)
+				{
+					if (!FValue::Read(Input, OutValues.AddDefaulted_GetRef()))
+					{
+						return false;
+					}
+				}
+				Input.PopLimit(Limit);
+				return true;
+			}
+			bOutMatched = WireTag == ElementTag;
+			return !bOutMatched || FValue::Read(Input, OutValues.AddDefaulted_GetRef());
+		}
+	};
+
+	template<typename TMemberPointer>
+	struct TMemberPointerTraits;
+
+	template<typename TClass, typename TMember>
+	struct TMemberPointerTraits<TMember TClass::*>
+	{
+		using FClass = TClass;
+		using FMember = TMember;
+	};
+
+	template<typename... TFields>
+	constexpr bool AreFieldNumbersAscending()
+	{
+		constexpr uint32 Numbers[] = { 0, TFields::Number... };
+		for (int32 Index = 1; Index < static_cast<int32>(sizeof(Numbers) / sizeof(Numbers[0])); ++Index)
+		{
+			if (Numbers[Index] <= Numbers[Index - 1])
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+}
+
+/**
+ * One field of a LINKPROTO_CODEC, bound to a data member through a member pointer.
+ * Numeric members are cast to and from the proto type, enum members included. Bool bitfields cannot be bound.
+ * A TArray member is a repeated field, except a TArray<uint8> bound as Bytes or String (UTF-8 bytes) and a
+ * TArray64<uint8> bound as Bytes.
+ */
+template<uint32 InNumber, ELinkProtoFieldType Type, auto MemberPointer>
+struct TLinkProtoField
+{
+	using FStruct = typename LinkProtoCodec::TMemberPointerTraits<decltype(MemberPointer)>::FClass;
+	using FMember = typename LinkProtoCodec::TMemberPointerTraits<decltype(MemberPointer)>::FMember;
+	static constexpr bool bRepeated = TIsTArray<FMember>::Value
+		&& !((Type == ELinkProtoFieldType::Bytes || Type == ELinkProtoFieldType::String) && std::is_same_v<FMember, TArray<uint8>>)
+		&& !(Type == ELinkProtoFieldType::Bytes && std::is_same_v<FMember, TArray64<uint8>>);
+	using FCodec = LinkProtoCodec::TFieldCodec<InNumber, Type, FMember, bRepeated>;
+
+	static constexpr uint32 Number = InNumber;
+	static_assert(Number >= 1 && Number <= 536870911, "Proto field numbers go from 1 to 2^29 - 1");
+	static_assert(Number < 19000 || Number > 19999, "Proto field numbers 19000 to 19999 are reserved");
+
+	static FORCEINLINE uint64 Size(const FStruct& Value) { return FCodec::Size(Value.*MemberPointer); }
+	static FORCEINLINE uint8* Write(const FStruct& Value, uint8* Target) { return FCodec::Write(Value.*MemberPointer, Target); }
+	static FORCEINLINE bool Read(google::protobuf::io::CodedInputStream& Input, uint32 WireTag, FStruct& Value, bool& bOutMatched) { return FCodec::Read(Input, WireTag, Value.*MemberPointer, bOutMatched); }
+	static FORCEINLINE void Reset(FStruct& Value) { Value.*MemberPointer = FMember(); }
+};
+
+/**
+ * Codec compiled for a fixed list of TLinkProtoField, the base of every LINKPROTO_CODEC.
+ * It does not log: failures are only reported through the return values.
+ *
+ * Field numbers and wire types are constants and members are reached through member pointers, so encoding is a
+ * straight sequence of inlined writes and decoding compares each tag against the constant tags of the fields.
+ * Fields must be listed in field number order, encoding then matches Message::SerializeToString byte for byte.
+ * Nested messages are sized again by their parent's write pass.
+ */
+template<typename TStruct, typename... TFields>
+struct TLinkProtoStaticCodec
+{
+	static_assert((std::is_same_v<typename TFields::FStruct, TStruct> && ...), "Every field of a LINKPROTO_CODEC must be a member of its struct");
+	static_assert(LinkProtoCodec::AreFieldNumbersAscending<TFields...>(), "LINKPROTO_CODEC fields must be listed in increasing field number order");
+
+	static constexpr bool bStaticCodec = true;
+
+	static FORCEINLINE uint64 ByteSize(const TStruct& Value)
+	{
+		return (static_cast<uint64>(0) + ... + TFields::Size(Value));
+	}
+
+	// Target must hold ByteSize(Value) bytes. Returns the end of the written range.
+	static FORCEINLINE uint8* EncodeToArray(const TStruct& Value, uint8* Target)
+	{
+		((Target = TFields::Write(Value, Target)), ...);
+		return Target;
+	}
+
+	static bool Encode(const TStruct& Value, TArray<uint8>& OutBytes)
+	{
+		const uint64 Size = ByteSize(Value);
+		if (Size > static_cast<uint64>(MAX_int32))
+		{
+			return false;
+		}
+		OutBytes.SetNumUninitialized(static_cast<int32>(Size), LINKPROTO_NO_SHRINK);
+		uint8* End = EncodeToArray(Value, OutBytes.GetData());
+		check(End == OutBytes.GetData() + Size);
+		return true;
+	}
+
+	// Resets the bound members, then decodes Data into them. Unknown fields are skipped.
+	static bool Decode(TConstArrayView<uint8> Data, TStruct& OutValue)
+	{
+		(TFields::Reset(OutValue), ...);
+		google::protobuf::io::CodedInputStream Input(Data.GetData(), Data.Num());
+		return DecodeFields(Input, OutValue) && Input.ConsumedEntireMessage();
+	}
+
+	// Merges the fields read from Input, up to its current limit, into the struct.
+	static bool DecodeFields(google::protobuf::io::CodedInputStream& Input, TStruct& Value)
+	{
+		while (true)
+		{
+			const uint32 Tag = Input.ReadTag();
+			if (Tag == 0)
+			{
+				return true;
+			}
+			bool bMatched = false;
+			bool bOk = true;
+			// Stops at the first field whose tag matches
+			(void)((bOk = TFields::Read(Input, Tag, Value, bMatched), bMatched || !bOk) || ...);
+			if (!bOk)
+			{
+				return false;
+			}
+			if (!bMatched && !google::protobuf::internal::WireFormatLite::SkipField(&Input, Tag))
+			{
+				return false;
+			}
+		}
+	}
+};
+
+// Field of a LINKPROTO_CODEC: LINKPROTO_FIELD(1, Int32, &FMyStruct::Health)
+#define LINKPROTO_FIELD(Number, Type, MemberPointer) TLinkProtoField<Number, ELinkProtoFieldType::Type, MemberPointer>
+
+/**
+ * Specializes TProtoCodec for a struct with a compiled codec, at global scope after the struct is declared:
+ *
+ *   LINKPROTO_CODEC(FMyStruct,
+ *       LINKPROTO_FIELD(1, Int32, &FMyStruct::Health),
+ *       LINKPROTO_FIELD(2, String, &FMyStruct::Name),
+ *       LINKPROTO_FIELD(3, Message, &FMyStruct::Position));
+ *
+ * The fields must match the message type of the struct for both codecs to agree.
+ */
+#define LINKPROTO_CODEC(StructType, ...) \
+	template<> \
+	struct TProtoCodec<StructType> : TLinkProtoStaticCodec<StructType, __VA_ARGS__> {}
@@ -0,0 +1,245 @@
+// Copyright DarkestLink-Dev 2025 All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "LinkProtobufDescriptorRegistry.h"
+#include "google/protobuf/message.h"
+
+namespace google { namespace protobuf { namespace io { class CodedInputStream; } } }
+
+struct FLinkProtoFieldPlan;
+struct FLinkProtoStructPlan;
+enum class ELinkProtoUnknownFieldPolicy : uint8;
+
+// How a property is walked when converting, decided once when the plan is built.
+enum class ELinkProtoFieldKind : uint8
+{
+	Scalar,
+	Struct,
+	Array,
+	Set,
+	Map
+};
+
+// In-memory representation of a scalar property (or of an array/set element, map key or map value).
+// Enum properties are classified by their underlying integer property.
+enum class ELinkProtoValueType : uint8
+{
+	Unsupported,
+	Bool,
+	Int8,
+	Int16,
+	Int32,
+	Int64,
+	UInt8,
+	UInt16,
+	UInt32,
+	UInt64,
+	Float,
+	Double,
+	String,
+	Name,
+	Text,
+	// FUtf8String and FAnsiString, UE 5.5+
+	Utf8String,
+	AnsiString,
+	// TArray<uint8> bound to a singular string field, holds the UTF-8 bytes
+	Utf8Bytes,
+	// TArray<uint8> bound to a singular bytes field, copied as one block
+	ByteArray,
+	Struct
+};
+
+// Per field converters, resolved once per (property, field descriptor) pair.
+typedef bool (*FLinkProtoFieldToMessageFunc)(const FLinkProtoFieldPlan& FieldPlan, const void* StructPtr, google::protobuf::Message& TargetMsg);
+typedef bool (*FLinkProtoFieldFromMessageFunc)(const FLinkProtoFieldPlan& FieldPlan, const google::protobuf::Message& SourceMsg, void* StructPtr);
+// Wire decoder of one occurrence of the field, Tag is the tag that was just read. See FLinkProtoWireDecoder.
+typedef bool (*FLinkProtoFieldWireDecodeFunc)(const FLinkProtoFieldPlan& FieldPlan, google::protobuf::io::CodedInputStream& Input, uint32 Tag, void* StructPtr, ELinkProtoUnknownFieldPolicy NestedPolicy);
+
+// Whole struct converters written by the editor generator, the message is always of the protoc generated class.
+// See FLinkProtoGeneratedRegistry.
+typedef void (*FLinkProtoGeneratedToMessageFunc)(const void* StructPtr, google::protobuf::Message& TargetMsg);
+typedef void (*FLinkProtoGeneratedFromMessageFunc)(const google::protobuf::Message& SourceMsg, void* StructPtr);
+
+struct FLinkProtoGeneratedConverter
+{
+	FLinkProtoGeneratedToMessageFunc ToMessage = nullptr;
+	FLinkProtoGeneratedFromMessageFunc FromMessage = nullptr;
+};
+
+struct LINKPROTOBUFRUNTIME_API FLinkProtoFieldPlan
+{
+	// Property of the owning struct and the proto field it is bound to.
+	FProperty* Property = nullptr;
+	const google::protobuf::FieldDescriptor* Field = nullptr;
+
+	// Offset of the property value inside the owning struct.
+	int32 Offset = 0;
+
+	ELinkProtoFieldKind Kind = ELinkProtoFieldKind::Scalar;
+
+	// Array inner / set element / map key property, value property for maps.
+	FProperty* ElementProperty = nullptr;
+	FProperty* ValueProperty = nullptr;
+
+	// Value type of the scalar property, of the array/set element or of the map key.
+	ELinkProtoValueType ValueType = ELinkProtoValueType::Unsupported;
+	// Value type of the map value.
+	ELinkProtoValueType MapValueType = ELinkProtoValueType::Unsupported;
+
+	// Encoded tag of the field as written on the wire (length delimited for packed fields) and its size in bytes.
+	uint32 WireTag = 0;
+	int32 TagSize = 0;
+
+	// Repeated numeric field written as one packed length delimited run.
+	bool bPacked = false;
+	// Proto3 field without presence, its default value is not written.
+	bool bImplicitPresence = false;
+	// Singular proto2 scalar whose default is not zero ([default = X] or an enum whose first value is not 0),
+	// fields missing from the input are reset to it instead of being cleared.
+	bool bNonZeroDefault = false;
+	// Array of numbers stored exactly like the field's RepeatedField, the message converters copy it as one block.
+	bool bBulkRepeatedField = false;
+	// Element size of a float/double/fixed/sfixed array whose memory is the packed payload (little endian targets), 0 otherwise.
+	// Packed runs of such fields are read and written as one block.
+	int32 FixedWireSize = 0;
+
+	// Map entry "key"/"value" fields, resolved once instead of per entry.
+	const google::protobuf::FieldDescriptor* KeyField = nullptr;
+	const google::protobuf::FieldDescriptor* ValueField = nullptr;
+
+	// Plan of the nested struct (struct field, struct elements or struct map values).
+	const FLinkProtoStructPlan* SubPlan = nullptr;
+
+	FLinkProtoFieldToMessageFunc ToMessage = nullptr;
+	FLinkProtoFieldFromMessageFunc FromMessage = nullptr;
+	FLinkProtoFieldWireDecodeFunc WireDecode = nullptr;
+
+	// Pure property name, kept for logging only.
+	FString Name;
+
+	FORCEINLINE const void* GetValuePtr(const void* StructPtr) const
+	{
+		return static_cast<const uint8*>(StructPtr) + Offset;
+	}
+
+	FORCEINLINE void* GetValuePtr(void* StructPtr) const
+	{
+		return static_cast<uint8*>(StructPtr) + Offset;
+	}
+};
+
+/**
+ * Immutable conversion plan of one UScriptStruct: the resolved message descriptor and prototype
+ * plus one entry per bound property, sorted by proto field number.
+ * Plans are built once by FLinkProtoPlanCache and are safe to read from any thread.
+ */
+struct LINKPROTOBUFRUNTIME_API FLinkProtoStructPlan
+{
+	const UScriptStruct* Struct = nullptr;
+	TWeakObjectPtr<const UScriptStruct> WeakStruct;
+	const google::protobuf::Descriptor* Descriptor = nullptr;
+	const google::protobuf::Message* Prototype = nullptr;
+	TArray<FLinkProtoFieldPlan> Fields;
+	FString StructName;
+
+	// Typed converter of the struct, used instead of Fields for messages of the Prototype's generated class.
+	FLinkProtoGeneratedConverter Generated;
+
+	// Field number -> index into Fields for small field numbers, INDEX_NONE when the number is not bound.
+	// Larger numbers fall back to a binary search over Fields.
+	TArray<int16> FieldIndexByNumber;
+
+	bool IsValid() const { return Descriptor != nullptr; }
+
+	FORCEINLINE const FLinkProtoFieldPlan* FindFieldByNumber(int32 Number) const
+	{
+		if (Number >= 0 && Number < FieldIndexByNumber.Num())
+		{
+			const int16 Index = FieldIndexByNumber[Number];
+			return Index != INDEX_NONE ? &Fields[Index] : nullptr;
+		}
+		return FindSparseFieldByNumber(Number);
+	}
+
+	const FLinkProtoFieldPlan* FindSparseFieldByNumber(int32 Number) const;
+
+	// Runs the typed converter, or every field converter of the plan, struct memory -> message.
+	bool WriteToMessage(const void* StructPtr, google::protobuf::Message& TargetMsg) const;
+
+	// Runs the typed converter, or every field converter of the plan, message -> struct memory.
+	bool ReadFromMessage(const google::protobuf::Message& SourceMsg, void* StructPtr) const;
+};
+
+typedef TSharedPtr<const FLinkProtoStructPlan, ESPMode::ThreadSafe> FLinkProtoStructPlanPtr;
+
+// Classifies the memory layout of a property, see ELinkProtoValueType.
+LINKPROTOBUFRUNTIME_API ELinkProtoValueType LinkProtoClassifyProperty(const FProperty* Property);
+
+// Classifies a property bound to a singular field, as LinkProtoClassifyProperty but a TArray<uint8> bound to a string
+// field is Utf8Bytes and one bound to a bytes field is ByteArray. Decided by the descriptor, the ProtoUtf8 tag that
+// generates string fields is editor only metadata.
+LINKPROTOBUFRUNTIME_API ELinkProtoValueType LinkProtoClassifySingularProperty(const FProperty* Property, const google::protobuf::FieldDescriptor* Field);
+
+/**
+ * Process wide cache of conversion plans keyed by UScriptStruct.
+ * Lookups take a read lock only, plans are built under the write lock on first use.
+ * The whole cache is dropped on hot reload, Live Coding patches and when a cached struct is garbage collected,
+ * callers holding a plan keep it (and every nested plan) alive until they release it.
+ */
+class LINKPROTOBUFRUNTIME_API FLinkProtoPlanCache
+{
+public:
+	static FLinkProtoPlanCache& Get();
+
+	// Returns the cached plan for the struct, building it on first use. Null if no descriptor is bound to the struct.
+	FLinkProtoStructPlanPtr FindOrBuild(const UScriptStruct* Struct);
+
+	// Builds an uncached plan for a struct bound to an explicit descriptor (e.g. a message passed in by the caller).
+	FLinkProtoStructPlanPtr BuildTransient(const UScriptStruct* Struct, const google::protobuf::Descriptor* Descriptor);
+
+	void Invalidate();
+
+	// Drops the cache when one of the cached structs is no longer valid.
+	void InvalidateIfStale();
+
+private:
+	struct FPlanSet
+	{
+		TMap<const UScriptStruct*, TUniquePtr<FLinkProtoStructPlan>> Plans;
+		// Plans of structs bound to a second message type inside the same set, by struct and message type.
+		TMap<TPair<const UScriptStruct*, const google::protobuf::Descriptor*>, TUniquePtr<FLinkProtoStructPlan>> DetachedPlans;
+		// Runtime loaded schema the plans of this set were resolved against, kept alive as long as the set
+		FLinkProtoDescriptorSchemaPtr Schema;
+		bool bSchemaResolved = false;
+	};
+
+	static const FLinkProtoStructPlan* FindOrBuildLocked(FPlanSet& PlanSet, const UScriptStruct* Struct, const google::protobuf::Descriptor* Descriptor);
+
+	static void BuildFields(FPlanSet& PlanSet, FLinkProtoStructPlan& Plan);
+
+	static const google::protobuf::Descriptor* ResolveDescriptor(const FPlanSet& PlanSet, const UScriptStruct* Struct);
+
+	static const google::protobuf::Descriptor* FindCompiledDescriptor(const UScriptStruct* Struct);
+
+	static const google::protobuf::Message* ResolvePrototype(const FPlanSet& PlanSet, const google::protobuf::Descriptor* Descriptor);
+
+	static FLinkProtoGeneratedConverter ResolveGeneratedConverter(const FLinkProtoStructPlan& Plan);
+
+	TSharedPtr<FPlanSet, ESPMode::ThreadSafe> CurrentSet = MakeShared<FPlanSet, ESPMode::ThreadSafe>();
+	FRWLock Lock;
+};
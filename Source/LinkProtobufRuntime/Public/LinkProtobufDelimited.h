@@ -0,0 +1,139 @@
+// Copyright DarkestLink-Dev 2025 All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// SPDX-License-Identifier: Apache-2.0
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "LinkProtobufConversionPlan.h"
+#include "google/protobuf/io/coded_stream.h"
+#include "google/protobuf/io/zero_copy_stream.h"
+
+class FArchive;
+class FLinkProtoArchiveOutputStream;
+
+/**
+ * Writes a sequence of structs as length delimited messages: each one is preceded by its encoded size as a varint,
+ * the framing of google::protobuf::util::SerializeDelimitedToZeroCopyStream. Records of different struct types may be mixed.
+ * Everything written is in the destination once the writer is destroyed or Flush is called.
+ */
+class LINKPROTOBUFRUNTIME_API FLinkProtoDelimitedWriter : public FNoncopyable
+{
+public:
+	explicit FLinkProtoDelimitedWriter(google::protobuf::io::ZeroCopyOutputStream& Stream);
+	// Appends the records to the array.
+	explicit FLinkProtoDelimitedWriter(TArray<uint8>& OutBytes);
+	// Writes the records to a saving archive.
+	explicit FLinkProtoDelimitedWriter(FArchive& Archive);
+	~FLinkProtoDelimitedWriter();
+
+	bool Write(const UScriptStruct* StructDefinition, const void* Struct);
+
+	template<typename StructType>
+	bool Write(const StructType& Struct)
+	{
+		return Write(StructType::StaticStruct(), &Struct);
+	}
+
+	// Pushes the buffered bytes to the destination, returns false once a write to it has failed.
+	bool Flush();
+
+	// Bytes written so far, including length prefixes.
+	int64 GetByteCount() const { return Output.ByteCount(); }
+
+private:
+	TUniquePtr<google::protobuf::io::ZeroCopyOutputStream> OwnedStream;
+	FLinkProtoArchiveOutputStream* ArchiveStream = nullptr;
+	google::protobuf::io::CodedOutputStream Output;
+	// Scratch for records that do not fit the stream's current buffer
+	TArray<uint8> Scratch;
+	const UScriptStruct* LastStruct = nullptr;
+	FLinkProtoStructPlanPtr LastPlan;
+};
+
+/**
+ * Reads the records written by FLinkProtoDelimitedWriter, or by SerializeDelimitedToZeroCopyStream, one at a time
+ * without loading the whole stream. Every record must be of the struct type given to the reader.
+ *
+ * Records are decoded straight into the struct. Proto2 messages read with bAllowIncomplete false go through one message
+ * that is reused for every record, so their required fields can be checked.
+ */
+class LINKPROTOBUFRUNTIME_API FLinkProtoDelimitedReader : public FNoncopyable
+{
+public:
+	FLinkProtoDelimitedReader(const UScriptStruct* StructDefinition, google::protobuf::io::ZeroCopyInputStream& Stream, bool bAllowIncomplete = true);
+	// Reads the records in place, the bytes must outlive the reader.
+	FLinkProtoDelimitedReader(const UScriptStruct* StructDefinition, TConstArrayView<uint8> Bytes, bool bAllowIncomplete = true);
+	// Reads Length bytes of records from a loading archive, up to its end when Length is negative.
+	FLinkProtoDelimitedReader(const UScriptStruct* StructDefinition, FArchive& Archive, int64 Length = -1, bool bAllowIncomplete = true);
+	~FLinkProtoDelimitedReader();
+
+	// Reads the next record into OutStruct. Returns false at the end of the stream or on a malformed record, see HadError.
+	bool Read(void* OutStruct);
+
+	// True when reading stopped on a malformed or truncated record rather than at the end of the stream.
+	bool HadError() const { return bError; }
+
+private:
+	void Initialize(bool bAllowIncomplete);
+
+	TUniquePtr<google::protobuf::io::ZeroCopyInputStream> OwnedStream;
+	google::protobuf::io::ZeroCopyInputStream& Stream;
+	// Recreated now and then, CodedInputStream stops at 2GB of total input
+	TUniquePtr<google::protobuf::io::CodedInputStream> Input;
+	const UScriptStruct* StructDefinition;
+	FLinkProtoStructPlanPtr Plan;
+	TUniquePtr<google::protobuf::Message> ParsedMessage;
+	bool bError = false;
+};
+
+// Typed reader that also works in range for loops, the loop variable refers to one struct reused for every record.
+template<typename StructType>
+class TLinkProtoDelimitedReader : public FLinkProtoDelimitedReader
+{
+public:
+	template<typename SourceType, typename... ArgTypes>
+	explicit TLinkProtoDelimitedReader(SourceType&& Source, ArgTypes&&... Args)
+		: FLinkProtoDelimitedReader(StructType::StaticStruct(), Forward<SourceType>(Source), Forward<ArgTypes>(Args)...)
+	{
+	}
+
+	bool Read(StructType& OutStruct)
+	{
+		return FLinkProtoDelimitedReader::Read(&OutStruct);
+	}
+
+	struct FIterator
+	{
+		TLinkProtoDelimitedReader* Reader;
+
+		FIterator& operator++()
+		{
+			if (!Reader->Read(Reader->Current))
+			{
+				Reader = nullptr;
+			}
+			return *this;
+		}
+		const StructType& operator*() const { return Reader->Current; }
+		bool operator!=(const FIterator& Other) const { return Reader != Other.Reader; }
+	};
+
+	FIterator begin() { return ++FIterator{this}; }
+	FIterator end() { return FIterator{nullptr}; }
+
+private:
+	StructType Current;
+};
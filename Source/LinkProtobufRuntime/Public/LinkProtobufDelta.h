@@ -0,0 +1,70 @@
+// Copyright DarkestLink-Dev 2025 All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// SPDX-License-Identifier: Apache-2.0
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Encodes a struct as the difference from a baseline copy of it, and merges such deltas back.
+ *
+ * Changes are found by comparing property memory, field by field of the conversion plan, so only bound fields count.
+ * A delta is a sequence of tagged fields using the struct's field numbers:
+ *  - a changed scalar field is written with its usual encoding, default values included;
+ *  - a changed struct field is a length delimited delta of the nested struct;
+ *  - a changed array is length delimited: the new element count, then (index, element) pairs for the changed elements,
+ *    struct elements being deltas against the baseline element (a default element past the baseline's end);
+ *  - a changed set or map is length delimited: the element count, then every element, or key and value.
+ * Unchanged fields write nothing, so an identical struct gives an empty delta.
+ * Deltas have the outer framing of a message but only ApplyDelta can read them, against the same baseline.
+ *
+ * Deltas may come from the network, so counts are checked against the bytes left before anything is allocated:
+ * a set or map cannot hold more elements than its payload has bytes, and an array grows by at most the larger of
+ * its payload size and MaxArrayGrowth default elements. Deltas beyond that fail to apply.
+ */
+class LINKPROTOBUFRUNTIME_API FLinkProtoDelta
+{
+public:
+	// Default elements an applied delta may append to an array on top of the ones its payload holds
+	static constexpr int32 MaxArrayGrowth = 65536;
+
+	// Writes the fields of Current that differ from Baseline to OutDelta, both are structs of StructDefinition.
+	static bool EncodeDelta(const UScriptStruct* StructDefinition, const void* Current, const void* Baseline, TArray<uint8>& OutDelta);
+
+	// Same as above with the baseline given as its encoded message, e.g. the last acknowledged bytes.
+	static bool EncodeDelta(const UScriptStruct* StructDefinition, const void* Current, TConstArrayView<uint8> BaselineBytes, TArray<uint8>& OutDelta);
+
+	// Merges a delta into InOutStruct, which must hold the baseline the delta was encoded against.
+	static bool ApplyDelta(const UScriptStruct* StructDefinition, TConstArrayView<uint8> Delta, void* InOutStruct);
+
+	template<typename StructType>
+	static bool EncodeDelta(const StructType& Current, const StructType& Baseline, TArray<uint8>& OutDelta)
+	{
+		return EncodeDelta(StructType::StaticStruct(), &Current, &Baseline, OutDelta);
+	}
+
+	template<typename StructType>
+	static bool EncodeDelta(const StructType& Current, TConstArrayView<uint8> BaselineBytes, TArray<uint8>& OutDelta)
+	{
+		return EncodeDelta(StructType::StaticStruct(), &Current, BaselineBytes, OutDelta);
+	}
+
+	template<typename StructType>
+	static bool ApplyDelta(TConstArrayView<uint8> Delta, StructType& InOutStruct)
+	{
+		return ApplyDelta(StructType::StaticStruct(), Delta, &InOutStruct);
+	}
+};
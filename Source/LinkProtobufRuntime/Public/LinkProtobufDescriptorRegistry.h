@@ -0,0 +1,105 @@
+// Copyright DarkestLink-Dev 2025 All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// SPDX-License-Identifier: Apache-2.0
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include <string>
+
+namespace google { namespace protobuf {
+	class Descriptor;
+	class DescriptorPool;
+	class DescriptorPoolDatabase;
+	class DynamicMessageFactory;
+	class MergedDescriptorDatabase;
+	class Message;
+	class SimpleDescriptorDatabase;
+} }
+
+/**
+ * One generation of runtime loaded schemas: the loaded FileDescriptorProtos, a pool that builds descriptors from them
+ * the first time a type is looked up, and the DynamicMessageFactory making the prototypes of those types.
+ * Imports the loaded files do not provide are resolved from the descriptors compiled into the binary.
+ * Immutable once built and safe to use from any thread, plans built from it keep it alive.
+ */
+class LINKPROTOBUFRUNTIME_API FLinkProtoDescriptorSchema : public FNoncopyable
+{
+public:
+	~FLinkProtoDescriptorSchema();
+
+	// Message type defined by one of the loaded files, null for unknown names and types only found in compiled files.
+	const google::protobuf::Descriptor* FindMessageType(const std::string& FullName) const;
+
+	// Prototype of a message type of this schema's pool, null for descriptors of other pools.
+	const google::protobuf::Message* GetPrototype(const google::protobuf::Descriptor* Descriptor) const;
+
+	bool OwnsDescriptor(const google::protobuf::Descriptor* Descriptor) const;
+
+	int32 GetFileCount() const { return FileCount; }
+
+private:
+	friend class FLinkProtoDescriptorRegistry;
+	FLinkProtoDescriptorSchema();
+
+	class FErrorCollector;
+
+	// Declared in dependency order, members are destroyed from the factory down to the file database
+	TUniquePtr<google::protobuf::SimpleDescriptorDatabase> LoadedFiles;
+	TUniquePtr<google::protobuf::DescriptorPoolDatabase> CompiledFiles;
+	TUniquePtr<google::protobuf::MergedDescriptorDatabase> Database;
+	TUniquePtr<FErrorCollector> ErrorCollector;
+	TUniquePtr<google::protobuf::DescriptorPool> Pool;
+	TUniquePtr<google::protobuf::DynamicMessageFactory> Factory;
+	// Full names of the message types the loaded files define, nested ones included
+	TSet<FString> MessageTypes;
+	int32 FileCount = 0;
+};
+
+typedef TSharedPtr<const FLinkProtoDescriptorSchema, ESPMode::ThreadSafe> FLinkProtoDescriptorSchemaPtr;
+
+/**
+ * Schemas loaded at runtime from serialized FileDescriptorSets (protoc --include_imports --descriptor_set_out),
+ * so message types can be added or changed without compiling generated code into the project.
+ *
+ * Structs resolve to a message of the loaded schema before a compiled one of the same name, and are converted through
+ * DynamicMessage and the wire codec. Every load builds a new schema from all files loaded so far, a file replacing
+ * a loaded file of the same name, and drops the conversion plan cache so the next conversion picks the new types up.
+ * Plans in use keep the schema they were built from alive until they are released.
+ * The files listed in ULinkProtobufRuntimeSettings::RuntimeDescriptorSets are loaded when the module starts.
+ */
+class LINKPROTOBUFRUNTIME_API FLinkProtoDescriptorRegistry
+{
+public:
+	static FLinkProtoDescriptorRegistry& Get();
+
+	// Adds the files of a serialized FileDescriptorSet. On failure the current schema stays in use.
+	bool LoadDescriptorSet(TConstArrayView<uint8> SerializedSet, const FString& SourceName = TEXT("memory"));
+
+	// Loads a FileDescriptorSet file, from disk or from a pak file. Relative paths are relative to the project content directory.
+	bool LoadDescriptorSetFile(const FString& FilePath);
+
+	// Drops every runtime loaded file, structs resolve to compiled messages only again.
+	void Reset();
+
+	// Current schema, null when nothing is loaded.
+	FLinkProtoDescriptorSchemaPtr GetSchema() const;
+
+private:
+	// Serialized FileDescriptorProto of every loaded file by file name
+	TMap<FString, std::string> Files;
+	FLinkProtoDescriptorSchemaPtr Schema;
+	mutable FRWLock Lock;
+};
@@ -0,0 +1,83 @@
+// Copyright DarkestLink-Dev 2025 All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// SPDX-License-Identifier: Apache-2.0
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "LinkProtobufConversionPlan.h"
+
+namespace google { namespace protobuf { class FieldMask; } }
+
+/**
+ * Set of field paths of one struct, compiled once against its conversion plan and reused for every conversion.
+ *
+ * Paths follow google.protobuf.FieldMask: dot separated field names such as "Stats.Health" or "Inventory",
+ * each segment being the proto field name or the property name. Every segment but the last must name a singular
+ * struct field. A path selects the whole field it ends on, and a path covers every longer path below it.
+ * Masked conversions only touch the selected fields, the other struct members and message fields are left as they are.
+ */
+class LINKPROTOBUFRUNTIME_API FLinkProtoFieldMask
+{
+public:
+	// Compiles the paths against the struct's cached plan. Fails on unknown fields or paths through non struct fields.
+	bool Compile(const UScriptStruct* Struct, TConstArrayView<FString> Paths);
+
+	bool Compile(const UScriptStruct* Struct, const google::protobuf::FieldMask& Mask);
+
+	// Compiles against an explicit plan, e.g. one built for the descriptor of a caller's message.
+	bool Compile(FLinkProtoStructPlanPtr InPlan, TConstArrayView<FString> Paths);
+
+	bool Compile(FLinkProtoStructPlanPtr InPlan, const google::protobuf::FieldMask& Mask);
+
+	bool IsValid() const { return Plan.IsValid(); }
+
+	const FLinkProtoStructPlan* GetPlan() const { return Plan.Get(); }
+
+	// Sets the selected fields of TargetMsg from the struct, replacing their previous content.
+	bool WriteToMessage(const void* StructPtr, google::protobuf::Message& TargetMsg) const;
+
+	// Reads the selected fields of SourceMsg into the struct.
+	bool ReadFromMessage(const google::protobuf::Message& SourceMsg, void* StructPtr) const;
+
+	// Decodes only the selected fields of an encoded message into the struct, every other field is skipped on the wire.
+	bool Decode(TConstArrayView<uint8> Data, void* StructPtr) const;
+
+private:
+	struct FEntry
+	{
+		const FLinkProtoFieldPlan* FieldPlan = nullptr;
+		// Node selecting fields of the nested struct, INDEX_NONE when the whole field is selected.
+		int32 ChildNode = INDEX_NONE;
+	};
+
+	struct FNode
+	{
+		const FLinkProtoStructPlan* Plan = nullptr;
+		// Sorted by field number.
+		TArray<FEntry> Entries;
+	};
+
+	bool AddPath(const FString& Path);
+	bool WriteNode(int32 NodeIndex, const void* StructPtr, google::protobuf::Message& TargetMsg) const;
+	bool ReadNode(int32 NodeIndex, const google::protobuf::Message& SourceMsg, void* StructPtr) const;
+	void ResetNode(int32 NodeIndex, void* StructPtr) const;
+	bool DecodeNode(int32 NodeIndex, google::protobuf::io::CodedInputStream& Input, void* StructPtr) const;
+
+	// Keeps the plan and every nested plan the nodes point to alive.
+	FLinkProtoStructPlanPtr Plan;
+	// Node 0 selects fields of the root struct.
+	TArray<FNode> Nodes;
+};
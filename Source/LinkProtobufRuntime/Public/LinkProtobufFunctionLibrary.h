@@ -17,8 +17,11 @@
 
 #include "CoreMinimal.h"
 #include "google/protobuf/message.h"
+#include "google/protobuf/io/zero_copy_stream.h"
 #include "Kismet/BlueprintFunctionLibrary.h"
 #include "LinkProtobufRuntime.h"
+#include "LinkProtobufFieldMask.h"
+#include "LinkProtobufWireEncoder.h"
 #include "LinkProtobufFunctionLibrary.generated.h"
 
 
@@ -40,14 +43,32 @@ public:
 
 	static bool ConvertStructToBinaryProtoString(const UStruct* StructDefinition, const void* Struct, std::string& OutProtoBinaryString);
 
+	// Writes the encoded struct to a stream, see LinkProtobufStreams.h for archive and buffer streams
+	static bool ConvertStructToBinaryProtoBytes(const UStruct* StructDefinition, const void* Struct, google::protobuf::io::ZeroCopyOutputStream& Output);
+
+	// Exact encoded size of the struct, computed from its memory without building a message or encoding it.
+	// OutFieldSizes, when given, receives the size of every bound top level field.
+	static bool ComputeEncodedSize(const UScriptStruct* StructDefinition, const void* Struct, uint64& OutSize, TArray<FLinkProtoFieldSize>* OutFieldSizes = nullptr);
+
+	template<typename StructType>
+	static bool ComputeEncodedSize(const StructType& Struct, uint64& OutSize, TArray<FLinkProtoFieldSize>* OutFieldSizes = nullptr)
+	{
+		return ComputeEncodedSize(StructType::StaticStruct(), &Struct, OutSize, OutFieldSizes);
+	}
+
 private:
-	// Helper function to extract common struct to protobuf message conversion logic
+	// Helper function to extract common struct to protobuf conversion logic, Serialize receives the struct's conversion plan
 	template<typename SerializeFunc>
 	static bool ConvertStructToProtoInternal(const UStruct* StructDefinition, const void* Struct, SerializeFunc&& Serialize);
 
 public:
 	static bool DeserializeStructToMessage(UScriptStruct* StructDefinition, const void* Struct, google::protobuf::Message& TargetMsg,google::protobuf::FieldDescriptor* MsgFieldDescriptor);
 
+	// Sets only the fields selected by Mask, the other fields of TargetMsg are left as they are. See LinkProtobufFieldMask.h
+	static bool DeserializeStructToMessage(const void* Struct, google::protobuf::Message& TargetMsg, const FLinkProtoFieldMask& Mask);
+
+	static bool DeserializeStructToMessage(UScriptStruct* StructDefinition, const void* Struct, google::protobuf::Message& TargetMsg, const google::protobuf::FieldMask& Mask);
+
 	static bool SerializeMessageToBinaryString(google::protobuf::Message* message, std::string& OutProtoBinaryString, const FString& StructName = TEXT("Unknown"));
 
 	static bool SerializeMessageToBinaryBytes(google::protobuf::Message* message, TArray<uint8>& OutProtoBinaryBytes, const FString& StructName = TEXT("Unknown"));
@@ -58,18 +79,30 @@ public:
 
 	static bool ConvertProtoBinaryBytesToStruct(UScriptStruct* StructDefinition, bool bAllowIncomplete, const TArray<uint8>& ProtoBinaryBytes, void* ResultStruct);
 
+	// Parses a whole stream into the struct, see LinkProtobufStreams.h for archive and buffer streams
+	static bool ConvertProtoBinaryBytesToStruct(UScriptStruct* StructDefinition, bool bAllowIncomplete, google::protobuf::io::ZeroCopyInputStream& Input, void* ResultStruct);
+
 	static bool FillProtoMessageIntoUStruct(const google::protobuf::Message& Msg, UScriptStruct* StructDefinition, void* DestStruct);
 
+	// Reads only the fields selected by Mask, the other struct members are left untouched. See LinkProtobufFieldMask.h
+	static bool FillProtoMessageIntoUStruct(const google::protobuf::Message& Msg, void* DestStruct, const FLinkProtoFieldMask& Mask);
+
+	static bool FillProtoMessageIntoUStruct(const google::protobuf::Message& Msg, UScriptStruct* StructDefinition, void* DestStruct, const google::protobuf::FieldMask& Mask);
+
 	static bool SetFieldValue(google::protobuf::Message* targetMsg, const google::protobuf::FieldDescriptor* field, FProperty* property, const void* containerPtr);
 
 	static TArray<FString> ParseArrayString(const FString& ArrayString);
 
+	// A TArray<uint8> (TEnumAsByte arrays excluded) is one bytes field holding the whole array, not a repeated field.
 	static EProto3Type AssignProtoType(const FProperty* InProp);
 
 	static FString ProtoStringAssignProp(const FProperty* InProp);
 
 	static FString GetPureNameOfProperty(const FProperty* InProp);
 
+	// True for a TArray<uint8> of plain bytes, the property type mapped to a single bytes (or ProtoUtf8 string) field.
+	static bool IsByteArrayProperty(const FProperty* InProp);
+
 	static void ClearArenaCache(google::protobuf::Arena*ArenaPtr);
 
 };
@@ -0,0 +1,179 @@
+// Copyright DarkestLink-Dev 2025 All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// SPDX-License-Identifier: Apache-2.0
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "LinkProtobufCompat.h"
+#include "LinkProtobufConversionPlan.h"
+#include "LinkProtobufNameCache.h"
+#include "LinkProtobufUtf8.h"
+#include "UObject/TextProperty.h"
+#include <string>
+
+/**
+ * Registry of the typed converters written by the editor generator next to the protoc output.
+ *
+ * A typed converter copies a native USTRUCT into the protoc generated message class through its accessors,
+ * without walking properties or going through Reflection. The plan cache looks converters up when it builds
+ * a plan whose message type is compiled in (generated pool), FLinkProtoStructPlan::WriteToMessage and
+ * ReadFromMessage then call them for messages of that generated class.
+ *
+ * Generated files register from static initializers, before UObjects exist, so structs are resolved on first lookup.
+ */
+class LINKPROTOBUFRUNTIME_API FLinkProtoGeneratedRegistry
+{
+public:
+	typedef UScriptStruct* (*FGetStructFunc)();
+
+	static FLinkProtoGeneratedRegistry& Get();
+
+	void Register(FGetStructFunc GetStruct, const FLinkProtoGeneratedConverter& Converter);
+
+	// Drops the converter and every cached plan that may call it, for modules being unloaded.
+	void Unregister(FGetStructFunc GetStruct);
+
+	// Converter of the struct, with null functions when none is registered.
+	FLinkProtoGeneratedConverter Find(const UScriptStruct* Struct);
+
+private:
+	struct FEntry
+	{
+		FGetStructFunc GetStruct = nullptr;
+		FLinkProtoGeneratedConverter Converter;
+	};
+
+	void ResolvePendingLocked();
+
+	TArray<FEntry> Pending;
+	TMap<const UScriptStruct*, FEntry> Resolved;
+	FRWLock Lock;
+};
+
+/**
+ * Registers a typed converter for the lifetime of the module holding it, one static instance per struct.
+ */
+struct FLinkProtoGeneratedRegistrar : public FNoncopyable
+{
+	FLinkProtoGeneratedRegistrar(FLinkProtoGeneratedRegistry::FGetStructFunc InGetStruct, FLinkProtoGeneratedToMessageFunc ToMessage, FLinkProtoGeneratedFromMessageFunc FromMessage)
+		: GetStruct(InGetStruct)
+	{
+		FLinkProtoGeneratedRegistry::Get().Register(GetStruct, FLinkProtoGeneratedConverter{ ToMessage, FromMessage });
+	}
+
+	~FLinkProtoGeneratedRegistrar()
+	{
+		FLinkProtoGeneratedRegistry::Get().Unregister(GetStruct);
+	}
+
+private:
+	FLinkProtoGeneratedRegistry::FGetStructFunc GetStruct;
+};
+
+// String and bytes helpers used by the generated converters, same conversions as the reflection path.
+namespace LinkProtoGenerated
+{
+	FORCEINLINE std::string ToUtf8(const FString& Value)
+	{
+		return FLinkProtoUtf8::Encode(Value);
+	}
+
+	FORCEINLINE std::string ToUtf8(const FName& Value)
+	{
+		const ANSICHAR* Chars = nullptr;
+		int32 Num = 0;
+		if (FLinkProtoNameCache::Get().FindOrAddUtf8(Value, Chars, Num))
+		{
+			return std::string(Chars, Num);
+		}
+		return ToUtf8(Value.ToString());
+	}
+
+	FORCEINLINE std::string ToUtf8(const FText& Value)
+	{
+		return ToUtf8(Value.ToString());
+	}
+
+	// UTF-8 byte arrays (ProtoUtf8) are copied as is
+	FORCEINLINE std::string ToUtf8(const TArray<uint8>& Value)
+	{
+		return std::string(reinterpret_cast<const char*>(Value.GetData()), Value.Num());
+	}
+
+#if LINKPROTO_WITH_UTF8_STRING_PROPERTIES
+	FORCEINLINE std::string ToUtf8(const FUtf8String& Value)
+	{
+		return std::string(reinterpret_cast<const char*>(*Value), Value.Len());
+	}
+
+	FORCEINLINE std::string ToUtf8(const FAnsiString& Value)
+	{
+		std::string Utf8;
+		FLinkProtoUtf8::EncodeLatin1(*Value, Value.Len(), Utf8);
+		return Utf8;
+	}
+#endif
+
+	FORCEINLINE void FromUtf8(const std::string& Utf8, FString& Out)
+	{
+		FLinkProtoUtf8::Decode(Utf8, Out);
+	}
+
+	FORCEINLINE void FromUtf8(const std::string& Utf8, FName& Out)
+	{
+		FLinkProtoNameCache::Get().Decode(Utf8.data(), static_cast<int32>(Utf8.size()), Out);
+	}
+
+	FORCEINLINE void FromUtf8(const std::string& Utf8, FText& Out)
+	{
+		FLinkProtoUtf8::Decode(Utf8, Out);
+	}
+
+	// The protoc parser already validated the UTF-8 of the 8-bit values
+	FORCEINLINE void FromUtf8(const std::string& Utf8, TArray<uint8>& Out)
+	{
+		FLinkProtoUtf8::Decode(Utf8.data(), static_cast<int32>(Utf8.size()), Out, false);
+	}
+
+#if LINKPROTO_WITH_UTF8_STRING_PROPERTIES
+	FORCEINLINE void FromUtf8(const std::string& Utf8, FUtf8String& Out)
+	{
+		FLinkProtoUtf8::Decode(Utf8.data(), static_cast<int32>(Utf8.size()), Out, false);
+	}
+
+	FORCEINLINE void FromUtf8(const std::string& Utf8, FAnsiString& Out)
+	{
+		FLinkProtoUtf8::Decode(Utf8.data(), static_cast<int32>(Utf8.size()), Out);
+	}
+#endif
+
+	// Byte arrays bound to bytes fields, one copy each way. Also takes TArray64<uint8>.
+	template<typename AllocatorType>
+	FORCEINLINE void ToBytes(const TArray<uint8, AllocatorType>& Value, std::string& Out)
+	{
+		Out.assign(reinterpret_cast<const char*>(Value.GetData()), static_cast<size_t>(Value.Num()));
+	}
+
+	template<typename AllocatorType>
+	FORCEINLINE void FromBytes(const std::string& Bytes, TArray<uint8, AllocatorType>& Out)
+	{
+		Out.SetNumUninitialized(static_cast<typename TArray<uint8, AllocatorType>::SizeType>(Bytes.size()), LINKPROTO_NO_SHRINK);
+		if (!Bytes.empty())
+		{
+			FMemory::Memcpy(Out.GetData(), Bytes.data(), Bytes.size());
+		}
+	}
+}
@@ -0,0 +1,130 @@
+// Copyright DarkestLink-Dev 2025 All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// SPDX-License-Identifier: Apache-2.0
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/Function.h"
+
+namespace google { namespace protobuf { class Descriptor; class FieldDescriptor; } }
+
+class FLinkProtoLazyView;
+
+/**
+ * One value of a field read by FLinkProtoLazyView: the raw varint or fixed bits, or the payload of a length delimited value.
+ * Accessors convert between compatible types the way the struct converters do, floating point values are truncated to integers.
+ */
+struct LINKPROTOBUFRUNTIME_API FLinkProtoLazyValue
+{
+	const google::protobuf::FieldDescriptor* Field = nullptr;
+	// Varint or little endian fixed value, zigzag still applied for sint fields.
+	uint64 Bits = 0;
+	// Payload of string, bytes and message values, a view into the viewed bytes.
+	TConstArrayView<uint8> Bytes;
+
+	int64 AsInt64() const;
+	uint64 AsUInt64() const;
+	double AsDouble() const;
+	bool AsBool() const { return AsUInt64() != 0; }
+
+	// UTF-8 bytes of a string field converted to a FString.
+	FString AsString() const;
+	TConstArrayView<uint8> AsBytes() const { return Bytes; }
+
+	// View of a nested message, invalid for other field types.
+	FLinkProtoLazyView AsMessage() const;
+};
+
+/**
+ * Read only view over an encoded message that decodes fields on access instead of parsing the whole message.
+ *
+ * The first access scans the top level tags once and records where each field number occurs, values are then decoded
+ * from the recorded offsets. Only the fields that are asked for are decoded, nested messages are returned as views over
+ * their bytes and are scanned on their own first access. Scalar reads do not allocate as long as the message holds
+ * at most InlineFieldCount distinct top level field numbers.
+ *
+ * Singular fields follow proto semantics: the last occurrence wins and an absent field reads as its default value.
+ * A nested message that occurs more than once is not merged, its last occurrence is returned.
+ * The viewed bytes must outlive the view and every value and sub view read from it. Views are not thread safe.
+ */
+class LINKPROTOBUFRUNTIME_API FLinkProtoLazyView
+{
+public:
+	static constexpr int32 InlineFieldCount = 16;
+
+	FLinkProtoLazyView() = default;
+	FLinkProtoLazyView(TConstArrayView<uint8> InData, const google::protobuf::Descriptor* InDescriptor);
+	// Views the bytes as the message bound to the struct, invalid when no message is bound.
+	FLinkProtoLazyView(TConstArrayView<uint8> InData, const UScriptStruct* StructDefinition);
+
+	template<typename StructType>
+	static FLinkProtoLazyView Of(TConstArrayView<uint8> InData)
+	{
+		return FLinkProtoLazyView(InData, StructType::StaticStruct());
+	}
+
+	bool IsValid() const { return Descriptor != nullptr; }
+	const google::protobuf::Descriptor* GetDescriptor() const { return Descriptor; }
+	TConstArrayView<uint8> GetData() const { return Data; }
+
+	// Number of the field with this proto field name, 0 when the message has no such field.
+	int32 FindFieldNumber(const FString& FieldName) const;
+
+	// True when the field occurs in the bytes at least once.
+	bool Has(int32 FieldNumber) const;
+
+	// Last occurrence of a singular field, or the field's default value when it is absent.
+	// False for unknown field numbers, repeated fields and malformed bytes.
+	bool GetValue(int32 FieldNumber, FLinkProtoLazyValue& OutValue) const;
+
+	bool GetInt64(int32 FieldNumber, int64& OutValue) const;
+	bool GetUInt64(int32 FieldNumber, uint64& OutValue) const;
+	bool GetDouble(int32 FieldNumber, double& OutValue) const;
+	bool GetBool(int32 FieldNumber, bool& OutValue) const;
+	bool GetString(int32 FieldNumber, FString& OutValue) const;
+	bool GetBytes(int32 FieldNumber, TConstArrayView<uint8>& OutValue) const;
+	bool GetMessage(int32 FieldNumber, FLinkProtoLazyView& OutView) const;
+
+	// Calls Visitor for every element of a repeated field (map fields are repeated entry messages) in wire order,
+	// packed runs included. Stops when Visitor returns false. Returns false on unknown fields and malformed bytes.
+	bool ForEach(int32 FieldNumber, TFunctionRef<bool(const FLinkProtoLazyValue&)> Visitor) const;
+
+	// Number of elements of a repeated field, 0 when it is absent.
+	int32 Num(int32 FieldNumber) const;
+
+private:
+	struct FFieldOccurrence
+	{
+		int32 Number = 0;
+		int32 Count = 0;
+		// Offset of the first tag of the field, where ForEach starts.
+		int32 FirstTagOffset = 0;
+		// Offset of the value following the last tag, and that tag's wire type.
+		int32 LastValueOffset = 0;
+		uint8 LastWireType = 0;
+	};
+
+	const FFieldOccurrence* FindOccurrence(int32 FieldNumber) const;
+	bool BuildIndex() const;
+
+	TConstArrayView<uint8> Data;
+	const google::protobuf::Descriptor* Descriptor = nullptr;
+
+	// Built on first access, sorted by field number.
+	mutable TArray<FFieldOccurrence, TInlineAllocator<InlineFieldCount>> Index;
+	mutable bool bIndexed = false;
+	mutable bool bMalformed = false;
+};
@@ -0,0 +1,84 @@
+// Copyright DarkestLink-Dev 2025 All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include <atomic>
+
+/**
+ * Process wide cache of the FNames read and written by the converters: UTF-8 bytes -> FName on decode,
+ * FName -> UTF-8 bytes on encode. A hit skips the transcoding and, on decode, the name table lookup and its lock.
+ *
+ * Each direction is split in shards of open addressing tables whose slots are published atomically, lookups take
+ * no lock and inserts only lock their shard. Entries are never removed: a shard that holds its share of
+ * NameCacheCapacity stops growing and the names that do not fit take the uncached path. Sized on first use.
+ */
+class LINKPROTOBUFRUNTIME_API FLinkProtoNameCache : public FNoncopyable
+{
+public:
+	static FLinkProtoNameCache& Get();
+
+	explicit FLinkProtoNameCache(int32 Capacity);
+	~FLinkProtoNameCache();
+
+	// Stores the name of the UTF-8 bytes into Out, as FLinkProtoUtf8::Decode does. Only valid UTF-8 is cached.
+	bool Decode(const ANSICHAR* Utf8, int32 Len, FName& Out);
+
+	// Returns the UTF-8 bytes of the name, owned by the cache and alive as long as it. False when the name is not cached
+	// and cannot be added, the caller then transcodes Name.ToString() itself.
+	bool FindOrAddUtf8(FName Name, const ANSICHAR*& OutChars, int32& OutNum);
+
+private:
+	struct FEntry
+	{
+		uint64 Hash;
+		FName Name;
+		int32 Num;
+		// Num UTF-8 bytes follow the entry
+		FORCEINLINE const ANSICHAR* GetChars() const { return reinterpret_cast<const ANSICHAR*>(this + 1); }
+	};
+
+	static constexpr int32 NumShardBits = 4;
+	static constexpr int32 NumShards = 1 << NumShardBits;
+
+	struct FShard
+	{
+		TUniquePtr<std::atomic<FEntry*>[]> Slots;
+		uint32 Mask = 0;
+		int32 Num = 0;
+		int32 MaxNum = 0;
+		std::atomic<bool> bFull{false};
+		FCriticalSection WriteLock;
+	};
+
+	struct FTable
+	{
+		FShard Shards[NumShards];
+	};
+
+	void InitTable(FTable& Table, int32 Capacity);
+	void FreeTable(FTable& Table);
+
+	template<typename MatchFuncType>
+	static FEntry* Find(const FTable& Table, uint64 Hash, MatchFuncType&& Match);
+
+	template<typename MatchFuncType>
+	static FEntry* Add(FTable& Table, uint64 Hash, FName Name, const ANSICHAR* Chars, int32 Num, MatchFuncType&& Match);
+
+	FTable DecodeTable;
+	FTable EncodeTable;
+	bool bEnabled = false;
+};
@@ -56,4 +56,8 @@ public:
 	/** IModuleInterface implementation */
 	virtual void StartupModule() override;
 	virtual void ShutdownModule() override;
+
+private:
+	FDelegateHandle ReloadCompleteHandle;
+	FDelegateHandle PostGarbageCollectHandle;
 };
@@ -0,0 +1,69 @@
+// Copyright DarkestLink-Dev 2025 All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// SPDX-License-Identifier: Apache-2.0
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "LinkProtobufRuntimeSettings.generated.h"
+
+// Runtime options of the LinkProtobuf conversion functions, stored in DefaultGame.ini.
+UCLASS(config = Game, defaultconfig)
+class LINKPROTOBUFRUNTIME_API ULinkProtobufRuntimeSettings : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	static const ULinkProtobufRuntimeSettings* Get() { return GetDefault<ULinkProtobufRuntimeSettings>(); }
+
+	// Allocate the temporary messages of the conversion functions on a per-thread arena that is reset after each call.
+	UPROPERTY(Config, EditAnywhere, Category = "Link Protobuf Arena")
+	bool bUseMessageArena = true;
+
+	// Size of the block every thread arena owns for its whole lifetime, in bytes. Conversions that fit in it never touch the allocator.
+	UPROPERTY(Config, EditAnywhere, Category = "Link Protobuf Arena", meta = (ClampMin = "0", EditCondition = "bUseMessageArena"))
+	int32 ArenaInitialBlockSize = 16 * 1024;
+
+	// Upper bound of the extra blocks the arena allocates once the initial block is full, in bytes.
+	UPROPERTY(Config, EditAnywhere, Category = "Link Protobuf Arena", meta = (ClampMin = "256", EditCondition = "bUseMessageArena"))
+	int32 ArenaMaxBlockSize = 64 * 1024;
+
+	// Convert primitive fields by exporting the property as text and parsing it back, as older versions of the plugin did.
+	// Only meant for projects that depend on its exact results, it loses float precision and splits strings on commas.
+	UPROPERTY(Config, EditAnywhere, Category = "Link Protobuf Compatibility")
+	bool bUseLegacyTextConversion = false;
+
+	// Convert message types compiled into the project through the typed converters generated by the editor, when one is registered.
+	// Turning it off makes every conversion walk the struct properties, e.g. to compare both paths.
+	UPROPERTY(Config, EditAnywhere, Category = "Link Protobuf Compatibility")
+	bool bUseGeneratedConverters = true;
+
+	// Check the UTF-8 decoded into FUtf8String properties and UTF-8 byte arrays, which is otherwise copied without looking at it.
+	// Malformed UTF-8 in a proto3 string field then fails the wire decoder, as it does for FString properties.
+	UPROPERTY(Config, EditAnywhere, Category = "Link Protobuf Compatibility")
+	bool bValidateUtf8Properties = true;
+
+	// Number of FNames remembered in each direction (UTF-8 -> FName on decode, FName -> UTF-8 on encode), so repeated names
+	// skip the transcoding and the name table lock. Names past the capacity are converted uncached. 0 turns the cache off.
+	// Read once, when the first name is converted.
+	UPROPERTY(Config, EditAnywhere, Category = "Link Protobuf Names", meta = (ClampMin = "0"))
+	int32 NameCacheCapacity = 4096;
+
+	// Serialized FileDescriptorSets loaded into the runtime schema registry when the module starts, relative to the project content directory.
+	// Their message types take precedence over compiled messages of the same name. Add the directory to the packaging settings so they ship.
+	UPROPERTY(Config, EditAnywhere, Category = "Link Protobuf Schemas")
+	TArray<FString> RuntimeDescriptorSets;
+};
@@ -0,0 +1,154 @@
+// Copyright DarkestLink-Dev 2025 All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// SPDX-License-Identifier: Apache-2.0
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Memory/CompositeBuffer.h"
+#include "Memory/SharedBuffer.h"
+#include "google/protobuf/io/zero_copy_stream.h"
+
+class FArchive;
+
+/**
+ * google::protobuf::io::ZeroCopyInputStream/ZeroCopyOutputStream implementations over engine buffer types,
+ * so messages can be parsed from and written to them without first gathering the bytes in a TArray.
+ * Like every zero copy stream, an output stream only holds all written bytes once the CodedOutputStream writing to it is destroyed.
+ */
+
+// Reads a sequence of memory blocks as one stream, the parser reads them in place. The blocks must outlive the stream.
+class LINKPROTOBUFRUNTIME_API FLinkProtoBlockInputStream : public google::protobuf::io::ZeroCopyInputStream
+{
+public:
+	FLinkProtoBlockInputStream() = default;
+	explicit FLinkProtoBlockInputStream(TConstArrayView<uint8> Block);
+	explicit FLinkProtoBlockInputStream(TConstArrayView<TConstArrayView<uint8>> InBlocks);
+
+	// Appends a block behind the ones not read yet.
+	void AddBlock(TConstArrayView<uint8> Block);
+
+	virtual bool Next(const void** Data, int* Size) override;
+	virtual void BackUp(int Count) override;
+	virtual bool Skip(int Count) override;
+	virtual int64_t ByteCount() const override;
+
+private:
+	TArray<TConstArrayView<uint8>, TInlineAllocator<1>> Blocks;
+	// Block returned by the last Next and how much of it has been handed out
+	int32 BlockIndex = 0;
+	int32 BlockOffset = 0;
+	int64 Position = 0;
+};
+
+// Reads the segments of a FCompositeBuffer in place, the stream keeps a reference to the buffer.
+class LINKPROTOBUFRUNTIME_API FLinkProtoCompositeBufferInputStream : public FLinkProtoBlockInputStream
+{
+public:
+	explicit FLinkProtoCompositeBufferInputStream(FCompositeBuffer InBuffer);
+	explicit FLinkProtoCompositeBufferInputStream(FSharedBuffer InBuffer);
+
+private:
+	FCompositeBuffer Buffer;
+};
+
+/**
+ * Reads Length bytes from a loading archive, or up to its end when Length is negative, through a buffer of BlockSize bytes.
+ * The archive is read ahead by up to one block, bytes backed up by the parser are not returned to the archive.
+ */
+class LINKPROTOBUFRUNTIME_API FLinkProtoArchiveInputStream : public google::protobuf::io::ZeroCopyInputStream
+{
+public:
+	explicit FLinkProtoArchiveInputStream(FArchive& InArchive, int64 Length = -1, int32 InBlockSize = 64 * 1024);
+
+	virtual bool Next(const void** Data, int* Size) override;
+	virtual void BackUp(int Count) override;
+	virtual bool Skip(int Count) override;
+	virtual int64_t ByteCount() const override;
+
+private:
+	FArchive& Archive;
+	TArray<uint8> Buffer;
+	int32 BlockSize;
+	int64 Remaining;
+	// Tail of Buffer handed back by BackUp, returned again by the next Next
+	int32 BackedUp = 0;
+	int64 Position = 0;
+};
+
+// Writes to a saving archive through a buffer of BlockSize bytes, which is flushed by Flush and on destruction.
+class LINKPROTOBUFRUNTIME_API FLinkProtoArchiveOutputStream : public google::protobuf::io::ZeroCopyOutputStream
+{
+public:
+	explicit FLinkProtoArchiveOutputStream(FArchive& InArchive, int32 InBlockSize = 64 * 1024);
+	virtual ~FLinkProtoArchiveOutputStream() override;
+
+	// Writes the buffered bytes to the archive, returns false when the archive is in error.
+	bool Flush();
+
+	virtual bool Next(void** Data, int* Size) override;
+	virtual void BackUp(int Count) override;
+	virtual int64_t ByteCount() const override;
+
+private:
+	FArchive& Archive;
+	TArray<uint8> Buffer;
+	int32 Used = 0;
+	int64 Position = 0;
+};
+
+// Appends to a TArray, growing it geometrically. Bytes backed up by the writer are removed again.
+class LINKPROTOBUFRUNTIME_API FLinkProtoArrayOutputStream : public google::protobuf::io::ZeroCopyOutputStream
+{
+public:
+	explicit FLinkProtoArrayOutputStream(TArray<uint8>& InBytes, int32 InMinBlockSize = 1024);
+
+	virtual bool Next(void** Data, int* Size) override;
+	virtual void BackUp(int Count) override;
+	virtual int64_t ByteCount() const override;
+
+private:
+	TArray<uint8>& Bytes;
+	int32 StartNum;
+	int32 MinBlockSize;
+};
+
+/**
+ * Writes into a chain of separately allocated blocks that double in size up to MaxBlockSize, nothing is ever moved.
+ * MoveToCompositeBuffer hands the written bytes over as the segments of a FCompositeBuffer.
+ */
+class LINKPROTOBUFRUNTIME_API FLinkProtoBlockOutputStream : public google::protobuf::io::ZeroCopyOutputStream
+{
+public:
+	explicit FLinkProtoBlockOutputStream(int32 InInitialBlockSize = 4 * 1024, int32 InMaxBlockSize = 1024 * 1024);
+
+	// Returns the bytes written so far and starts over with no blocks.
+	FCompositeBuffer MoveToCompositeBuffer();
+
+	virtual bool Next(void** Data, int* Size) override;
+	virtual void BackUp(int Count) override;
+	virtual int64_t ByteCount() const override;
+
+private:
+	struct FBlock
+	{
+		FUniqueBuffer Memory;
+		int32 Used;
+	};
+	TArray<FBlock> Blocks;
+	int32 NextBlockSize;
+	int32 MaxBlockSize;
+	int64 Position = 0;
+};
@@ -0,0 +1,97 @@
+// Copyright DarkestLink-Dev 2025 All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// SPDX-License-Identifier: Apache-2.0
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Runtime/Launch/Resources/Version.h"
+#include <string>
+
+// FUtf8String and FAnsiString, and their properties, exist from UE 5.5
+#define LINKPROTO_WITH_UTF8_STRING_PROPERTIES ((ENGINE_MAJOR_VERSION > 5) || (ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 5))
+
+#if LINKPROTO_WITH_UTF8_STRING_PROPERTIES
+#include "Containers/AnsiString.h"
+#include "Containers/Utf8String.h"
+#endif
+
+/**
+ * UTF-16 <-> UTF-8 transcoding of the string, name and text fields, shared by the reflection converters,
+ * the wire codec and the generated converters.
+ *
+ * Lengths are computed exactly before anything is written, so values are transcoded straight into the protobuf
+ * string or the FString allocation. Runs of ASCII are handled by vector kernels (SSE2 and AVX2 on x86_64, NEON on
+ * arm64) picked on first use. Decoding validates the UTF-8 in the same pass; malformed sequences still decode,
+ * as U+FFFD, but are reported. Lone surrogates of the UTF-16 side are encoded as U+FFFD.
+ *
+ * Values that are already UTF-8 (FUtf8String, UTF-8 byte arrays) are copied as is, validation is up to the caller.
+ * FAnsiString holds Latin-1 and is only transcoded when it is not plain ASCII.
+ */
+struct LINKPROTOBUFRUNTIME_API FLinkProtoUtf8
+{
+	// Number of UTF-8 bytes Encode writes for the characters.
+	static int32 EncodedLength(const TCHAR* Chars, int32 Num);
+
+	// Writes exactly EncodedLength(Chars, Num) bytes to Target and returns the end of them.
+	static uint8* Encode(const TCHAR* Chars, int32 Num, uint8* Target);
+
+	// Replaces Out with the UTF-8 form of the characters.
+	static void Encode(const TCHAR* Chars, int32 Num, std::string& Out);
+
+	static FORCEINLINE void Encode(const FString& Str, std::string& Out)
+	{
+		Encode(*Str, Str.Len(), Out);
+	}
+
+	static FORCEINLINE std::string Encode(const FString& Str)
+	{
+		std::string Out;
+		Encode(*Str, Str.Len(), Out);
+		return Out;
+	}
+
+	// Replaces Out with the decoded text, false when the input is not valid UTF-8.
+	static bool Decode(const ANSICHAR* Utf8, int32 Len, FString& Out);
+	static bool Decode(const ANSICHAR* Utf8, int32 Len, FName& Out);
+	static bool Decode(const ANSICHAR* Utf8, int32 Len, FText& Out);
+
+	static FORCEINLINE bool Decode(const std::string& Utf8, FString& Out) { return Decode(Utf8.data(), static_cast<int32>(Utf8.size()), Out); }
+	static FORCEINLINE bool Decode(const std::string& Utf8, FName& Out) { return Decode(Utf8.data(), static_cast<int32>(Utf8.size()), Out); }
+	static FORCEINLINE bool Decode(const std::string& Utf8, FText& Out) { return Decode(Utf8.data(), static_cast<int32>(Utf8.size()), Out); }
+
+	// True when the bytes are valid UTF-8.
+	static bool IsValid(const ANSICHAR* Utf8, int32 Len);
+
+	// Copies the bytes into Out. With bValidate, false when they are not valid UTF-8; they are copied either way.
+	static bool Decode(const ANSICHAR* Utf8, int32 Len, TArray<uint8>& Out, bool bValidate);
+
+	// Number of UTF-8 bytes EncodeLatin1 writes for the Latin-1 characters, Num when they are all ASCII.
+	static int32 Latin1EncodedLength(const ANSICHAR* Chars, int32 Num);
+
+	// Writes exactly Latin1EncodedLength(Chars, Num) bytes to Target and returns the end of them.
+	static uint8* EncodeLatin1(const ANSICHAR* Chars, int32 Num, uint8* Target);
+
+	// Replaces Out with the UTF-8 form of the Latin-1 characters.
+	static void EncodeLatin1(const ANSICHAR* Chars, int32 Num, std::string& Out);
+
+#if LINKPROTO_WITH_UTF8_STRING_PROPERTIES
+	// Copies the bytes into Out. With bValidate, false when they are not valid UTF-8; they are copied either way.
+	static bool Decode(const ANSICHAR* Utf8, int32 Len, FUtf8String& Out, bool bValidate);
+
+	// Replaces Out with the decoded text, characters past U+00FF become '?'. False when the input is not valid UTF-8.
+	static bool Decode(const ANSICHAR* Utf8, int32 Len, FAnsiString& Out);
+#endif
+};
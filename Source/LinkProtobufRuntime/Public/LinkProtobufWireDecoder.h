@@ -0,0 +1,64 @@
+// Copyright DarkestLink-Dev 2025 All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "LinkProtobufConversionPlan.h"
+
+// What the decoder does with fields that are not part of the message descriptor.
+enum class ELinkProtoUnknownFieldPolicy : uint8
+{
+	// Skip them.
+	Skip,
+	// Copy the raw tag and value of top level unknown fields to the caller's buffer, nested ones are skipped.
+	Preserve,
+	// Fail the decode, also applies to nested messages.
+	Fail
+};
+
+/**
+ * Decodes the protobuf wire format straight into UStruct memory using a conversion plan, without a temporary Message.
+ *
+ * Every tag is looked up in the plan's field number table and dispatched to the field's WireDecode function,
+ * which writes the value at the property offset. Packed and unpacked encodings of repeated numeric fields are both accepted.
+ * Fields known to the descriptor but not bound to a property are always skipped.
+ */
+class LINKPROTOBUFRUNTIME_API FLinkProtoWireDecoder
+{
+public:
+	// Resets every bound field of the struct, then decodes Data into it.
+	static bool Decode(const FLinkProtoStructPlan& Plan, TConstArrayView<uint8> Data, void* StructPtr,
+		ELinkProtoUnknownFieldPolicy UnknownFieldPolicy = ELinkProtoUnknownFieldPolicy::Skip, TArray<uint8>* OutUnknownFields = nullptr);
+
+	// Same as above, reading from a stream until it ends.
+	static bool Decode(const FLinkProtoStructPlan& Plan, google::protobuf::io::ZeroCopyInputStream& Stream, void* StructPtr,
+		ELinkProtoUnknownFieldPolicy UnknownFieldPolicy = ELinkProtoUnknownFieldPolicy::Skip, TArray<uint8>* OutUnknownFields = nullptr);
+
+	// Merges the fields read from Input (up to its current limit) into the struct, proto merge semantics:
+	// scalars are overwritten, repeated fields and maps are appended to, nested structs are merged.
+	static bool DecodeFields(const FLinkProtoStructPlan& Plan, google::protobuf::io::CodedInputStream& Input, void* StructPtr,
+		ELinkProtoUnknownFieldPolicy UnknownFieldPolicy = ELinkProtoUnknownFieldPolicy::Skip, TArray<uint8>* OutUnknownFields = nullptr);
+
+	// Resets every bound field to its default value, the declared one for proto2 scalars with a non-zero default.
+	// Unbound properties are left untouched.
+	static void ResetFields(const FLinkProtoStructPlan& Plan, void* StructPtr);
+
+	// True when Tag is an encoding of the field its WireDecode function reads.
+	static bool AcceptsTag(const FLinkProtoFieldPlan& FieldPlan, uint32 Tag);
+
+	// Picks the wire decoder of a field when its plan is built.
+	static FLinkProtoFieldWireDecodeFunc ResolveFieldDecoder(const FLinkProtoFieldPlan& FieldPlan);
+};
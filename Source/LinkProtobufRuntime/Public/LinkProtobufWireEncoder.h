@@ -0,0 +1,71 @@
+// Copyright DarkestLink-Dev 2025 All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include <string>
+
+struct FLinkProtoFieldPlan;
+struct FLinkProtoStructPlan;
+
+namespace google { namespace protobuf { namespace io { class CodedOutputStream; class ZeroCopyOutputStream; } } }
+
+// Encoded size of one top level field, tag and length prefixes included. 0 when the field is not written.
+struct FLinkProtoFieldSize
+{
+	int32 FieldNumber = 0;
+	FString Name;
+	uint64 Size = 0;
+};
+
+/**
+ * Encodes UStruct memory straight to the protobuf wire format using a conversion plan,
+ * without building a google::protobuf::Message.
+ *
+ * Encoding runs in two passes: a size pass that computes the encoded size and records the length prefix of every
+ * length delimited value (nested messages, map entries, packed payloads and strings) in pre-order, and a write pass
+ * that fills an exactly sized buffer while consuming those prefixes in the same order.
+ * Fields are written in field number order with proto3 default values skipped, matching Message::SerializeToString.
+ */
+class LINKPROTOBUFRUNTIME_API FLinkProtoWireEncoder
+{
+public:
+	static bool Encode(const FLinkProtoStructPlan& Plan, const void* StructPtr, TArray<uint8>& OutBytes);
+
+	static bool Encode(const FLinkProtoStructPlan& Plan, const void* StructPtr, std::string& OutString);
+
+	// Writes straight into the stream's buffer when it has room for the whole struct, through a scratch buffer otherwise.
+	static bool Encode(const FLinkProtoStructPlan& Plan, const void* StructPtr, google::protobuf::io::ZeroCopyOutputStream& Output);
+
+	// Writes the encoded size as a varint followed by the struct, the framing of SerializeDelimitedToCodedStream.
+	// Scratch is only used when the stream's buffer cannot hold the whole struct, pass the same array on every call to reuse it.
+	static bool EncodeDelimited(const FLinkProtoStructPlan& Plan, const void* StructPtr, google::protobuf::io::CodedOutputStream& Output, TArray<uint8>& Scratch);
+
+	// Size pass. Appends the length prefixes consumed by Write to LengthPrefixes and returns the encoded size of the struct.
+	static uint64 ComputeSize(const FLinkProtoStructPlan& Plan, const void* StructPtr, TArray<uint32>& LengthPrefixes);
+
+	// Encoded size of the struct without recording anything for a write pass, so without allocating for most structs.
+	// OutFieldSizes, when given, receives the size of every bound field in field number order.
+	static uint64 ComputeEncodedSize(const FLinkProtoStructPlan& Plan, const void* StructPtr, TArray<FLinkProtoFieldSize>* OutFieldSizes = nullptr);
+
+	// Write pass. Target must hold the size returned by ComputeSize, LengthPrefixes is advanced past the consumed prefixes.
+	// Returns the end of the written range.
+	static uint8* Write(const FLinkProtoStructPlan& Plan, const void* StructPtr, const uint32*& LengthPrefixes, uint8* Target);
+
+	// Encodes only the entries of a map field, tags included, as they would appear in the encoded struct.
+	// Lets the message converters merge a whole map into a Message without building an entry message per pair.
+	static bool EncodeMapField(const FLinkProtoFieldPlan& FieldPlan, const void* StructPtr, std::string& OutString);
+};
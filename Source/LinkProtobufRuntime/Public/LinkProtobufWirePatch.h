@@ -0,0 +1,52 @@
+// Copyright DarkestLink-Dev 2025 All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// SPDX-License-Identifier: Apache-2.0
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Reads and rewrites single fields of an encoded message without parsing it into a message or a struct.
+ *
+ * A field is addressed by its path of field numbers from the outer message inwards, e.g. {2, 1} for field 1 of the
+ * nested message in field 2. Only the tags on the way are scanned, everything else is skipped over. When a field or
+ * a nested message occurs more than once the last occurrence is used, which is the one a parser keeps for singular fields.
+ *
+ * Writes happen in place when the new value fits the bytes of the old one: fixed32/fixed64 values always do, varints do
+ * when they are not longer than the old encoding (shorter ones are padded with continuation bytes, which every parser
+ * accepts), length delimited values when their size is unchanged. Otherwise the value is spliced in and the length
+ * prefixes of the enclosing messages are rewritten. Absent fields, and absent nested messages on the path, are appended
+ * to the end of the innermost message that exists.
+ *
+ * Values are raw wire values: negative int32/int64 go in as their two's complement uint64, sint values zigzag encoded,
+ * floats as their bit pattern.
+ */
+class LINKPROTOBUFRUNTIME_API FLinkProtoWirePatch
+{
+public:
+	// False when the field is absent, has another wire type, or the bytes are malformed.
+	static bool ReadVarint(TConstArrayView<uint8> Data, TConstArrayView<int32> FieldPath, uint64& OutValue);
+	static bool ReadFixed32(TConstArrayView<uint8> Data, TConstArrayView<int32> FieldPath, uint32& OutValue);
+	static bool ReadFixed64(TConstArrayView<uint8> Data, TConstArrayView<int32> FieldPath, uint64& OutValue);
+	// The payload of a string, bytes or message field, a view into Data.
+	static bool ReadLengthDelimited(TConstArrayView<uint8> Data, TConstArrayView<int32> FieldPath, TConstArrayView<uint8>& OutValue);
+
+	// False when a field on the path has another wire type or the bytes are malformed, Data is then left unchanged.
+	static bool WriteVarint(TArray<uint8>& Data, TConstArrayView<int32> FieldPath, uint64 Value);
+	static bool WriteFixed32(TArray<uint8>& Data, TConstArrayView<int32> FieldPath, uint32 Value);
+	static bool WriteFixed64(TArray<uint8>& Data, TConstArrayView<int32> FieldPath, uint64 Value);
+	static bool WriteLengthDelimited(TArray<uint8>& Data, TConstArrayView<int32> FieldPath, TConstArrayView<uint8> Value);
+};